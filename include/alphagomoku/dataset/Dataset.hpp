@@ -9,28 +9,122 @@
 #define ALPHAGOMOKU_DATASET_DATASET_HPP_
 
 #include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/IndexedDataset.hpp>
+#include <alphagomoku/dataset/SampleCache.hpp>
 
+#include <deque>
+#include <future>
 #include <map>
+#include <memory>
 #include <mutex>
 
 namespace ag
 {
+	struct SearchDataPack;
+}
+
+namespace ag
+{
+	struct StreamingStats
+	{
+			uint64_t draws = 0; // number of calls to Dataset::drawBuffer()
+			uint64_t hits = 0; // drawn buffer was already in memory
+			uint64_t prefetch_waits = 0; // drawn buffer was being loaded in the background and had to be waited for
+			uint64_t misses = 0; // drawn buffer had to be loaded synchronously
+			uint64_t loads = 0;
+			uint64_t evictions = 0;
+			double wait_time = 0.0; // total time (in seconds) spent waiting for buffers to load
+
+			std::string toString() const;
+	};
 
 	class Dataset
 	{
+			struct StreamedBuffer
+			{
+					std::string path;
+					std::shared_ptr<const GameDataBuffer> data; // null if the buffer is not in memory
+					std::shared_future<std::shared_ptr<const GameDataBuffer>> loading; // valid only while the buffer is being loaded
+					GameConfig config; // config, stats and numbers of samples are read from the summary saved in the file when the buffer is registered,
+					GameDataBufferStats stats; // so they are known even when the buffer is not in memory
+					std::vector<int> samples_per_game;
+					uint64_t last_used = 0;
+			};
+
 			std::map<int, GameDataBuffer> m_list_of_buffers;
+			std::map<int, IndexedDataset> m_list_of_indexed_buffers;
+			std::map<int, SampleCache> m_list_of_caches;
 			mutable std::mutex m_list_mutex;
+
+			mutable std::map<int, StreamedBuffer> m_streamed_buffers;
+			mutable std::deque<int> m_schedule; // indices of buffers that will be returned by the next calls to drawBuffer()
+			mutable StreamingStats m_streaming_stats;
+			mutable uint64_t m_usage_counter = 0;
+			int m_max_resident_samples = 0; // 0 means that streaming is disabled
+			int m_prefetch_depth = 0;
 		public:
 			GameDataBufferStats getStats() const noexcept;
 			int numberOfBuffers() const noexcept;
 			int numberOfGames() const noexcept;
 			int numberOfSamples() const noexcept;
 			bool isLoaded(int i) const noexcept;
+			/*
+			 * \brief Files in the indexed format are memory mapped, all other ones are fully loaded into GameDataBuffer.
+			 * In streaming mode only the summary of the buffer (config, stats and number of samples in each game) is read from the file,
+			 * and the games are loaded when they are first needed. Files saved without the summary are loaded once to calculate it.
+			 */
 			void load(int i, const std::string &path);
 			void unload(int i);
 			void clear();
 			const GameDataBuffer& getBuffer(int i) const;
 			std::vector<int> getListOfBuffers() const;
+
+			/*
+			 * \brief Access to the samples that works with both formats of loaded buffers, as well as with streamed buffers.
+			 * Streamed buffer that is not in memory is loaded synchronously, but only to get its samples.
+			 */
+			GameConfig getConfig(int bufferIndex) const;
+			int numberOfGames(int bufferIndex) const;
+			int numberOfSamples(int bufferIndex, int gameIndex) const;
+			void getSample(SearchDataPack &result, int bufferIndex, int gameIndex, int sampleIndex) const;
+
+			/*
+			 * \brief Attaches cache of preprocessed samples to already loaded buffer. The cache must have been created from the same buffer.
+			 * Caches cannot be used in streaming mode. The cache is removed together with the buffer.
+			 */
+			void loadCache(int i, const std::string &path);
+			bool hasCache(int i) const noexcept;
+			/*
+			 * \brief Returns null if there is no cache attached to the buffer.
+			 */
+			const SampleCache* getCache(int i) const noexcept;
+
+			/*
+			 * \brief Enables streaming mode, in which buffers are loaded on demand and at most 'maxResidentSamples' samples are kept in memory.
+			 * Least recently used buffers are evicted first, but buffers that are scheduled to be drawn or are still in use are never evicted,
+			 * so the limit can be temporarily exceeded by them. Passing 0 disables streaming. The mode can be changed only when the dataset is empty.
+			 * Streaming works only with files saved by GameDataBuffer, indexed files are memory mapped anyway.
+			 */
+			void setStreaming(int maxResidentSamples, int prefetchDepth = 2);
+			bool isStreaming() const noexcept;
+			/*
+			 * \brief Streaming mode only. Returns a buffer drawn with probability proportional to its number of samples.
+			 * Buffers for the next 'prefetchDepth' draws are loaded in the background.
+			 */
+			std::shared_ptr<const GameDataBuffer> drawBuffer() const;
+			StreamingStats getStreamingStats() const;
+		private:
+			const IndexedDataset* find_indexed_buffer(int i) const;
+			/*
+			 * \brief Returns null if there is no streamed buffer with given index.
+			 */
+			std::shared_ptr<const GameDataBuffer> get_streamed_buffer(int i) const;
+			std::shared_ptr<const GameDataBuffer> acquire_buffer(std::unique_lock<std::mutex> &lock, int i) const;
+			int draw_buffer_index() const;
+			void collect_loaded_buffers() const;
+			void start_loading(StreamedBuffer &buffer) const;
+			void set_loaded(StreamedBuffer &buffer, const std::shared_ptr<const GameDataBuffer> &data) const;
+			void evict_buffers() const;
 	};
 
 } /* namespace ag */
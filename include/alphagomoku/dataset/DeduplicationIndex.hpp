@@ -0,0 +1,74 @@
+/*
+ * DeduplicationIndex.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_DATASET_DEDUPLICATIONINDEX_HPP_
+#define ALPHAGOMOKU_DATASET_DEDUPLICATIONINDEX_HPP_
+
+#include <alphagomoku/dataset/data_packs.hpp>
+#include <alphagomoku/search/ZobristHashing.hpp>
+
+#include <unordered_map>
+
+namespace ag
+{
+	/*
+	 * \brief Maps positions to the first sample in which they occurred, so that later duplicates can be merged into it.
+	 * Samples are considered duplicates if they have the same board, the same side to move and the same game outcome from the point of view
+	 * of the side to move. The outcome is a part of the key because it is stored per game, so samples with different outcomes cannot be merged.
+	 */
+	class DeduplicationIndex
+	{
+		public:
+			struct Entry
+			{
+					int game_index = 0;
+					int sample_index = 0;
+					int multiplicity = 1; // number of samples merged into this one (including itself)
+			};
+		private:
+			struct KeyHash
+			{
+					size_t operator()(const HashKey128 &key) const noexcept
+					{
+						return static_cast<uint64_t>(key.getLow());
+					}
+			};
+			FastZobristHashing hashing;
+			HashKey128 sign_keys[2];
+			HashKey128 outcome_keys[4]; // win, draw, loss (for the side to move) or unknown
+			std::unordered_map<HashKey128, Entry, KeyHash> entries;
+			std::unordered_map<HashKey128, SearchDataPack, KeyHash> merged_samples; // full precision copies of samples into which duplicates were merged
+		public:
+			DeduplicationIndex() noexcept = default;
+			DeduplicationIndex(int rows, int cols);
+			void clear() noexcept;
+			int size() const noexcept;
+			HashKey128 getKey(const SearchDataPack &sample) const noexcept;
+			/*
+			 * \brief Returns null if there is no entry for given key.
+			 */
+			Entry* find(const HashKey128 &key) noexcept;
+			void insert(const HashKey128 &key, int gameIndex, int sampleIndex);
+			/*
+			 * \brief Returns full precision copy of the merged sample for given key, or null if none was stored.
+			 * Merging into this copy instead of the decoded sample avoids accumulating the rounding of the storage format over many merges.
+			 */
+			SearchDataPack* findMerged(const HashKey128 &key) noexcept;
+			SearchDataPack& storeMerged(const HashKey128 &key, const SearchDataPack &sample);
+	};
+
+	/*
+	 * \brief Merges search statistics of 'src' into 'dst', which already contains 'dstMultiplicity' merged samples.
+	 * Visit counts are summed, action values are averaged with weights equal to visit counts of the moves and policy priors with weights equal to
+	 * total visit counts of the samples, so that the weights are stored in the samples themselves. Only if neither sample has any visits,
+	 * policy priors are averaged over 'dstMultiplicity' + 1 samples. Proven scores are kept if any of the samples has them.
+	 */
+	void mergeSamples(SearchDataPack &dst, int dstMultiplicity, const SearchDataPack &src);
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_DATASET_DEDUPLICATIONINDEX_HPP_ */
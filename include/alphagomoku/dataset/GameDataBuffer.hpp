@@ -8,6 +8,7 @@
 #ifndef ALPHAGOMOKU_DATASET_GAMEDATABUFFER_HPP_
 #define ALPHAGOMOKU_DATASET_GAMEDATABUFFER_HPP_
 
+#include <alphagomoku/dataset/DeduplicationIndex.hpp>
 #include <alphagomoku/utils/configs.hpp>
 
 #include <mutex>
@@ -29,16 +30,39 @@ namespace ag
 			uint64_t draws = 0;
 			uint64_t circle_win = 0;
 			uint64_t game_length = 0;
+			uint64_t duplicates = 0; // samples that were merged into identical positions
 
+			GameDataBufferStats() noexcept = default;
+			GameDataBufferStats(const Json &json);
+			Json toJson() const;
 			std::string toString() const;
+			void addGame(const GameDataStorage &game);
 			GameDataBufferStats& operator+=(const GameDataBufferStats &other) noexcept;
 	};
 
+	/*
+	 * \brief Description of a buffer that is saved together with its games, so that it can be read without loading them.
+	 */
+	struct GameDataBufferSummary
+	{
+			GameConfig config;
+			GameDataBufferStats stats;
+			std::vector<int> samples_per_game;
+
+			GameDataBufferSummary() noexcept = default;
+			GameDataBufferSummary(const Json &json);
+			Json toJson() const;
+	};
+
 	class GameDataBuffer
 	{
 		private:
 			std::vector<GameDataStorage> buffer_data;
 			GameConfig game_config;
+			DeduplicationIndex deduplication_index;
+			uint64_t merged_samples = 0;
+			bool is_deduplicating = false;
+			bool is_index_valid = false; // index is invalidated by anything that changes indices of games or samples
 		public:
 			GameDataBuffer() noexcept = default;
 			GameDataBuffer(GameConfig cfg) noexcept;
@@ -51,14 +75,38 @@ namespace ag
 			void append(const GameDataBuffer &other);
 			void addGameData(const GameDataStorage &game);
 			const GameDataStorage& getGameData(int index) const;
+			/*
+			 * \brief Samples must not be added, removed or modified through it while deduplication is enabled, as the index of positions is not updated.
+			 */
 			GameDataStorage& getGameData(int index);
 			void removeFromBuffer(int index);
 			void removeRange(int from, int to);
+			/*
+			 * \brief Merges samples of identical positions (see DeduplicationIndex) into their first occurrence.
+			 * Returns the number of removed samples.
+			 */
+			int deduplicate();
+			/*
+			 * \brief If enabled, samples of every game added to (or loaded into) the buffer are merged with identical positions that are already in it.
+			 * Full precision copies of merged samples are kept together with the index, so that repeated merges are not affected by rounding.
+			 */
+			void setDeduplication(bool enabled);
 
 			void save(const std::string &path) const;
+			/*
+			 * \brief Also loads streams of games written by GameDataWriter, including those that were not closed yet.
+			 */
 			void load(const std::string &path);
 
 			GameDataBufferStats getStats() const noexcept;
+			GameDataBufferSummary getSummary() const;
+			/*
+			 * \brief Reads only the summary that save() and GameDataWriter::close() store in the file.
+			 * Files without it (saved by older versions or streams that were not closed) are loaded fully.
+			 */
+			static GameDataBufferSummary loadSummary(const std::string &path);
+		private:
+			int merge_duplicates(int gameIndex);
 	};
 
 } /* namespace ag */
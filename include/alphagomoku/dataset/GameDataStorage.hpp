@@ -50,11 +50,17 @@ namespace ag
 			GameOutcome getOutcome() const noexcept;
 
 			void addSample(const SearchDataPack &sample);
+			void replaceSample(int index, const SearchDataPack &sample);
+			void removeSample(int index);
 			void addMove(Move move);
 			void addMoves(const std::vector<Move> &moves);
 			void setOutcome(GameOutcome outcome) noexcept;
 
 			void serialize(SerializedObject &binary_data) const;
+			/*
+			 * \brief Serializes a single sample in format 201, samples stored in older formats are converted.
+			 */
+			void serializeSample(SerializedObject &binary_data, int index) const;
 	};
 
 } /* namespace ag */
@@ -0,0 +1,104 @@
+/*
+ * GameDataWriter.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_DATASET_GAMEDATAWRITER_HPP_
+#define ALPHAGOMOKU_DATASET_GAMEDATAWRITER_HPP_
+
+#include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/utils/configs.hpp>
+
+#include <minml/utils/serialization.hpp>
+
+#include <cinttypes>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ag
+{
+	class GameDataStorage;
+}
+
+namespace ag
+{
+	/*
+	 * \brief Append-only file of games that are written in independently compressed chunks as they are added, so memory usage does not grow
+	 * with the number of games and a crash loses at most the games of one unfinished chunk.
+	 * The file starts with a header describing the game config, and an index of chunks together with a summary of the games (see GameDataBufferSummary)
+	 * is appended as a footer when the writer is closed.
+	 * Files that were not closed (still being written or left after a crash) can be read too, as complete chunks are found by scanning the file.
+	 * Opening a writer on an existing file continues it, after discarding the footer and incomplete chunk at the end (if any).
+	 */
+	class GameDataWriter
+	{
+			mutable std::mutex pending_mutex;
+			std::mutex file_mutex;
+			std::string path;
+			GameConfig game_config;
+			std::ofstream stream;
+			SerializedObject pending_games; // serialized games of the chunk that is not written yet
+			std::vector<int> pending_samples; // number of samples in each of the pending games
+			int chunks_in_flight = 0; // taken from pending games, but not written yet
+			std::condition_variable chunk_written;
+			int games_per_chunk = 0;
+			std::vector<uint64_t> chunk_offsets;
+			std::vector<uint32_t> chunk_sizes; // number of games in each chunk
+			std::vector<int> samples_per_game; // of the games that were written, in the order in which they are stored in the file
+			uint64_t file_size = 0;
+			int number_of_games = 0; // including the pending ones
+			GameDataBufferStats stats;
+			bool is_open = false;
+		public:
+			GameDataWriter(const std::string &path, const GameConfig &cfg, int gamesPerChunk = 32);
+			GameDataWriter(const GameDataWriter &other) = delete;
+			GameDataWriter& operator=(const GameDataWriter &other) = delete;
+			~GameDataWriter();
+
+			/*
+			 * \brief Thread safe. Compression and writing of a full chunk is done by the calling thread, without blocking other threads that add games.
+			 */
+			void add(const GameDataStorage &game);
+			/*
+			 * \brief Writes pending games as a chunk (even if it is not full).
+			 */
+			void flush();
+			/*
+			 * \brief Flushes pending games, waits for chunks that are still being written by other threads and writes the footer, marking the file as complete.
+			 * The destructor only flushes pending games, so a writer that was not closed leaves the file incomplete (and it can be continued later).
+			 */
+			void close();
+
+			bool isOpen() const noexcept;
+			const std::string& getPath() const noexcept;
+			int numberOfGames() const noexcept;
+			GameDataBufferStats getStats() const noexcept;
+
+			static bool isGameDataStream(const std::string &path);
+			/*
+			 * \brief Returns true if the writer of the file was closed, otherwise some of the games may still be missing.
+			 */
+			static bool isComplete(const std::string &path);
+			/*
+			 * \brief Reads only the summary stored by close(). Returns false if the file is not complete or was written without the summary.
+			 */
+			static bool readSummary(const std::string &path, GameDataBufferSummary &result);
+			/*
+			 * \brief Reads all games from complete chunks of the file, which does not have to be closed.
+			 */
+			static void read(const std::string &path, GameConfig &config, std::vector<GameDataStorage> &games);
+		private:
+			/*
+			 * \brief Writes chunk that was counted as in flight when it was taken from pending games.
+			 */
+			void write_chunk(const SerializedObject &games, const std::vector<int> &samples);
+	};
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_DATASET_GAMEDATAWRITER_HPP_ */
@@ -0,0 +1,78 @@
+/*
+ * IndexedDataset.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_DATASET_INDEXEDDATASET_HPP_
+#define ALPHAGOMOKU_DATASET_INDEXEDDATASET_HPP_
+
+#include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/game/rules.hpp>
+#include <alphagomoku/utils/configs.hpp>
+#include <alphagomoku/utils/os_utils.hpp>
+
+#include <string>
+
+namespace ag
+{
+	struct SearchDataPack;
+}
+
+namespace ag
+{
+	/*
+	 * \brief Read-only dataset stored in an uncompressed file with an index of games and samples.
+	 * The file is memory mapped, so opening it only reads the indices (which are validated) and the samples are read from disk when they are used.
+	 *
+	 * Layout of the file (all offsets in bytes):
+	 * 	header           - magic string, version, size of the game config json, number of games and samples, offset of the data section
+	 * 	game config      - json dumped to text
+	 * 	game index       - for each game offset of its record, index of its first sample and number of samples
+	 * 	sample index     - for each sample offset of its record
+	 * 	data section     - game records (outcome, number of moves, moves) and sample records (SearchDataStorage_v201)
+	 * Offsets in both indices are relative to the beginning of the data section.
+	 */
+	class IndexedDataset
+	{
+			MemoryMappedFile file;
+			GameConfig game_config;
+			const uint8_t *game_index = nullptr; // non-owning, points into the mapped file
+			const uint8_t *sample_index = nullptr; // non-owning, points into the mapped file
+			const uint8_t *data_section = nullptr; // non-owning, points into the mapped file
+			size_t data_size = 0;
+			int number_of_games = 0;
+			int number_of_samples = 0;
+		public:
+			IndexedDataset() noexcept = default;
+			IndexedDataset(const std::string &path);
+
+			const GameConfig& getConfig() const noexcept;
+			int numberOfGames() const noexcept;
+			int numberOfSamples() const noexcept;
+			int numberOfSamples(int gameIndex) const;
+			int numberOfMoves(int gameIndex) const;
+			GameOutcome getOutcome(int gameIndex) const;
+			void getSample(SearchDataPack &result, int gameIndex, int sampleIndex) const;
+			GameDataBufferStats getStats() const;
+
+			/*
+			 * \brief Checks the magic string at the beginning of the file.
+			 */
+			static bool isIndexedDataset(const std::string &path);
+			/*
+			 * \brief Writes the buffer (in any of the formats 100, 200 or 201) as an indexed dataset.
+			 */
+			static void save(const GameDataBuffer &buffer, const std::string &path);
+			/*
+			 * \brief Converts a file saved with GameDataBuffer::save() to an indexed dataset.
+			 */
+			static void convert(const std::string &srcPath, const std::string &dstPath);
+		private:
+			void validate_index(const std::string &path) const;
+	};
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_DATASET_INDEXEDDATASET_HPP_ */
@@ -0,0 +1,86 @@
+/*
+ * SampleCache.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_DATASET_SAMPLECACHE_HPP_
+#define ALPHAGOMOKU_DATASET_SAMPLECACHE_HPP_
+
+#include <alphagomoku/utils/configs.hpp>
+#include <alphagomoku/utils/os_utils.hpp>
+
+#include <cinttypes>
+#include <string>
+
+namespace ag
+{
+	class Dataset;
+	class NNInputFeatures;
+	struct TrainingDataPack;
+}
+
+namespace ag
+{
+	/*
+	 * \brief Read-only file with samples of one buffer that were already converted into network inputs and training targets.
+	 * It is created once per buffer and reused in later iterations, so decoding of samples, calculation of patterns for the input features
+	 * and preparation of targets by the sampler are skipped. The file is memory mapped, like IndexedDataset.
+	 *
+	 * Layout of the file (all offsets in bytes):
+	 * 	header           - magic string, version, encoder hash, size of the json, number of games and samples, size of sample record, offset of the data section
+	 * 	json             - game config and sampler type
+	 * 	game index       - for each game index of its first sample and number of samples
+	 * 	data section     - fixed size sample records: value targets, moves left and sign to move, packed input features (one 32-bit word per spot),
+	 * 	                   policy target, visit count and action values target (all three quantized to 16 bits per spot)
+	 * Games and samples are stored in the same order as in the buffer the cache was created from.
+	 */
+	class SampleCache
+	{
+			MemoryMappedFile file;
+			GameConfig game_config;
+			std::string sampler_type;
+			uint64_t encoder_hash = 0;
+			const uint8_t *game_index = nullptr; // non-owning, points into the mapped file
+			const uint8_t *data_section = nullptr; // non-owning, points into the mapped file
+			int number_of_games = 0;
+			int number_of_samples = 0;
+			size_t record_size = 0;
+		public:
+			SampleCache() noexcept = default;
+			SampleCache(const std::string &path);
+
+			const GameConfig& getConfig() const noexcept;
+			const std::string& getSamplerType() const noexcept;
+			uint64_t getEncoderHash() const noexcept;
+			int numberOfGames() const noexcept;
+			int numberOfSamples() const noexcept;
+			int numberOfSamples(int gameIndex) const;
+			/*
+			 * \brief Copies input features and targets of the sample. The board of the result is cleared, as the features replace it.
+			 */
+			void getSample(NNInputFeatures &features, TrainingDataPack &result, int gameIndex, int sampleIndex) const;
+			/*
+			 * \brief Returns true if the cache has the same board size and the same number of samples in each game as the buffer loaded into the dataset.
+			 */
+			bool isCreatedFrom(const Dataset &dataset, int bufferIndex) const;
+
+			/*
+			 * \brief Hash of the input features calculated for a fixed set of positions, so it changes whenever the encoding of features does.
+			 */
+			static uint64_t getEncoderHash(const GameConfig &cfg);
+			static bool isSampleCache(const std::string &path);
+			/*
+			 * \brief Returns true if the file is a cache of the buffer loaded into the dataset, created for given sampler type with the current feature encoder.
+			 */
+			static bool isUpToDate(const std::string &path, const Dataset &dataset, int bufferIndex, const std::string &samplerType);
+			/*
+			 * \brief Preprocesses all samples of the buffer loaded into the dataset using sampler of given type.
+			 */
+			static void save(const Dataset &dataset, int bufferIndex, const std::string &samplerType, const std::string &path);
+	};
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_DATASET_SAMPLECACHE_HPP_ */
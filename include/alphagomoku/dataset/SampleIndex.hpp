@@ -0,0 +1,69 @@
+/*
+ * SampleIndex.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_DATASET_SAMPLEINDEX_HPP_
+#define ALPHAGOMOKU_DATASET_SAMPLEINDEX_HPP_
+
+#include <alphagomoku/utils/AliasTable.hpp>
+
+#include <string>
+#include <vector>
+#include <cinttypes>
+
+namespace ag
+{
+	class Dataset;
+}
+
+namespace ag
+{
+	enum class SampleWeighting
+	{
+		UNIFORM, // each sample is equally likely, so longer games are drawn more often
+		RECENCY, // weight of a sample is proportional to the position of its buffer in the dataset (1 for the oldest, N for the newest one)
+		SURPRISE // weight of a sample grows with the difference between its minimax value and the final outcome of the game
+	};
+	std::string toString(SampleWeighting weighting);
+	SampleWeighting sampleWeightingFromString(const std::string &str);
+
+	struct SampleLocation
+	{
+			int buffer_index = 0;
+			int game_index = 0;
+			int sample_index = 0;
+	};
+
+	/*
+	 * \brief Index of all samples in a dataset with an alias table built over their weights.
+	 * Drawing a sample takes O(1) time and does not allocate memory. The object is immutable after construction,
+	 * so a single index can be shared by samplers running on different threads.
+	 * It requires all buffers to be accessible, so it cannot be used with streamed datasets.
+	 */
+	class SampleIndex
+	{
+			struct GameEntry
+			{
+					int buffer_index;
+					int game_index;
+					uint32_t first_sample;
+			};
+			std::vector<GameEntry> games;
+			std::vector<uint32_t> sample_to_game;
+			AliasTable alias_table;
+		public:
+			SampleIndex(const Dataset &dataset, SampleWeighting weighting);
+			int numberOfSamples() const noexcept;
+			SampleLocation draw() const;
+			/*
+			 * \brief Probability of drawing given sample, useful mostly for testing.
+			 */
+			double getProbability(int sampleIndex) const;
+	};
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_DATASET_SAMPLEINDEX_HPP_ */
@@ -17,7 +17,10 @@
 namespace ag
 {
 	class Dataset;
+	class GameDataBuffer;
 	class GameDataStorage;
+	class NNInputFeatures;
+	class SampleIndex;
 	struct GameConfig;
 }
 
@@ -28,6 +31,8 @@ namespace ag
 			const Dataset *dataset = nullptr;
 			SearchDataPack search_data_pack;
 			std::vector<std::pair<int, int>> buffer_and_game_ordering;
+			std::vector<std::pair<std::shared_ptr<const GameDataBuffer>, int>> streamed_buffers; // buffers drawn from streaming dataset with number of samples left to take from each
+			std::shared_ptr<const SampleIndex> sample_index; // if set, samples are drawn from it instead of iterating over shuffled games
 			size_t counter = 0;
 			int batch_size = 0;
 		public:
@@ -38,8 +43,24 @@ namespace ag
 			Sampler& operator=(Sampler &&other) = delete;
 			virtual ~Sampler() = default;
 			virtual void init(const Dataset &dataset, int batchSize);
+			/*
+			 * \brief Samples will be drawn with probabilities given by the index. The index can be shared between many samplers.
+			 */
+			virtual void init(const Dataset &dataset, int batchSize, std::shared_ptr<const SampleIndex> index);
 			virtual void get(TrainingDataPack &result);
+			/*
+			 * \brief If the sample was drawn from a buffer with attached sample cache, its input features are copied into 'features'
+			 * (and the board of the result is left empty) and true is returned. Otherwise the sample is prepared as above and false is returned.
+			 */
+			virtual bool get(TrainingDataPack &result, NNInputFeatures &features);
+			/*
+			 * \brief Converts given sample into training targets, used to create sample caches.
+			 */
+			void prepare(TrainingDataPack &result, const SearchDataPack &sample);
 		private:
+			bool get_sample(TrainingDataPack &result, NNInputFeatures *features);
+			void get_streamed(TrainingDataPack &result);
+			bool load_sample(TrainingDataPack &result, NNInputFeatures *features, int bufferIndex, int gameIndex, int sampleIndex);
 			virtual void prepare_training_data(TrainingDataPack &result, const SearchDataPack &sample) = 0;
 	};
 
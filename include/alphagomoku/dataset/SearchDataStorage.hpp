@@ -116,6 +116,15 @@ namespace ag
 			void storeTo(SearchDataPack &pack) const;
 			void serialize(SerializedObject &binary_data) const;
 			void print() const;
+
+			/*
+			 * \brief Same as constructing the object from memory and calling storeTo(), but without allocating the storage.
+			 * Throws if the object does not fit into 'size' bytes or its entries do not fit on the board. Returns the move number of the sample.
+			 */
+			static int storeTo(SearchDataPack &pack, const uint8_t *binary_data, size_t size);
+		private:
+			static void store_entries(SearchDataPack &pack, const entry *entries, size_t count, float valueScale, float policyScale,
+					float visitScale, Score minimaxScore, BitMask1D<uint16_t> flags);
 	};
 
 } /* namespace ag */
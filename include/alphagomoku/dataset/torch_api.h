@@ -28,8 +28,22 @@ namespace ag
 				int dim[4];
 		} TensorSize_t;
 
+		typedef enum
+		{
+			DTYPE_FLOAT32 = 0,
+			DTYPE_FLOAT16 = 1, // IEEE 754 half precision
+			DTYPE_UINT8 = 2 // only for input tensor, whose features are either 0 or 1
+		} DataType_t;
+
+		/*
+		 * Handle to a loader with its own dataset and pool of worker threads, so that several loaders can be used concurrently.
+		 * Functions taking a handle accept null pointer as the default loader, which is the one used by functions without a handle.
+		 */
+		typedef void* LoaderHandle_t;
+
 		void load_dataset_fragment(int i, const char *path);
 		void unload_dataset_fragment(int i);
+		void convert_dataset_fragment(const char *src_path, const char *dst_path);
 		void print_dataset_info();
 		void get_dataset_size(TensorSize_t *shape, int *size);
 
@@ -38,6 +52,27 @@ namespace ag
 		void load_batch(int batch_size, const Sample_t *samples, float *input, float *policy_target, float *value_target, float *moves_left_target,
 				float *action_values_target);
 
+		LoaderHandle_t create_loader(int number_of_threads);
+		void destroy_loader(LoaderHandle_t handle);
+		void loader_load_dataset_fragment(LoaderHandle_t handle, int i, const char *path);
+		void loader_unload_dataset_fragment(LoaderHandle_t handle, int i);
+		void loader_get_dataset_size(LoaderHandle_t handle, TensorSize_t *shape, int *size);
+		void loader_print_dataset_info(LoaderHandle_t handle);
+		void loader_get_tensor_shapes(LoaderHandle_t handle, int batch_size, const Sample_t *samples, TensorSize_t *input,
+				TensorSize_t *policy_target, TensorSize_t *value_target, TensorSize_t *moves_left_target, TensorSize_t *action_values_target);
+		/*
+		 * Samples are converted by the worker threads of the loader directly into the provided buffers (which may be pinned memory).
+		 * Tensors have the same shapes as in 'load_batch', input tensor is stored as 'input_dtype', all targets as 'target_dtype'.
+		 */
+		void load_batch_parallel(LoaderHandle_t handle, int batch_size, const Sample_t *samples, DataType_t input_dtype, DataType_t target_dtype,
+				void *input, void *policy_target, void *value_target, void *moves_left_target, void *action_values_target);
+		/*
+		 * Applies 'augmentation' of each sample to the spatial tensors that were already loaded (for example with augmentation 0 or from a cache)
+		 * as a gather with precomputed index tables. Note that 'load_batch_parallel' already writes each cell to its augmented location.
+		 */
+		void augment_batch(LoaderHandle_t handle, int batch_size, const Sample_t *samples, DataType_t input_dtype, DataType_t target_dtype,
+				void *input, void *policy_target, void *action_values_target);
+
 #ifdef __cplusplus
 	}
 #endif
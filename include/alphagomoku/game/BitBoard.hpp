@@ -0,0 +1,225 @@
+/*
+ * BitBoard.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_GAME_BITBOARD_HPP_
+#define ALPHAGOMOKU_GAME_BITBOARD_HPP_
+
+#include <alphagomoku/game/Move.hpp>
+#include <alphagomoku/game/rules.hpp>
+#include <alphagomoku/utils/matrix.hpp>
+
+#include <array>
+#include <cinttypes>
+#include <cassert>
+
+namespace ag
+{
+	/*
+	 * \brief Set of 512 bits that can be shifted as a whole.
+	 */
+	class BitPlane
+	{
+			std::array<uint64_t, 8> m_data;
+		public:
+			static constexpr int size = 512;
+
+			BitPlane() noexcept :
+					m_data()
+			{
+			}
+			bool get(int index) const noexcept
+			{
+				assert(0 <= index && index < size);
+				return static_cast<bool>((m_data[index / 64] >> (index % 64)) & 1ull);
+			}
+			void set(int index) noexcept
+			{
+				assert(0 <= index && index < size);
+				m_data[index / 64] |= (1ull << (index % 64));
+			}
+			void reset(int index) noexcept
+			{
+				assert(0 <= index && index < size);
+				m_data[index / 64] &= ~(1ull << (index % 64));
+			}
+			bool isEmpty() const noexcept
+			{
+				uint64_t tmp = 0;
+				for (size_t i = 0; i < m_data.size(); i++)
+					tmp |= m_data[i];
+				return tmp == 0;
+			}
+			int count() const noexcept;
+
+			friend BitPlane operator&(const BitPlane &lhs, const BitPlane &rhs) noexcept
+			{
+				BitPlane result;
+				for (size_t i = 0; i < result.m_data.size(); i++)
+					result.m_data[i] = lhs.m_data[i] & rhs.m_data[i];
+				return result;
+			}
+			friend BitPlane operator|(const BitPlane &lhs, const BitPlane &rhs) noexcept
+			{
+				BitPlane result;
+				for (size_t i = 0; i < result.m_data.size(); i++)
+					result.m_data[i] = lhs.m_data[i] | rhs.m_data[i];
+				return result;
+			}
+			/*
+			 * \brief Returns bits that are set in the first argument but not in the second one.
+			 */
+			friend BitPlane andNot(const BitPlane &lhs, const BitPlane &rhs) noexcept
+			{
+				BitPlane result;
+				for (size_t i = 0; i < result.m_data.size(); i++)
+					result.m_data[i] = lhs.m_data[i] & ~rhs.m_data[i];
+				return result;
+			}
+			/*
+			 * \brief Moves bit from index i to index i + shift. Bits shifted outside the plane are lost.
+			 */
+			BitPlane operator<<(int shift) const noexcept;
+			/*
+			 * \brief Moves bit from index i to index i - shift. Bits shifted outside the plane are lost.
+			 */
+			BitPlane operator>>(int shift) const noexcept;
+			friend bool operator==(const BitPlane &lhs, const BitPlane &rhs) noexcept
+			{
+				return lhs.m_data == rhs.m_data;
+			}
+			friend bool operator!=(const BitPlane &lhs, const BitPlane &rhs) noexcept
+			{
+				return not (lhs == rhs);
+			}
+	};
+
+	/*
+	 * \brief Board stored as one bit plane per sign.
+	 * Each row occupies 'stride' bits, the last columns of every row are always empty so that lines cannot wrap around the board edge.
+	 * This way lines of stones in any direction can be found with few shifts and bitwise operations over the whole board.
+	 */
+	class BitBoard
+	{
+			BitPlane m_cross;
+			BitPlane m_circle;
+			int m_rows = 0;
+			int m_columns = 0;
+		public:
+			static constexpr int max_size = 20;
+			static constexpr int stride = 24;
+
+			BitBoard() noexcept = default;
+			BitBoard(int rows, int columns);
+			explicit BitBoard(const matrix<Sign> &board);
+
+			int rows() const noexcept
+			{
+				return m_rows;
+			}
+			int cols() const noexcept
+			{
+				return m_columns;
+			}
+			bool isInside(int row, int col) const noexcept
+			{
+				return 0 <= row and row < m_rows and 0 <= col and col < m_columns;
+			}
+			static int index(int row, int col) noexcept
+			{
+				return row * stride + col;
+			}
+			/*
+			 * \brief Returns the distance between indices of two consecutive cells in the given direction.
+			 */
+			static int offset(int direction) noexcept
+			{
+				switch (direction)
+				{
+					default:
+					case 0: // horizontal
+						return 1;
+					case 1: // vertical
+						return stride;
+					case 2: // diagonal
+						return stride + 1;
+					case 3: // antidiagonal
+						return stride - 1;
+				}
+			}
+
+			void clear() noexcept;
+			Sign at(int row, int col) const noexcept
+			{
+				assert(isInside(row, col));
+				const int idx = index(row, col);
+				if (m_cross.get(idx))
+					return Sign::CROSS;
+				if (m_circle.get(idx))
+					return Sign::CIRCLE;
+				return Sign::NONE;
+			}
+			void putMove(Move move) noexcept
+			{
+				assert(isInside(move.row, move.col));
+				assert(at(move.row, move.col) == Sign::NONE);
+				assert(move.sign == Sign::CROSS || move.sign == Sign::CIRCLE);
+				get(move.sign).set(index(move.row, move.col));
+			}
+			void undoMove(Move move) noexcept
+			{
+				assert(isInside(move.row, move.col));
+				assert(at(move.row, move.col) == move.sign);
+				get(move.sign).reset(index(move.row, move.col));
+			}
+			const BitPlane& get(Sign sign) const noexcept
+			{
+				assert(sign == Sign::CROSS || sign == Sign::CIRCLE);
+				return (sign == Sign::CROSS) ? m_cross : m_circle;
+			}
+			BitPlane& get(Sign sign) noexcept
+			{
+				assert(sign == Sign::CROSS || sign == Sign::CIRCLE);
+				return (sign == Sign::CROSS) ? m_cross : m_circle;
+			}
+
+			int numberOfMoves() const noexcept;
+			bool isFull() const noexcept;
+			matrix<Sign> toMatrix() const;
+
+			/*
+			 * \brief Returns stones of given sign that belong to a winning line (five or overline, depending on the rules) in given direction.
+			 */
+			BitPlane getWinningLines(GameRules rules, Sign sign, int direction) const noexcept;
+			/*
+			 * \brief Returns all stones of given sign that belong to a winning line in any direction.
+			 */
+			BitPlane getWinningLines(GameRules rules, Sign sign) const noexcept;
+			/*
+			 * \brief Returns stones of given sign that belong to a line of at least six stones in given direction.
+			 */
+			BitPlane getOverlines(Sign sign, int direction) const noexcept;
+
+			friend bool operator==(const BitBoard &lhs, const BitBoard &rhs) noexcept
+			{
+				return lhs.m_rows == rhs.m_rows and lhs.m_columns == rhs.m_columns and lhs.m_cross == rhs.m_cross and lhs.m_circle == rhs.m_circle;
+			}
+			friend bool operator!=(const BitBoard &lhs, const BitBoard &rhs) noexcept
+			{
+				return not (lhs == rhs);
+			}
+	};
+
+	/*
+	 * \brief Returns game outcome given board state and last move, the same as the version that takes matrix<Sign>.
+	 * The move may or may not be already placed on board.
+	 * If numberOfMovesForDraw is negative it means that we play until board is full.
+	 */
+	GameOutcome getOutcome(GameRules rules, const BitBoard &board, Move lastMove, int numberOfMovesForDraw = -1);
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_GAME_BITBOARD_HPP_ */
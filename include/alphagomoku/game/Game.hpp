@@ -8,6 +8,7 @@
 #ifndef ALPHAGOMOKU_GAME_GAME_HPP_
 #define ALPHAGOMOKU_GAME_GAME_HPP_
 
+#include <alphagomoku/game/BitBoard.hpp>
 #include <alphagomoku/game/Move.hpp>
 #include <alphagomoku/game/rules.hpp>
 #include <alphagomoku/utils/matrix.hpp>
@@ -29,6 +30,7 @@ namespace ag
 
 			std::vector<Move> played_moves;
 			matrix<Sign> current_board;
+			BitBoard bit_board; // used for fast checking of game outcome
 
 			std::string cross_player_name;
 			std::string circle_player_name;
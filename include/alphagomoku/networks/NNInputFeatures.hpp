@@ -8,9 +8,13 @@
 #ifndef ALPHAGOMOKU_SELFPLAY_NNINPUTFEATURES_HPP_
 #define ALPHAGOMOKU_SELFPLAY_NNINPUTFEATURES_HPP_
 
+#include <alphagomoku/game/Move.hpp>
 #include <alphagomoku/utils/matrix.hpp>
+#include <alphagomoku/utils/configs.hpp>
 
 #include <cinttypes>
+#include <memory>
+#include <vector>
 
 namespace ag
 {
@@ -22,11 +26,49 @@ namespace ag
 
 	class NNInputFeatures: public matrix<uint32_t>
 	{
+			std::vector<Location> forbidden_candidates; // workspace of 'update', kept to avoid allocations
 		public:
 			NNInputFeatures() noexcept = default;
 			NNInputFeatures(int rows, int cols);
 			void encode(PatternCalculator &calc);
+			/*
+			 * \brief Incrementally brings the features up to date after a single move was added to or removed from the calculator.
+			 * The calculator must differ from the state used in the last call to 'encode' or 'update' by exactly one move.
+			 * Only the spots reported by the calculator as changed are encoded again, so the result is the same as of full 'encode'.
+			 */
+			void update(PatternCalculator &calc);
 			void augment(int mode) noexcept;
+		private:
+			template<int N>
+			void encode_board(const PatternCalculator &calc);
+	};
+
+	/*
+	 * \brief Some of the features depend on direction, so after the cells were transformed with given symmetry those features must be shuffled too.
+	 */
+	void augment_feature_directions(uint32_t *features, int size, int mode) noexcept;
+
+	/*
+	 * \brief Calculates input features of many positions at once, splitting the work between several threads.
+	 * Each thread uses its own pattern calculator, which are kept between calls.
+	 */
+	class NNInputFeaturesEncoder
+	{
+			GameConfig game_config;
+			std::vector<std::unique_ptr<PatternCalculator>> pattern_calculators;
+			std::vector<NNInputFeatures> input_features;
+		public:
+			NNInputFeaturesEncoder(const GameConfig &cfg);
+			NNInputFeaturesEncoder(const NNInputFeaturesEncoder &other) = delete;
+			NNInputFeaturesEncoder& operator=(const NNInputFeaturesEncoder &other) = delete;
+			~NNInputFeaturesEncoder();
+			/*
+			 * \brief Features of i-th position are written to 'dst + i * rows * cols'.
+			 */
+			void encode(const std::vector<matrix<Sign>> &boards, const std::vector<Sign> &signsToMove, uint32_t *dst, int numberOfThreads);
+		private:
+			void encode_range(int threadIndex, int begin, int end, const std::vector<matrix<Sign>> &boards, const std::vector<Sign> &signsToMove,
+					uint32_t *dst);
 	};
 
 } /* namespace ag */
@@ -10,6 +10,7 @@
 
 #include <alphagomoku/game/Move.hpp>
 #include <alphagomoku/networks/NNInputFeatures.hpp>
+#include <alphagomoku/utils/augmentations.hpp>
 #include <alphagomoku/utils/matrix.hpp>
 #include <alphagomoku/utils/misc.hpp>
 #include <alphagomoku/utils/configs.hpp>
@@ -17,6 +18,7 @@
 #include <minml/graph/Graph.hpp>
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace ml
@@ -60,7 +62,9 @@ namespace ag
 
 			std::unique_ptr<PatternCalculator> pattern_calculator; // lazily allocated on first use
 			NNInputFeatures input_features; // same as above
+			std::unique_ptr<NNInputFeaturesEncoder> features_encoder; // same as above
 			mutable std::vector<float3> workspace;
+			std::vector<char> augmentation_workspace;
 		public:
 			NetworkDataPack() = default;
 			NetworkDataPack(const GameConfig &cfg, int batchSize, ml::DataType dtype);
@@ -70,12 +74,24 @@ namespace ag
 			 * \brief Can be used to pack the data if the features were already calculated.
 			 */
 			void packInputData(int index, const NNInputFeatures &features);
+			/*
+			 * \brief Packs input data of many positions at once (starting from index 0), using given number of threads.
+			 */
+			void packInputData(const std::vector<matrix<Sign>> &boards, const std::vector<Sign> &signsToMove, int numberOfThreads = 1);
 
 			void packPolicyTarget(int index, const matrix<float> &target);
 			void packValueTarget(int index, Value target);
 			void packActionValuesTarget(int index, const matrix<Value> &target, const matrix<float> &mask);
 			void packMovesLeftTarget(int index, int target);
 
+			/*
+			 * \brief Applies i-th symmetry to i-th sample of the batch, transforming the input and listed spatial targets and masks.
+			 * Only the tensors that were packed should be listed, by default those packed by all 'pack*Target()' methods ('p', 's' and 'q' targets
+			 * and the mask of action values). It should be called after all data was packed, as each tensor is transformed in a single pass
+			 * using precomputed index tables. Samples beyond the size of 'symmetries' are left unchanged.
+			 */
+			void augment(const std::vector<Symmetry> &symmetries, const std::string &targets = "psq", const std::string &masks = "q");
+
 			void unpackPolicy(int index, matrix<float> &policy) const;
 			void unpackValue(int index, Value &value) const;
 			void unpackActionValues(int index, matrix<Value> &actionValues) const;
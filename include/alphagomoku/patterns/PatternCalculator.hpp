@@ -65,6 +65,10 @@ namespace ag
 			std::vector<Change<ThreatEncoding>> changed_threats;
 			Change<Sign> changed_moves;
 
+			matrix<int8_t> forbidden_3x3_cache; // 0 - not checked, +radius - forbidden, -radius - not forbidden
+			std::vector<Location> cached_3x3_checks; // locations with non-zero entry in 'forbidden_3x3_cache'
+			int probe_depth = 0; // number of temporary moves made while checking forks 3x3, they are always undone so they do not invalidate the cache
+
 			const PatternTable *pattern_table = nullptr; // non-owning
 			const ThreatTable *threat_table = nullptr; // non-owning
 			const DefensiveMoveTable *defensive_move_table = nullptr; // non-owning
@@ -136,7 +140,7 @@ namespace ag
 			{
 				return pattern_table->isHalfOpenThree(getNormalPatternAt(row, col, dir), s);
 			}
-			TwoPlayerGroup<DirectionGroup<PatternType>> getPatternsAt(int row, int col) const noexcept
+			const TwoPlayerGroup<DirectionGroup<PatternType>>& getPatternsAt(int row, int col) const noexcept
 			{
 				return pattern_types.at(row, col);
 			}
@@ -183,7 +187,14 @@ namespace ag
 					if (threat.forCross() == ThreatType::FORK_4x4)
 						return true;
 					if (threat.forCross() == ThreatType::FORK_3x3)
-						return is_3x3_forbidden(sign, row, col);
+					{
+						if (forbidden_3x3_cache.at(row, col) == 0)
+						{
+							forbidden_3x3_cache.at(row, col) = check_3x3_forbidden(sign, row, col);
+							cached_3x3_checks.push_back(Location(row, col));
+						}
+						return forbidden_3x3_cache.at(row, col) > 0;
+					}
 				}
 				return false;
 			}
@@ -195,8 +206,18 @@ namespace ag
 			void print(Move lastMove = Move()) const;
 			void print_stats() const;
 		private:
-			bool is_3x3_forbidden(Sign sign, int row, int col) noexcept;
+			/*
+			 * \brief Returns +radius if the fork 3x3 is forbidden or -radius if it is not, where radius is the distance from (row, col)
+			 * within which any change of the board may change the result (it grows with each level of recursive checks).
+			 */
+			int check_3x3_forbidden(Sign sign, int row, int col) noexcept;
+			void invalidate_forbidden_cache(int row, int col) noexcept;
+			template<int N>
 			void classify_feature_types() noexcept;
+#ifdef __AVX2__
+			__m256i get_pattern_types(__m256i patterns) const noexcept;
+#endif
+			template<int N>
 			void prepare_threat_lists();
 			void update_around(int row, int col, Sign s, UpdateMode mode) noexcept;
 			void update_feature_types_and_threats(int row, int col, Direction direction, int mode) noexcept;
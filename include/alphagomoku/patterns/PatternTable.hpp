@@ -15,7 +15,14 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <cassert>
+#include <x86intrin.h>
+
+namespace ag
+{
+	class MemoryMappedFile;
+}
 
 namespace ag
 {
@@ -73,6 +80,14 @@ namespace ag
 			uint32_t data = 0;
 		public:
 			UpdateMask() noexcept = default;
+			explicit UpdateMask(uint32_t raw) noexcept :
+					data(raw)
+			{
+			}
+			uint32_t raw() const noexcept
+			{
+				return data;
+			}
 			int get(int index) const noexcept
 			{
 				return (data >> (2 * index)) & 3;
@@ -91,44 +106,126 @@ namespace ag
 			}
 	};
 
+	/*
+	 * \brief Everything that is known about a pattern packed into a single entry, so that updating a pattern requires only one memory access.
+	 * bits 0-21  : update mask for a new cross stone
+	 * bits 22-43 : update mask for a new circle stone
+	 * bits 48-55 : pattern types
+	 * bit 56     : half open three for cross
+	 * bit 57     : half open three for circle
+	 */
+	class PatternInfo
+	{
+			uint64_t data = 0;
+			static constexpr uint64_t update_mask_bits = 22;
+		public:
+			PatternEncoding getPatternType() const noexcept
+			{
+				return PatternEncoding(static_cast<PatternType>((data >> 48) & 15), static_cast<PatternType>((data >> 52) & 15));
+			}
+			UpdateMask getUpdateMask(Sign newStoneColor) const noexcept
+			{
+				assert(newStoneColor == Sign::CROSS || newStoneColor == Sign::CIRCLE);
+				const uint64_t shift = (newStoneColor == Sign::CROSS) ? 0 : update_mask_bits;
+				return UpdateMask(static_cast<uint32_t>((data >> shift) & ((1ull << update_mask_bits) - 1)));
+			}
+			bool isHalfOpenThree(Sign s) const noexcept
+			{
+				assert(s == Sign::CROSS || s == Sign::CIRCLE);
+				return (data >> (56 + (s == Sign::CIRCLE))) & 1ull;
+			}
+			void setPatternType(PatternEncoding pe) noexcept
+			{
+				data = (data & ~(255ull << 48)) | (static_cast<uint64_t>(pe.forCross()) << 48) | (static_cast<uint64_t>(pe.forCircle()) << 52);
+			}
+			void setUpdateMask(UpdateMask mask, Sign newStoneColor) noexcept
+			{
+				assert(newStoneColor == Sign::CROSS || newStoneColor == Sign::CIRCLE);
+				assert(mask.raw() < (1u << update_mask_bits));
+				const uint64_t shift = (newStoneColor == Sign::CROSS) ? 0 : update_mask_bits;
+				data = (data & ~(((1ull << update_mask_bits) - 1) << shift)) | (static_cast<uint64_t>(mask.raw()) << shift);
+			}
+			void setHalfOpenThree(Sign s) noexcept
+			{
+				assert(s == Sign::CROSS || s == Sign::CIRCLE);
+				data |= (1ull << (56 + (s == Sign::CIRCLE)));
+			}
+	};
+
 	class PatternTable
 	{
 		private:
-			std::vector<PatternEncoding> pattern_types;
-			std::vector<UpdateMask[2]> update_mask;
-			std::vector<bool> half_open_3_cross;
-			std::vector<bool> half_open_3_circle;
+			std::vector<PatternInfo> patterns; // empty if the table was loaded from memory mapped file
+			std::shared_ptr<const MemoryMappedFile> mapped_file;
+			const PatternInfo *patterns_ptr = nullptr;
 			GameRules game_rules;
 		public:
 			PatternTable(GameRules rules);
+			PatternTable(const PatternTable &other) = delete;
+			PatternTable& operator=(const PatternTable &other) = delete;
 			GameRules getRules() const noexcept
 			{
 				return game_rules;
 			}
+			PatternInfo getPatternInfo(NormalPattern pattern) const noexcept
+			{
+				assert(narrow_down(pattern) < number_of_patterns());
+				assert((pattern & 3072u) == 0); // central spot must be empty
+				return patterns_ptr[narrow_down(pattern)];
+			}
 			UpdateMask getUpdateMask(NormalPattern pattern, Sign newStoneColor) const noexcept
 			{
-				assert(narrow_down(pattern) < update_mask.size());
-				assert(newStoneColor == Sign::CROSS || newStoneColor == Sign::CIRCLE);
-				return update_mask[narrow_down(pattern)][newStoneColor == Sign::CIRCLE];
+				assert(narrow_down(pattern) < number_of_patterns());
+				return patterns_ptr[narrow_down(pattern)].getUpdateMask(newStoneColor);
 			}
 			PatternEncoding getPatternType(NormalPattern pattern) const noexcept
 			{
-				assert(narrow_down(pattern) < pattern_types.size());
-				assert((pattern & 3072u) == 0); // central spot must be empty
-				return pattern_types[narrow_down(pattern)];
+				return getPatternInfo(pattern).getPatternType();
 			}
 			bool isHalfOpenThree(NormalPattern pattern, Sign s) const noexcept
 			{
-				assert(s == Sign::CROSS || s == Sign::CIRCLE);
-				assert(narrow_down(pattern) < half_open_3_cross.size());
-				assert((pattern & 3072u) == 0); // central spot must be empty
-				const uint32_t idx = narrow_down(pattern);
-				return (s == Sign::CROSS) ? half_open_3_cross[idx] : half_open_3_circle[idx];
+				return getPatternInfo(pattern).isHalfOpenThree(s);
+			}
+#ifdef __AVX2__
+			/*
+			 * \brief Looks up four patterns at once, each stored in a 64-bit element of the vector. Returns PatternInfo for each of them.
+			 */
+			__m256i getPatternInfo(__m256i patterns) const noexcept
+			{
+				const __m256i narrowed = _mm256_or_si256(_mm256_and_si256(patterns, _mm256_set1_epi64x(1023u)),
+						_mm256_srli_epi64(_mm256_and_si256(patterns, _mm256_set1_epi64x(4190208u)), 2));
+				return _mm256_i64gather_epi64(reinterpret_cast<const long long*>(patterns_ptr), narrowed, sizeof(PatternInfo));
+			}
+#endif
+			/*
+			 * \brief Returns true if the table was loaded from a file with precomputed tables instead of being generated.
+			 */
+			bool isMemoryMapped() const noexcept
+			{
+				return mapped_file != nullptr;
 			}
 			static const PatternTable& get(GameRules rules);
+
+			/*
+			 * \brief Sets the file with precomputed tables that will be memory mapped by all subsequently created tables.
+			 * It must be called before the first call to 'get()' to have any effect.
+			 * If the file does not exist or is invalid, the tables are generated as usual.
+			 */
+			static void setTableFile(const std::string &path);
+			/*
+			 * \brief Generates tables for all rules and saves them into a single file that can be used with 'setTableFile()'.
+			 */
+			static void generateTableFile(const std::string &path);
 		private:
+			PatternTable(GameRules rules, bool useTableFile);
+			bool load_from_file(const std::string &path);
+			void generate();
 			void init_features();
 			void init_update_mask();
+			static constexpr uint32_t number_of_patterns() noexcept
+			{
+				return 1u << 20u;
+			}
 			/*
 			 * \brief Removes 2 central bits from the 22-bit number producing 20-bit number.
 			 */
@@ -12,10 +12,14 @@
 #include <alphagomoku/patterns/common.hpp>
 #include <alphagomoku/game/Move.hpp>
 #include <alphagomoku/utils/matrix.hpp>
+#include <alphagomoku/utils/board_size.hpp>
 
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
 #include <vector>
 #include <cassert>
+#include <x86intrin.h>
 
 namespace ag
 {
@@ -37,7 +41,7 @@ namespace ag
 		public:
 			RawPatternCalculator() noexcept = default;
 			RawPatternCalculator(int rows, int cols) noexcept :
-					m_data(6 * rows),
+					m_data(6 * rows + 4), // 4 more elements so that vectorized code can process whole rows without reading out of bounds
 					size(rows),
 					horizontal(m_data.data()),
 					vertical(m_data.data() + size),
@@ -69,27 +73,46 @@ namespace ag
 			{
 				assert(board.isSquare());
 				assert(board.rows() == static_cast<int>(size));
-				for (int i = 0; i < size; i++)
-				{
-					horizontal[i] = out_of_board | (out_of_board << (base_shift + get_line_length<HORIZONTAL>(i)));
-					vertical[i] = out_of_board | (out_of_board << (base_shift + get_line_length<VERTICAL>(i)));
-				}
-				for (int i = -size + 1; i < size; i++)
+				dispatchBoardSize(size, size, [&](auto boardSize)
+				{	this->set_lines<decltype(boardSize)::value>(board);});
+			}
+#ifdef __AVX2__
+			/*
+			 * \brief Returns normal patterns in given direction at four consecutive spots (row, col), ..., (row, col + 3) as 64-bit elements of the vector.
+			 * Elements for spots outside the board are undefined.
+			 */
+			template<Direction Dir, int N = 0>
+			__m256i getNormalPatternsInRow(int row, int col) const noexcept
+			{
+				const int size = get_board_size<N>(this->size);
+				assert(0 <= row && row < size && 0 <= col && col < size);
+				const __m256i col_idx = _mm256_setr_epi64x(col, col + 1, col + 2, col + 3);
+				const __m256i row_idx = _mm256_set1_epi64x(row);
+				__m256i lines, shift;
+				switch (Dir)
 				{
-					diagonal[i] = out_of_board | (out_of_board << (base_shift + get_line_length<DIAGONAL>(i)));
-					antidiagonal[i] = out_of_board | (out_of_board << (base_shift + get_line_length<ANTIDIAGONAL>(i)));
+					default:
+					case HORIZONTAL:
+						lines = _mm256_set1_epi64x(horizontal[row]);
+						shift = col_idx;
+						break;
+					case VERTICAL:
+						lines = _mm256_loadu_si256((const __m256i*) (vertical + col));
+						shift = row_idx;
+						break;
+					case DIAGONAL:
+						lines = _mm256_loadu_si256((const __m256i*) (diagonal + col - row));
+						shift = _mm256_min_epi32(col_idx, row_idx);
+						break;
+					case ANTIDIAGONAL:
+						lines = _mm256_loadu_si256((const __m256i*) (antidiagonal + col + row - size + 1));
+						shift = _mm256_min_epi32(_mm256_sub_epi64(_mm256_set1_epi64x(size - 1), col_idx), row_idx);
+						break;
 				}
-
-				for (int row = 0; row < size; row++)
-					for (int col = 0; col < size; col++)
-					{
-						const uint64_t tmp = static_cast<uint64_t>(board.at(row, col));
-						add<HORIZONTAL>(row, col, tmp);
-						add<VERTICAL>(row, col, tmp);
-						add<DIAGONAL>(row, col, tmp);
-						add<ANTIDIAGONAL>(row, col, tmp);
-					}
+				shift = _mm256_add_epi64(_mm256_add_epi64(shift, shift), _mm256_set1_epi64x(2)); // normal pattern skips one outermost spot of extended one
+				return _mm256_and_si256(_mm256_srlv_epi64(lines, shift), _mm256_set1_epi64x(normal_mask));
 			}
+#endif
 			void addMove(Move m) noexcept
 			{
 				assert(m.sign != ag::Sign::NONE);
@@ -175,6 +198,59 @@ namespace ag
 				return false;
 			}
 		private:
+			template<int N>
+			void set_lines(const matrix<Sign> &board) noexcept
+			{
+				const int size = get_board_size<N>(this->size);
+				for (int i = 0; i < size; i++)
+				{
+					horizontal[i] = out_of_board | (out_of_board << (base_shift + get_line_length<HORIZONTAL>(i)));
+					vertical[i] = out_of_board | (out_of_board << (base_shift + get_line_length<VERTICAL>(i)));
+				}
+				for (int i = -size + 1; i < size; i++)
+				{
+					diagonal[i] = out_of_board | (out_of_board << (base_shift + get_line_length<DIAGONAL>(i)));
+					antidiagonal[i] = out_of_board | (out_of_board << (base_shift + get_line_length<ANTIDIAGONAL>(i)));
+				}
+
+#ifdef __AVX2__
+				// each row is processed 4 cells at a time, all lines that these cells belong to are stored contiguously
+				static_assert(sizeof(Sign) == 2);
+				for (int row = 0; row < size; row++)
+				{
+					int16_t cells[24] = { 0 };
+					std::memcpy(cells, board.data() + row * size, sizeof(Sign) * size);
+
+					const __m256i row_idx = _mm256_set1_epi64x(row);
+					const __m128i vertical_shift = _mm_cvtsi32_si128(base_shift + 2 * row);
+					__m256i col_idx = _mm256_setr_epi64x(0, 1, 2, 3);
+					__m256i horizontal_line = _mm256_setzero_si256();
+					for (int col = 0; col < size; col += 4)
+					{
+						const __m256i tmp = _mm256_cvtepi16_epi64(_mm_loadl_epi64((const __m128i*) (cells + col)));
+						const __m256i inv_col_idx = _mm256_sub_epi64(_mm256_set1_epi64x(size - 1), col_idx);
+						// cells outside the board are empty so the lines beyond board size are not changed
+						horizontal_line = _mm256_or_si256(horizontal_line, _mm256_sllv_epi64(tmp, shift_of(col_idx)));
+						update_lines(vertical + col, _mm256_sll_epi64(tmp, vertical_shift));
+						update_lines(diagonal + col - row, _mm256_sllv_epi64(tmp, shift_of(_mm256_min_epi32(col_idx, row_idx))));
+						update_lines(antidiagonal + col + row - size + 1, _mm256_sllv_epi64(tmp, shift_of(_mm256_min_epi32(inv_col_idx, row_idx))));
+						col_idx = _mm256_add_epi64(col_idx, _mm256_set1_epi64x(4));
+					}
+					const __m128i tmp = _mm_or_si128(_mm256_castsi256_si128(horizontal_line), _mm256_extracti128_si256(horizontal_line, 1));
+					horizontal[row] |= static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_or_si128(tmp, _mm_unpackhi_epi64(tmp, tmp))));
+				}
+#else
+				for (int row = 0; row < size; row++)
+					for (int col = 0; col < size; col++)
+					{
+						const uint64_t tmp = static_cast<uint64_t>(board.at(row, col));
+						add<HORIZONTAL>(row, col, tmp);
+						add<VERTICAL>(row, col, tmp);
+						add<DIAGONAL>(row, col, tmp);
+						add<ANTIDIAGONAL>(row, col, tmp);
+					}
+#endif
+			}
 			template<typename T, Direction Dir>
 			uint32_t extract(int row, int col) const noexcept
 			{
@@ -225,6 +301,16 @@ namespace ag
 						return nullptr;
 				}
 			}
+#ifdef __AVX2__
+			static __m256i shift_of(__m256i idx) noexcept
+			{
+				return _mm256_add_epi64(_mm256_set1_epi64x(base_shift), _mm256_add_epi64(idx, idx));
+			}
+			static void update_lines(uint64_t *ptr, __m256i x) noexcept
+			{
+				_mm256_storeu_si256((__m256i*) ptr, _mm256_or_si256(_mm256_loadu_si256((const __m256i*) ptr), x));
+			}
+#endif
 			template<Direction Dir>
 			void add(int row, int col, uint64_t val) noexcept
 			{
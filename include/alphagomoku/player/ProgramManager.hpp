@@ -54,6 +54,7 @@ namespace ag
 			std::future<void> search_future;
 			std::ofstream logfile;
 			std::string name_of_config_file = "config.json";
+			std::string name_of_table_file = "pattern_tables.bin";
 
 			Json config;
 
@@ -63,6 +64,7 @@ namespace ag
 			bool run_benchmark = false;
 			bool run_configuration = false;
 			bool run_selfcheck = false;
+			bool run_table_generation = false;
 			bool is_running = true;
 
 			int game_counter = 0;
@@ -83,6 +85,7 @@ namespace ag
 			void benchmark() const;
 			void configure();
 			void selfcheck() const;
+			void generate_tables() const;
 			bool load_config(const std::string &path);
 			void setup_paths_in_config();
 
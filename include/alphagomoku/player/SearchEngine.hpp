@@ -12,6 +12,7 @@
 #include <alphagomoku/utils/matrix.hpp>
 #include <alphagomoku/search/monte_carlo/Tree.hpp>
 #include <alphagomoku/search/monte_carlo/NNEvaluator.hpp>
+#include <alphagomoku/search/alpha_beta/ParallelAlphaBetaSearch.hpp>
 
 #include <future>
 
@@ -47,6 +48,7 @@ namespace ag
 			NNEvaluatorPool nn_evaluators;
 
 			std::vector<std::unique_ptr<SearchThread>> search_threads;
+			ParallelAlphaBetaSearch root_solver;
 			Tree tree;
 		public:
 			SearchEngine(const EngineSettings &settings);
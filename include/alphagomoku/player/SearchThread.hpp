@@ -17,6 +17,7 @@ namespace ag
 	class EngineSettings;
 	class Tree;
 	class NNEvaluatorPool;
+	class ParallelAlphaBetaSearch;
 }
 
 namespace ag
@@ -34,7 +35,7 @@ namespace ag
 			mutable std::mutex search_mutex;
 			bool is_running = false;
 		public:
-			SearchThread(const EngineSettings &settings, Tree &tree, const NNEvaluatorPool &evaluators);
+			SearchThread(const EngineSettings &settings, Tree &tree, const NNEvaluatorPool &evaluators, ParallelAlphaBetaSearch *rootSolver = nullptr);
 			~SearchThread();
 			void reset();
 			void setPosition(const matrix<Sign> &board, Sign signToMove);
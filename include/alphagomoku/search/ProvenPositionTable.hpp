@@ -0,0 +1,57 @@
+/*
+ * ProvenPositionTable.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_SEARCH_PROVENPOSITIONTABLE_HPP_
+#define ALPHAGOMOKU_SEARCH_PROVENPOSITIONTABLE_HPP_
+
+#include <alphagomoku/game/Move.hpp>
+#include <alphagomoku/search/Score.hpp>
+#include <alphagomoku/search/ZobristHashing.hpp>
+
+#include <array>
+#include <vector>
+
+namespace ag
+{
+	/*
+	 * \brief Store of positions with proven score (win, draw or loss with distance) together with the move that leads to this score.
+	 * Unlike the alpha-beta hashtable it does not use generations, so the proofs survive between moves and are only replaced by other proofs.
+	 */
+	class ProvenPositionTable
+	{
+			struct Entry
+			{
+					HashKey128 key;
+					uint16_t score = 0;
+					uint16_t move = 0;
+					Sign sign_to_move = Sign::NONE; // the same board may be searched with different sides to move
+			};
+			using Bucket = std::array<Entry, 4>;
+
+			std::vector<Bucket> m_hashtable;
+			FastZobristHashing m_hash_function;
+			HashKey64 m_bucket_mask;
+		public:
+			ProvenPositionTable(int rows, int columns, size_t initialSize = 65536);
+			int64_t getMemory() const noexcept;
+			const FastZobristHashing& getHashFunction() const noexcept;
+			void clear() noexcept;
+			/*
+			 * \brief Returns true if the position was found, in such case its score and the best move are written to the output arguments.
+			 */
+			bool seek(const HashKey128 &hash, Sign signToMove, Score &score, Move &bestMove) const noexcept;
+			/*
+			 * \brief Only proven scores are stored, other ones are ignored.
+			 * When the bucket is full, the proof with the shortest distance is replaced as it is the cheapest one to find again.
+			 */
+			void insert(const HashKey128 &hash, Sign signToMove, Score score, Move bestMove) noexcept;
+			double loadFactor() const noexcept;
+	};
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_SEARCH_PROVENPOSITIONTABLE_HPP_ */
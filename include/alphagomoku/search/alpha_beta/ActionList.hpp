@@ -12,7 +12,9 @@
 #include <alphagomoku/search/Score.hpp>
 
 #include <algorithm>
+#include <array>
 #include <iostream>
+#include <vector>
 #include <cassert>
 
 namespace ag
@@ -263,12 +265,23 @@ namespace ag
 
 	class ActionStack
 	{
+			static constexpr int max_plies = 256;
+			static constexpr int max_move_index = 2 * 32 * 32;
+
 			std::vector<Action> m_data;
 			size_t m_offset = 0;
 			size_t m_max_offset = 0;
+
+			// move ordering heuristics, shared by all action lists created on this stack
+			std::vector<std::array<Move, 2>> m_killers; // two most recent moves that caused a cutoff at given ply
+			std::vector<int32_t> m_history; // accumulated cutoff bonuses indexed by sign and location of the move
+			std::vector<Move> m_countermoves; // last move that refuted given move (indexed by the refuted move)
 		public:
 			ActionStack(size_t size = 0) :
-					m_data(size)
+					m_data(size),
+					m_killers(max_plies),
+					m_history(max_move_index, 0),
+					m_countermoves(max_move_index)
 			{
 			}
 			void resize(size_t newSize)
@@ -312,6 +325,52 @@ namespace ag
 			{
 				return m_data.data() + m_offset;
 			}
+
+			/*
+			 * \brief Clears killer moves and countermoves, while history scores are only decayed so that they can be reused between searches.
+			 */
+			void resetMoveOrdering() noexcept
+			{
+				std::fill(m_killers.begin(), m_killers.end(), std::array<Move, 2>());
+				std::fill(m_countermoves.begin(), m_countermoves.end(), Move());
+				for (auto iter = m_history.begin(); iter < m_history.end(); iter++)
+					*iter /= 8;
+			}
+			void addCutoff(int ply, Move previous, Move move, int depth) noexcept
+			{
+				if (ply < max_plies and m_killers[ply][0] != move)
+				{
+					m_killers[ply][1] = m_killers[ply][0];
+					m_killers[ply][0] = move;
+				}
+				if (previous != Move())
+					m_countermoves[move_index(previous)] = move;
+				int32_t &history = m_history[move_index(move)];
+				history = std::min(history + depth * depth, 1 << 20);
+			}
+			/*
+			 * \brief Returns priority of the move to be searched first among the moves with the same score (killers, then countermove, then history).
+			 */
+			int32_t getOrderingPriority(int ply, Move previous, Move move) const noexcept
+			{
+				if (ply < max_plies)
+				{
+					if (m_killers[ply][0] == move)
+						return 1 << 23;
+					if (m_killers[ply][1] == move)
+						return 1 << 22;
+				}
+				if (previous != Move() and m_countermoves[move_index(previous)] == move)
+					return 1 << 21;
+				return m_history[move_index(move)];
+			}
+		private:
+			static int move_index(Move m) noexcept
+			{
+				assert(m.sign == Sign::CROSS || m.sign == Sign::CIRCLE);
+				assert(0 <= m.row && m.row < 32 && 0 <= m.col && m.col < 32);
+				return ((static_cast<int>(m.sign) - 1) << 10) | (m.row << 5) | m.col;
+			}
 	};
 
 	class ActionList
@@ -18,6 +18,9 @@
 
 #include <cassert>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace ag
 {
@@ -37,6 +40,9 @@ namespace ag
 			double max_time = std::numeric_limits<double>::max();
 			int node_counter = 0;
 			double start_time = 0.0;
+			const std::atomic<bool> *stop_flag = nullptr; // non-owning, used to stop helper threads of the parallel search
+			int helper_index = 0; // 0 for the main search, helpers use it to diversify the search
+			bool root_has_initiative = false;
 
 			GameConfig game_config;
 			PatternCalculator pattern_calculator;
@@ -44,15 +50,21 @@ namespace ag
 			nnue::InferenceNNUE inference_nnue;
 			nnue::TrainingNNUE_policy policy_nnue;
 
-			SharedHashTable shared_table;
+			std::shared_ptr<SharedHashTable> shared_table;
 			HashKey128 hash_key;
 
 			size_t total_positions = 0;
 			size_t total_calls = 0;
+			size_t total_cutoffs = 0;
+			size_t first_move_cutoffs = 0;
+			std::vector<size_t> nodes_per_ply;
 			TimedStat total_time;
 			TimedStat policy_time;
 		public:
-			AlphaBetaSearch(const GameConfig &gameConfig);
+			/*
+			 * \brief If no table is passed, the search allocates its own one.
+			 */
+			AlphaBetaSearch(const GameConfig &gameConfig, std::shared_ptr<SharedHashTable> sharedTable = nullptr);
 			void increaseGeneration();
 			void clear();
 			void loadWeights(const nnue::NNUEWeights &weights);
@@ -63,9 +75,17 @@ namespace ag
 			void setDepthLimit(int depth) noexcept;
 			void setNodeLimit(int nodes) noexcept;
 			void setTimeLimit(double time) noexcept;
+			void setStopFlag(const std::atomic<bool> *flag) noexcept;
+			void setHelperIndex(int index) noexcept;
+			/*
+			 * \brief Returns true if during the last call to 'solve()' the side to move had some forcing moves at root.
+			 */
+			bool hasInitiativeAtRoot() const noexcept;
 		private:
 			Score recursive_solve(int depthRemaining, Score alpha, Score beta, ActionList &actions);
 			bool is_move_legal(Move m) const noexcept;
+			bool is_better(const Action &lhs, const Action &rhs, const ActionList &actions) const noexcept;
+			bool is_out_of_budget() const noexcept;
 			Score evaluate();
 			void update_patterns();
 			void make_move(Move m);
@@ -0,0 +1,144 @@
+/*
+ * DFPNSearch.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_SEARCH_ALPHA_BETA_DFPNSEARCH_HPP_
+#define ALPHAGOMOKU_SEARCH_ALPHA_BETA_DFPNSEARCH_HPP_
+
+#include <alphagomoku/search/alpha_beta/ActionList.hpp>
+#include <alphagomoku/search/alpha_beta/MoveGenerator.hpp>
+#include <alphagomoku/search/ZobristHashing.hpp>
+#include <alphagomoku/patterns/PatternCalculator.hpp>
+#include <alphagomoku/utils/configs.hpp>
+#include <alphagomoku/utils/statistics.hpp>
+
+#include <array>
+#include <limits>
+#include <vector>
+
+namespace ag
+{
+	class SearchTask;
+}
+
+namespace ag
+{
+	/*
+	 * \brief Proof and disproof numbers stored from the perspective of the side to move (phi/delta formulation).
+	 */
+	struct ProofNumbers
+	{
+			static constexpr uint32_t infinity = 100000000u;
+
+			uint32_t phi = 1; // number of leaves that must be proven for the side to move to succeed
+			uint32_t delta = 1; // number of leaves that must be proven for the side to move to fail
+			int distance = 0; // number of plies until the end of the threat sequence, only meaningful if solved
+
+			bool isWin() const noexcept
+			{
+				return phi == 0;
+			}
+			bool isLoss() const noexcept
+			{
+				return delta == 0;
+			}
+			bool isSolved() const noexcept
+			{
+				return isWin() or isLoss();
+			}
+			static ProofNumbers win(int distance) noexcept
+			{
+				return ProofNumbers( { 0, infinity, distance });
+			}
+			static ProofNumbers loss(int distance) noexcept
+			{
+				return ProofNumbers( { infinity, 0, distance });
+			}
+	};
+
+	class ProofNumberTable
+	{
+			struct Entry
+			{
+					HashKey64 key;
+					uint32_t phi = 0;
+					uint32_t delta = 0;
+					uint32_t work = 0; // number of nodes searched below this entry, used to decide which entry to replace
+					int16_t distance = 0;
+					Sign attacker = Sign::NONE; // the same position has different meaning depending on which side is attacking
+			};
+			using Bucket = std::array<Entry, 2>;
+
+			std::vector<Bucket> m_hashtable;
+			FastZobristHashing m_hash_function;
+			HashKey64 m_bucket_mask;
+		public:
+			ProofNumberTable(int rows, int columns, size_t initialSize = 1024);
+			int64_t getMemory() const noexcept;
+			const FastZobristHashing& getHashFunction() const noexcept;
+			void clear() noexcept;
+			bool seek(const HashKey128 &hash, Sign attacker, ProofNumbers &result) const noexcept;
+			void insert(const HashKey128 &hash, Sign attacker, const ProofNumbers &value, uint32_t work) noexcept;
+			double loadFactor() const noexcept;
+	};
+
+	/*
+	 * \brief Depth-first proof-number search of threat sequences.
+	 * The side to move at root is the attacker that may only play threats (fours and, optionally, moves creating open threes),
+	 * while the defender can only play the moves that refute those threats (including own fours).
+	 * Only proofs are written to the task, as a failed search does not mean that the attacker cannot win by other means.
+	 */
+	class DFPNSearch
+	{
+		private:
+			ActionStack action_stack;
+			std::vector<ProofNumbers> child_numbers; // proof numbers of the actions stored at the same offsets as in the action stack
+
+			// search limits
+			int max_nodes = 1000;
+			double max_time = std::numeric_limits<double>::max();
+			int node_counter = 0;
+			double start_time = 0.0;
+			bool use_open_threes = true;
+
+			GameConfig game_config;
+			PatternCalculator pattern_calculator;
+			MoveGenerator move_generator;
+			ProofNumberTable proof_table;
+			HashKey128 hash_key;
+			Sign attacker = Sign::NONE;
+
+			size_t total_positions = 0;
+			size_t total_calls = 0;
+			size_t total_proofs = 0;
+			TimedStat total_time;
+		public:
+			DFPNSearch(const GameConfig &gameConfig, size_t hashTableSize);
+			void clear();
+			/*
+			 * \brief Returns the number of nodes searched. If the attacker has a winning threat sequence, the task is marked as proven.
+			 */
+			int solve(SearchTask &task);
+			void print_stats() const;
+			int64_t getMemory() const noexcept;
+
+			void setNodeLimit(int nodes) noexcept;
+			void setTimeLimit(double time) noexcept;
+			/*
+			 * \brief If false, only sequences of fours (VCF) are searched, otherwise open threes are also allowed (VCT).
+			 */
+			void useOpenThrees(bool flag) noexcept;
+		private:
+			void recursive_solve(uint32_t phiThreshold, uint32_t deltaThreshold, ProofNumbers &result, ActionList &actions);
+			bool generate_actions(ActionList &actions, ProofNumbers &result);
+			ProofNumbers get_child_numbers(const Action &action);
+			ProofNumbers* child_numbers_of(const ActionList &actions) noexcept;
+			bool is_out_of_budget() const noexcept;
+	};
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_SEARCH_ALPHA_BETA_DFPNSEARCH_HPP_ */
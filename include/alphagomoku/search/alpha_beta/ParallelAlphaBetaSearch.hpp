@@ -0,0 +1,63 @@
+/*
+ * ParallelAlphaBetaSearch.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_SEARCH_ALPHA_BETA_PARALLELALPHABETASEARCH_HPP_
+#define ALPHAGOMOKU_SEARCH_ALPHA_BETA_PARALLELALPHABETASEARCH_HPP_
+
+#include <alphagomoku/search/alpha_beta/AlphaBetaSearch.hpp>
+#include <alphagomoku/search/alpha_beta/SharedHashTable.hpp>
+#include <alphagomoku/search/monte_carlo/SearchTask.hpp>
+#include <alphagomoku/utils/configs.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ag
+{
+	/*
+	 * \brief Lazy SMP version of the alpha-beta search.
+	 * The main search runs on the calling thread while helpers run the same iterative deepening (starting from different depths
+	 * and with different move ordering) on separate threads. All of them share single transposition table.
+	 * Results of the helpers are only communicated through the table, the task is filled by the main search.
+	 */
+	class ParallelAlphaBetaSearch
+	{
+		private:
+			GameConfig game_config;
+			std::shared_ptr<SharedHashTable> shared_table;
+			AlphaBetaSearch main_search;
+			std::vector<std::unique_ptr<AlphaBetaSearch>> helpers;
+			std::vector<SearchTask> helper_tasks;
+			std::atomic<bool> stop_flag;
+			std::mutex solve_mutex;
+
+			int number_of_helpers = 0;
+			int max_nodes = 1000;
+			double max_time = std::numeric_limits<double>::max();
+		public:
+			ParallelAlphaBetaSearch(const GameConfig &gameConfig, int numberOfHelpers, size_t hashTableSize);
+			void increaseGeneration();
+			void clear();
+			void setNumberOfHelpers(int number) noexcept;
+			int getNumberOfHelpers() const noexcept;
+			int64_t getMemory() const noexcept;
+
+			void setNodeLimit(int nodes) noexcept;
+			void setTimeLimit(double time) noexcept;
+			/*
+			 * \brief Returns the number of nodes searched by the main search, or -1 if the solver is already being used by some other thread.
+			 */
+			int solve(SearchTask &task);
+		private:
+			void setup_helpers();
+	};
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_SEARCH_ALPHA_BETA_PARALLELALPHABETASEARCH_HPP_ */
@@ -93,18 +93,18 @@ namespace ag
 			{
 					static constexpr HashKey64 mask = 0xFFFF000000000000ull;
 
-					HashKey64 m_key;
+					HashKey64 m_key; // stored xor-ed with the value so that entries torn by concurrent writes from other threads fail the key check
 					SharedTableData m_value;
 				public:
 					Entry() noexcept = default;
 					Entry(const HashKey128 &key, SharedTableData value) noexcept :
-							m_key(key.getHigh()),
+							m_key(key.getHigh() ^ HashKey64(static_cast<uint64_t>(value))),
 							m_value(value)
 					{
 					}
 					HashKey64 getKey() const noexcept
 					{
-						return m_key;
+						return m_key ^ HashKey64(static_cast<uint64_t>(m_value));
 					}
 					SharedTableData getValue() const noexcept
 					{
@@ -160,8 +160,11 @@ namespace ag
 
 				const Bucket &bucket = m_hashtable[get_index_of(hash)];
 				for (size_t i = 0; i < bucket.size(); i++)
-					if (bucket[i].key_matches(hash))
-						return bucket[i].getValue();
+				{
+					const Entry entry = bucket[i]; // local copy, as the bucket may be modified by other threads at the same time
+					if (entry.key_matches(hash))
+						return entry.getValue();
+				}
 				return SharedTableData();
 			}
 			void insert(const HashKey128 &hash, SharedTableData value) noexcept
@@ -53,6 +53,13 @@ namespace ag
 			std::vector<TaskData> in_progress_queue;
 			std::unique_ptr<AGNetwork> network;
 
+			/*
+			 * scratch matrices used to apply symmetries while packing and unpacking a batch, allocated once in loadGraph()
+			 */
+			matrix<Sign> board_buffer;
+			matrix<float> policy_buffer;
+			matrix<Value> action_values_buffer;
+
 			PerfEstimator perf_estimator;
 			NNEvaluatorStats stats;
 			bool use_symmetries = false;
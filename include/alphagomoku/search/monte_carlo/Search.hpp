@@ -12,11 +12,14 @@
 #include <alphagomoku/game/Game.hpp>
 #include <alphagomoku/search/monte_carlo/SearchTask.hpp>
 #include <alphagomoku/search/alpha_beta/AlphaBetaSearch.hpp>
+#include <alphagomoku/search/alpha_beta/DFPNSearch.hpp>
+#include <alphagomoku/search/ProvenPositionTable.hpp>
 #include <alphagomoku/utils/configs.hpp>
 #include <alphagomoku/utils/statistics.hpp>
 #include <alphagomoku/utils/matrix.hpp>
 
 #include <cinttypes>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,6 +29,7 @@ namespace ag
 	class EdgeGenerator;
 	class NNEvaluator;
 	class Tree;
+	class ParallelAlphaBetaSearch;
 } /* namespace ag */
 
 namespace ag
@@ -45,6 +49,8 @@ namespace ag
 			uint64_t nb_proven_states = 0;
 			uint64_t nb_network_evaluations = 0;
 			uint64_t nb_node_count = 0;
+			uint64_t nb_parallel_root_solves = 0;
+			uint64_t nb_proven_table_hits = 0;
 
 			SearchStats();
 			std::string toString() const;
@@ -59,6 +65,9 @@ namespace ag
 			SearchTaskList tasks_list_buffer[2];
 
 			AlphaBetaSearch ab_search;
+			ParallelAlphaBetaSearch *root_solver = nullptr; // non-owning
+			std::unique_ptr<DFPNSearch> dfpn_search; // only created if enabled in the config
+			ProvenPositionTable proven_table; // proofs found by the solvers, kept between moves
 
 			GameConfig game_config;
 			SearchConfig search_config;
@@ -72,6 +81,14 @@ namespace ag
 			int64_t getMemory() const noexcept;
 			const SearchConfig& getConfig() const noexcept;
 			AlphaBetaSearch& getSolver() noexcept;
+			/*
+			 * \brief Clears hashtable of the solver and all stored proofs.
+			 */
+			void clear();
+			/*
+			 * \brief Sets the (optional) parallel solver that is used for the root position when it is sharp but unproven.
+			 */
+			void setRootSolver(ParallelAlphaBetaSearch *solver) noexcept;
 			void clearStats() noexcept;
 			SearchStats getStats() const noexcept;
 
@@ -89,10 +106,17 @@ namespace ag
 			void switchBuffer() noexcept;
 			void setBatchSize(int batchSize) noexcept;
 			int getBatchSize() const noexcept;
+			/*
+			 * \brief Returns selected task from the current buffer, so it can be evaluated without NNEvaluator.
+			 */
+			SearchTask& getTask(int index);
 		private:
 			const SearchTaskList& get_buffer() const noexcept;
 			SearchTaskList& get_buffer() noexcept;
 			bool is_duplicate(const SearchTask &task) const noexcept;
+			bool is_critical_root(const SearchTask &task) const noexcept;
+			bool load_proven_position(SearchTask &task, const HashKey128 &hash) const;
+			void store_proven_position(const SearchTask &task, const HashKey128 &hash) noexcept;
 	};
 
 } /* namespace ag */
@@ -0,0 +1,89 @@
+/*
+ * BatchProducer.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_SELFPLAY_BATCHPRODUCER_HPP_
+#define ALPHAGOMOKU_SELFPLAY_BATCHPRODUCER_HPP_
+
+#include <alphagomoku/networks/NetworkDataPack.hpp>
+#include <alphagomoku/utils/configs.hpp>
+
+#include <condition_variable>
+#include <cinttypes>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ag
+{
+	class Dataset;
+	class Sampler;
+	class SampleIndex;
+} /* namespace ag */
+
+namespace ag
+{
+	/*
+	 * \brief Prepares training batches on several worker threads.
+	 * Batches are kept in a ring of packs, each pack is filled by one of the workers and then consumed in the order in which the workers claimed them.
+	 * Each worker has its own sampler and its own, independently seeded random number generator, but all of them share the same sample index (if any).
+	 * Exception thrown by any of the workers is rethrown to the consumer by the next call to 'get'.
+	 */
+	class BatchProducer
+	{
+		public:
+			/*
+			 * \brief Fills the pack with a batch using the sampler of the worker.
+			 */
+			using FillFunction = std::function<void(NetworkDataPack &pack, Sampler &sampler)>;
+		private:
+			enum class SlotState
+			{
+				FREE,
+				FILLING,
+				READY
+			};
+
+			std::vector<NetworkDataPack> packs;
+			std::vector<SlotState> states;
+			std::vector<std::future<void>> workers;
+			mutable std::mutex producer_mutex;
+			std::condition_variable producer_cond;
+			std::exception_ptr worker_exception;
+			uint64_t next_to_fill = 0;
+			uint64_t next_to_consume = 0;
+			double loading_time = 0.0; // summed over all workers
+			double waiting_time = 0.0; // time spent by the consumer waiting for the next batch
+			bool is_stopping = false;
+		public:
+			BatchProducer(const Dataset &dataset, const std::string &samplerType, std::shared_ptr<const SampleIndex> index, GameConfig cfg, int batchSize,
+					ml::DataType dtype, int numberOfWorkers, FillFunction fill);
+			BatchProducer(const BatchProducer &other) = delete;
+			BatchProducer& operator=(const BatchProducer &other) = delete;
+			/*
+			 * \brief Waits until the workers finish the batches they are currently filling.
+			 */
+			~BatchProducer();
+			/*
+			 * \brief Blocks until the next batch is ready. The returned pack is owned by the caller until release() is called.
+			 */
+			NetworkDataPack& get();
+			void release();
+			double getLoadingTime() const;
+			double getWaitingTime() const;
+			int numberOfWorkers() const noexcept;
+		private:
+			void worker_loop(const Dataset &dataset, const std::string &samplerType, const std::shared_ptr<const SampleIndex> &index, int batchSize,
+					const FillFunction &fill, uint64_t seed);
+	};
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_SELFPLAY_BATCHPRODUCER_HPP_ */
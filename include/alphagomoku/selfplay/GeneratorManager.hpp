@@ -9,6 +9,7 @@
 #define SELFPLAY_GENERATORMANAGER_HPP_
 
 #include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/GameDataWriter.hpp>
 #include <alphagomoku/selfplay/GameGenerator.hpp>
 #include <alphagomoku/selfplay/NetworkLoader.hpp>
 #include <alphagomoku/search/monte_carlo/NNEvaluator.hpp>
@@ -79,6 +80,9 @@ namespace ag
 			mutable std::mutex buffer_mutex;
 			std::vector<std::unique_ptr<GeneratorThread>> generators;
 			GameDataBuffer game_buffer;
+			std::vector<std::unique_ptr<GameDataWriter>> outputs; // if present, games are written to them instead of the game buffer
+			std::vector<int> output_limits;
+			std::vector<int> routed_games; // number of games sent to each output
 
 			int games_to_generate = 0;
 			std::string working_directory;
@@ -88,6 +92,18 @@ namespace ag
 
 			void setWorkingDirectory(const std::string &path);
 			void addToBuffer(const GameDataStorage &gameData);
+			/*
+			 * \brief Finished games are written to the file as they come (see GameDataWriter) instead of being kept in the game buffer.
+			 * Outputs are filled in the order in which they were added, each with given number of games, and any excess goes to the last one.
+			 * Games already present in the file (for example after an interrupted run) are kept and count towards its number of games.
+			 * Streamed games are not deduplicated, as the samples they could be merged into were already written.
+			 */
+			void addOutput(const std::string &path, int numberOfGames);
+			/*
+			 * \brief Writes remaining games and index of every output file, marking them as complete.
+			 */
+			void closeOutputs();
+			int numberOfGames() const noexcept;
 
 			const GameDataBuffer& getGameBuffer() const noexcept;
 			GameDataBuffer& getGameBuffer() noexcept;
@@ -96,6 +112,7 @@ namespace ag
 			void generate(const NetworkLoader &loader, int numberOfGames);
 			bool hasEnoughGames() const noexcept;
 
+			GameDataBufferStats getStats() const;
 			void printStats();
 
 			void saveState(bool saveBuffer);
@@ -19,6 +19,7 @@ namespace ag
 {
 	class Dataset;
 	class AGNetwork;
+	class BatchProducer;
 } /* namespace ag */
 
 namespace ag
@@ -30,12 +31,19 @@ namespace ag
 			std::vector<float> training_accuracy;
 			std::vector<float> validation_loss;
 			std::vector<float> validation_accuracy;
+			double compute_time = 0.0; // time spent in the network
+			double loading_time = 0.0; // time spent preparing batches, summed over all loader threads
+			double waiting_time = 0.0; // time for which training was stalled waiting for the next batch
 
 			TrainingConfig config;
 		public:
 			SupervisedLearning(const TrainingConfig &config);
 			void updateTrainingStats(const std::vector<float> &loss, std::vector<float> &acc);
 			void updateValidationStats(const std::vector<float> &loss, std::vector<float> &acc);
+			/*
+			 * \brief Adds loading and waiting times of the producer to the timing stats, which are saved into the training history together with the losses.
+			 */
+			void updateTimingStats(const BatchProducer &producer);
 			void train(AGNetwork &model, const Dataset &dataset, int steps);
 			void train(AGNetwork &teacher, AGNetwork &student, const Dataset &dataset, int steps);
 			void validate(AGNetwork &model, const Dataset &dataset);
@@ -46,12 +46,12 @@ namespace ag
 			void train_and_validate();
 			void evaluate();
 			void gating();
-			void splitBuffer(GameDataBuffer &buffer, int training_games, int validation_games);
+			void deduplicateBuffer(const std::string &path);
 			void loadDataset(Dataset &result, const std::string &path);
 
 			int get_last_checkpoint() const;
 			int get_best_checkpoint() const;
-			void save_buffer_stats(const GameDataBuffer &buffer) const;
+			void save_buffer_stats(const GameDataBufferStats &stats) const;
 	};
 
 } /* namespace ag */
@@ -0,0 +1,102 @@
+/*
+ * AliasTable.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_UTILS_ALIASTABLE_HPP_
+#define ALPHAGOMOKU_UTILS_ALIASTABLE_HPP_
+
+#include <alphagomoku/utils/random.hpp>
+
+#include <vector>
+#include <cinttypes>
+#include <cmath>
+#include <stdexcept>
+
+namespace ag
+{
+	/*
+	 * \brief Walker's alias method (in the variant by Vose) for drawing from a discrete distribution in O(1) time.
+	 * The table is immutable after construction and draws use thread local generators, so one table can be shared between threads.
+	 */
+	class AliasTable
+	{
+		private:
+			std::vector<float> probability;
+			std::vector<uint32_t> alias;
+		public:
+			AliasTable() noexcept = default;
+			AliasTable(const std::vector<double> &weights) :
+					probability(weights.size(), 1.0f),
+					alias(weights.size())
+			{
+				double sum = 0.0;
+				for (size_t i = 0; i < weights.size(); i++)
+				{
+					if (weights[i] < 0.0 or not std::isfinite(weights[i]))
+						throw std::invalid_argument("AliasTable() : weights must be finite and non-negative");
+					sum += weights[i];
+				}
+				if (weights.size() > 0 and sum == 0.0)
+					throw std::invalid_argument("AliasTable() : at least one weight must be positive");
+
+				const double scale = weights.size() / sum;
+				std::vector<double> scaled(weights.size());
+				std::vector<uint32_t> small, large;
+				for (size_t i = 0; i < weights.size(); i++)
+				{
+					alias[i] = i;
+					scaled[i] = weights[i] * scale;
+					if (scaled[i] < 1.0)
+						small.push_back(i);
+					else
+						large.push_back(i);
+				}
+				while (not small.empty() and not large.empty())
+				{
+					const uint32_t s = small.back();
+					const uint32_t l = large.back();
+					small.pop_back();
+					large.pop_back();
+
+					probability[s] = scaled[s];
+					alias[s] = l;
+					scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+					if (scaled[l] < 1.0)
+						small.push_back(l);
+					else
+						large.push_back(l);
+				}
+				// because of rounding errors some entries may be left in either list, their probability is 1
+			}
+			int size() const noexcept
+			{
+				return probability.size();
+			}
+			bool isEmpty() const noexcept
+			{
+				return probability.empty();
+			}
+			/*
+			 * \brief Probability of drawing given index, useful mostly for testing.
+			 */
+			double getProbability(int index) const
+			{
+				double result = probability.at(index);
+				for (size_t i = 0; i < probability.size(); i++)
+					if (alias[i] == static_cast<uint32_t>(index) and i != static_cast<size_t>(index))
+						result += 1.0 - probability[i];
+				return result / probability.size();
+			}
+			int draw() const
+			{
+				const int index = randInt(size());
+				return (randFloat() < probability[index]) ? index : alias[index];
+			}
+	};
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_UTILS_ALIASTABLE_HPP_ */
@@ -13,6 +13,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <vector>
 
 namespace ag
 {
@@ -215,6 +217,39 @@ namespace ag
 
 	Move apply_symmetry(Move move, MatrixShape shape, Symmetry s) noexcept;
 
+	/*
+	 * \brief Precomputed indices of elements for all symmetries available for given shape, so that a symmetry can be applied
+	 * to the whole batch of samples as a single gather 'dst[i] = src[indices[i]]'. Each cell holds 'channels' consecutive elements.
+	 */
+	class SymmetryIndexTable
+	{
+			MatrixShape shape;
+			int channels = 0;
+			std::vector<std::vector<int>> indices; // for each symmetry
+		public:
+			SymmetryIndexTable() noexcept = default;
+			SymmetryIndexTable(MatrixShape shape, int channels = 1);
+			/*
+			 * \brief Additionally moves c-th channel of each cell to 'permutation[c]' when given symmetry is applied.
+			 * It is used for features that depend on direction (for example horizontal and vertical ones swap under rotation).
+			 */
+			void permuteChannels(Symmetry s, const std::vector<int> &permutation);
+			MatrixShape getShape() const noexcept;
+			int numberOfChannels() const noexcept;
+			int length() const noexcept;
+			const std::vector<int>& get(Symmetry s) const noexcept;
+			/*
+			 * \brief Returns shared table for given shape and number of channels, creating it on first use. Thread safe.
+			 */
+			static const SymmetryIndexTable& getShared(MatrixShape shape, int channels = 1);
+	};
+
+	/*
+	 * \brief Applies i-th symmetry to i-th sample of the batch stored in 'data', with 'table.length()' elements of 'elementSize' bytes per sample.
+	 */
+	void apply_symmetry_to_batch(void *data, size_t elementSize, const SymmetryIndexTable &table, const std::vector<Symmetry> &symmetries,
+			std::vector<char> &workspace);
+
 } /* namespace ag */
 
 #endif /* ALPHAGOMOKU_UTILS_AUGMENTATIONS_HPP_ */
@@ -0,0 +1,50 @@
+/*
+ * board_size.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_UTILS_BOARD_SIZE_HPP_
+#define ALPHAGOMOKU_UTILS_BOARD_SIZE_HPP_
+
+#include <type_traits>
+
+namespace ag
+{
+	/*
+	 * \brief Board size known at compile time, 0 means that the size is known only at runtime.
+	 */
+	template<int N>
+	using BoardSize = std::integral_constant<int, N>;
+
+	/*
+	 * \brief Almost all games are played on 15x15 or 20x20 boards, so the loops over whole board can be compiled separately for those sizes.
+	 * The function is called with BoardSize<15>, BoardSize<20> or, for all other sizes, with BoardSize<0> as the argument.
+	 */
+	template<class Op>
+	void dispatchBoardSize(int rows, int cols, Op op)
+	{
+		if (rows == 15 and cols == 15)
+			op(BoardSize<15>());
+		else
+		{
+			if (rows == 20 and cols == 20)
+				op(BoardSize<20>());
+			else
+				op(BoardSize<0>());
+		}
+	}
+
+	/*
+	 * \brief Returns the size that should be used inside the function compiled for given BoardSize.
+	 */
+	template<int N>
+	constexpr int get_board_size(int runtimeSize) noexcept
+	{
+		return (N == 0) ? runtimeSize : N;
+	}
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_UTILS_BOARD_SIZE_HPP_ */
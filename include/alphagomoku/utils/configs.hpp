@@ -116,7 +116,7 @@ namespace ag
 					static constexpr int hash_table_size = 1048576;
 			};
 		public:
-			int mode = Defaults::mode; /**< 0 - only terminal moves, 1 - static evaluation, 2 - recursive search */
+			int mode = Defaults::mode; /**< 0 - only terminal moves, 1 - static evaluation, 2 - recursive search, 3 - recursive search and proof-number search of threats */
 			int max_positions = Defaults::max_positions;
 			int hash_table_size = Defaults::hash_table_size;
 
@@ -168,7 +168,12 @@ namespace ag
 	{
 			std::string network_arch = "ConvNextPVWM_raw";
 			std::string sampler_type = "values";
+			std::string sample_weighting = "games"; // "games" draws a random game first, other options ("uniform", "recency", "surprise") draw directly from all samples
 			bool keep_loaded = true;
+			bool use_indexed_dataset = false; // if true, training buffers are converted once to the indexed format and then memory mapped
+			int max_resident_samples = 0; // if greater than 0, training buffers are streamed and at most this many samples are kept in memory
+			bool use_sample_cache = false; // if true, preprocessed samples of each buffer are cached on disk next to it and reused in later iterations
+			int data_loader_threads = 1; // number of threads preparing training batches
 			bool augment_training_data = true;
 			DeviceConfig device_config;
 			int steps_per_iteration = 1000;
@@ -215,6 +220,7 @@ namespace ag
 			bool use_opening = true;
 			bool use_symmetries = true;
 			bool keep_loaded = false;
+			bool deduplicate_samples = false; // if true, samples of identical positions are merged when games are added to the buffer
 			int games_per_iteration = 100;
 			int games_per_thread = 8;
 			Constraints constraints;
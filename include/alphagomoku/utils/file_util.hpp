@@ -40,6 +40,42 @@ namespace ag
 		offset += size_in_bytes;
 	}
 
+	/*
+	 * \brief Compressed files are stored as a sequence of independently compressed chunks preceded by an index.
+	 * This way chunks can be compressed and uncompressed in parallel, and any range of the uncompressed data can be read
+	 * without uncompressing the rest. Files compressed as a single stream (older format) are still recognized when loading.
+	 */
+	bool isChunkedFormat(const std::vector<char> &data) noexcept;
+	bool isChunkedFile(const std::string &path);
+	/*
+	 * \brief If numberOfThreads is 0, all available hardware threads are used.
+	 */
+	std::vector<char> compressChunked(const std::vector<char> &data, size_t chunkSize = 4 * 1024 * 1024, int numberOfThreads = 0);
+	std::vector<char> uncompressChunked(const std::vector<char> &data, int numberOfThreads = 0);
+
+	class ChunkedFileReader
+	{
+			std::string path;
+			std::vector<uint64_t> chunk_offsets; // position of each compressed chunk in the file
+			std::vector<uint64_t> chunk_sizes; // size of each compressed chunk
+			uint64_t chunk_size = 0; // size of uncompressed chunk (the last one may be smaller)
+			uint64_t total_size = 0; // size of all uncompressed data
+		public:
+			/*
+			 * \brief Reads only the header and index of chunks. Throws if the file is not in chunked format.
+			 */
+			ChunkedFileReader(const std::string &path);
+			size_t size() const noexcept;
+			/*
+			 * \brief Reads given range of the uncompressed data, uncompressing only the chunks that overlap with it.
+			 */
+			std::vector<char> read(size_t offset, size_t length, int numberOfThreads = 1) const;
+			/*
+			 * \brief Reads json saved at the beginning of the file by FileSaver, uncompressing chunks only until the json ends.
+			 */
+			Json readJson() const;
+	};
+
 	class FileSaver
 	{
 			std::string path;
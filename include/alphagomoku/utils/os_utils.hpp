@@ -9,6 +9,7 @@
 #define ALPHAGOMOKU_UTILS_OS_UTILS_HPP_
 
 #include <string>
+#include <cstddef>
 
 namespace ag
 {
@@ -62,6 +63,44 @@ namespace ag
 	void setupSignalHandler(SignalType type, SignalHandlerMode mode);
 	bool hasCapturedSignal(SignalType type) noexcept;
 
+	/*
+	 * \brief Read-only view of a file mapped into memory. Physical pages are shared between all processes that map the same file.
+	 */
+	class MemoryMappedFile
+	{
+			const void *m_data = nullptr;
+			size_t m_size = 0;
+#if defined(_WIN32)
+			void *m_file_handle = nullptr;
+			void *m_mapping_handle = nullptr;
+#endif
+		public:
+			MemoryMappedFile() noexcept = default;
+			/*
+			 * \brief Throws std::runtime_error if the file cannot be mapped.
+			 */
+			MemoryMappedFile(const std::string &path);
+			MemoryMappedFile(const MemoryMappedFile &other) = delete;
+			MemoryMappedFile(MemoryMappedFile &&other) noexcept;
+			MemoryMappedFile& operator=(const MemoryMappedFile &other) = delete;
+			MemoryMappedFile& operator=(MemoryMappedFile &&other) noexcept;
+			~MemoryMappedFile();
+
+			bool isOpen() const noexcept
+			{
+				return m_data != nullptr;
+			}
+			const void* data() const noexcept
+			{
+				return m_data;
+			}
+			size_t size() const noexcept
+			{
+				return m_size;
+			}
+			void close() noexcept;
+	};
+
 } /* namespace ag */
 
 #endif /* ALPHAGOMOKU_UTILS_OS_UTILS_HPP_ */
@@ -26,6 +26,10 @@ namespace ag
 	int32_t randInt(int r0, int r1);
 	uint64_t randLong();
 	bool randBool();
+	/*
+	 * \brief Seeds the generators of the calling thread, each thread has its own independent ones.
+	 */
+	void setRandomSeed(uint64_t seed);
 
 	float randBeta(float alpha, float beta);
 
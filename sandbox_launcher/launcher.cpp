@@ -10,6 +10,8 @@
 #include <alphagomoku/dataset/GameDataStorage.hpp>
 #include <alphagomoku/dataset/SearchDataStorage.hpp>
 #include <alphagomoku/dataset/Sampler.hpp>
+#include <alphagomoku/dataset/SampleIndex.hpp>
+#include <alphagomoku/dataset/Dataset.hpp>
 #include <alphagomoku/dataset/CompressedFloat.hpp>
 #include <alphagomoku/game/Move.hpp>
 #include <alphagomoku/game/rules.hpp>
@@ -47,6 +49,7 @@
 #include <alphagomoku/search/alpha_beta/MoveGenerator.hpp>
 #include <alphagomoku/search/alpha_beta/MinimaxSearch.hpp>
 #include <alphagomoku/search/alpha_beta/AlphaBetaSearch.hpp>
+#include <alphagomoku/search/alpha_beta/DFPNSearch.hpp>
 #include <alphagomoku/search/alpha_beta/VCFSolver.hpp>
 #include <alphagomoku/game/Board.hpp>
 #include <alphagomoku/selfplay/GameBuffer.hpp>
@@ -91,6 +94,7 @@
 #include <cmath>
 #include <fstream>
 #include <iterator>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -1079,6 +1083,133 @@ void test_move_generator()
 //	calculator.print_stats();
 }
 
+/*
+ * Each line of the file describes a single position as rules, board size and the sequence of moves, for example "STANDARD 15 Xh7 Oi8 Xi7".
+ * Empty lines and lines starting with '#' are skipped.
+ */
+void benchmark_move_generator(const std::string &path = "test/positions.txt", int repeats = 100)
+{
+	struct Position
+	{
+			GameConfig game_config;
+			std::vector<Move> moves;
+	};
+	std::vector<Position> positions;
+	std::ifstream file(path);
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.empty() or line[0] == '#')
+			continue;
+		std::istringstream stream(line);
+		std::string rules, move;
+		int size = 0;
+		stream >> rules >> size;
+		Position tmp { GameConfig(rulesFromString(rules), size), { } };
+		while (stream >> move)
+			tmp.moves.push_back(Move(move));
+		positions.push_back(tmp);
+	}
+	std::cout << "loaded " << positions.size() << " positions from '" << path << "'\n";
+	if (positions.empty())
+		return;
+
+	const std::vector<std::pair<MoveGeneratorMode, std::string>> modes = { { MoveGeneratorMode::THREATS, "THREATS" }, { MoveGeneratorMode::OPTIMAL,
+			"OPTIMAL" }, { MoveGeneratorMode::REDUCED, "REDUCED" }, { MoveGeneratorMode::LEGAL, "LEGAL" } };
+	std::vector<double> generate_time(modes.size(), 0.0), generated_actions(modes.size(), 0.0);
+	double update_time = 0.0;
+
+	ActionStack action_stack(1024);
+	for (auto iter = positions.begin(); iter < positions.end(); iter++)
+	{
+		PatternCalculator calculator(iter->game_config);
+		MoveGenerator generator(iter->game_config, calculator);
+
+		matrix<Sign> board(iter->game_config.rows, iter->game_config.cols);
+		for (auto move = iter->moves.begin(); move < iter->moves.end(); move++)
+			Board::putMove(board, *move);
+		const Sign sign_to_move = iter->moves.empty() ? Sign::CROSS : invertSign(iter->moves.back().sign);
+
+		if (not iter->moves.empty())
+		{ // incremental update of patterns and threats is measured on the last move of the position
+			const Move last_move = iter->moves.back();
+			Board::undoMove(board, last_move);
+			calculator.setBoard(board, last_move.sign);
+			const double start = getTime();
+			for (int i = 0; i < repeats; i++)
+			{
+				calculator.addMove(last_move);
+				calculator.undoMove(last_move);
+			}
+			update_time += getTime() - start;
+			Board::putMove(board, last_move);
+		}
+
+		calculator.setBoard(board, sign_to_move);
+		for (size_t m = 0; m < modes.size(); m++)
+		{
+			const double start = getTime();
+			for (int i = 0; i < repeats; i++)
+			{
+				ActionList actions(action_stack);
+				generator.generate(actions, modes[m].first);
+				if (i == 0)
+					generated_actions[m] += actions.size();
+			}
+			generate_time[m] += getTime() - start;
+		}
+	}
+
+	const double number_of_calls = static_cast<double>(positions.size()) * repeats;
+	std::cout << "addMove + undoMove : " << 1.0e6 * update_time / number_of_calls << " us\n";
+	for (size_t m = 0; m < modes.size(); m++)
+		std::cout << modes[m].second << " : " << 1.0e6 * generate_time[m] / number_of_calls << " us, " << generated_actions[m] / positions.size()
+				<< " actions\n";
+}
+
+void benchmark_sampler(const std::string &path, int numberOfBuffers, int draws = 100000)
+{
+	Dataset dataset;
+	for (int i = 0; i < numberOfBuffers; i++)
+		dataset.load(i, path + "buffer_" + std::to_string(i) + ".bin");
+	std::cout << "loaded " << dataset.numberOfSamples() << " samples in " << dataset.numberOfGames() << " games\n";
+	if (dataset.numberOfSamples() == 0)
+		return;
+
+	const GameConfig game_config = dataset.getConfig(dataset.getListOfBuffers().front());
+	TrainingDataPack pack(game_config.rows, game_config.cols);
+	std::unique_ptr<Sampler> sampler = createSampler("visits");
+
+	sampler->init(dataset, 256);
+	double start = getTime();
+	for (int i = 0; i < draws; i++)
+		sampler->get(pack);
+	std::cout << "games : " << draws / (getTime() - start) << " samples/s\n";
+
+	const std::vector<SampleWeighting> weightings = { SampleWeighting::UNIFORM, SampleWeighting::RECENCY, SampleWeighting::SURPRISE };
+	for (size_t w = 0; w < weightings.size(); w++)
+	{
+		start = getTime();
+		const std::shared_ptr<const SampleIndex> index = std::make_shared<const SampleIndex>(dataset, weightings[w]);
+		const double build_time = getTime() - start;
+
+		start = getTime();
+		int checksum = 0;
+		for (int i = 0; i < draws; i++)
+			checksum += index->draw().sample_index; // only the draw itself, without decoding the sample
+		const double draw_time = getTime() - start;
+
+		sampler->init(dataset, 256, index);
+		start = getTime();
+		for (int i = 0; i < draws; i++)
+			sampler->get(pack);
+		const double get_time = getTime() - start;
+
+		std::cout << toString(weightings[w]) << " : " << draws / get_time << " samples/s, " << 1.0e9 * draw_time / draws
+				<< " ns per draw, index built in " << build_time << "s (checksum " << checksum << ")\n";
+	}
+}
+
 void test_proven_positions(int pos)
 {
 //	GameConfig game_config(GameRules::FREESTYLE, 20);
@@ -1202,6 +1333,65 @@ void test_proven_positions(int pos)
 
 }
 
+void test_dfpn_search(int pos)
+{
+	GameConfig game_config(GameRules::RENJU, 15);
+
+	GameDataBuffer buffer;
+	buffer.load("/media/maciek/Data Linux/alphagomoku/runs_2025/renju_8x128/train_buffer/buffer_399.bin");
+
+	AlphaBetaSearch ab_search(game_config);
+	ab_search.setNodeLimit(pos);
+	DFPNSearch dfpn_search(game_config, 1048576);
+	dfpn_search.setNodeLimit(pos);
+
+	SearchDataPack pack(game_config.rows, game_config.cols);
+	SearchTask task(game_config);
+	int total_samples = 0;
+	int ab_solved = 0, dfpn_solved = 0, dfpn_only_solved = 0;
+	int ab_nodes_to_proof = 0, dfpn_nodes_to_proof = 0;
+	double ab_time_to_proof = 0.0, dfpn_time_to_proof = 0.0;
+
+	for (int i = 0; i < buffer.numberOfGames(); i += 10)
+		for (int j = 0; j < buffer.getGameData(i).numberOfSamples(); j++)
+		{
+			buffer.getGameData(i).getSample(pack, j);
+			if (not pack.minimax_score.isWin())
+				continue; // only positions proven as a win for the side to move
+			total_samples++;
+
+			task.set(pack.board, pack.played_move.sign);
+			double t0 = getTime();
+			int positions = ab_search.solve(task);
+			const bool ab_proof = task.getScore().isWin();
+			if (ab_proof)
+			{
+				ab_solved++;
+				ab_nodes_to_proof += positions;
+				ab_time_to_proof += getTime() - t0;
+			}
+
+			task.set(pack.board, pack.played_move.sign);
+			t0 = getTime();
+			positions = dfpn_search.solve(task);
+			if (task.getScore().isWin())
+			{
+				dfpn_solved++;
+				dfpn_only_solved += not ab_proof;
+				dfpn_nodes_to_proof += positions;
+				dfpn_time_to_proof += getTime() - t0;
+			}
+		}
+
+	std::cout << "proven positions = " << total_samples << '\n';
+	std::cout << "a-b  solved " << ab_solved << ", avg nodes to proof = " << ab_nodes_to_proof / std::max(1, ab_solved) << ", avg time to proof = "
+			<< 1.0e3 * ab_time_to_proof / std::max(1, ab_solved) << "ms\n";
+	std::cout << "dfpn solved " << dfpn_solved << " (" << dfpn_only_solved << " not solved by a-b), avg nodes to proof = "
+			<< dfpn_nodes_to_proof / std::max(1, dfpn_solved) << ", avg time to proof = " << 1.0e3 * dfpn_time_to_proof / std::max(1, dfpn_solved)
+			<< "ms\n";
+	dfpn_search.print_stats();
+}
+
 void test_solver(int pos)
 {
 ////	GameConfig game_config(GameRules::FREESTYLE, 20);
@@ -3808,6 +3998,7 @@ int main(int argc, char *argv[])
 	std::cout << "BEGIN" << std::endl;
 	std::cout << ml::Device::hardwareInfo() << '\n';
 //	test_proven_search(10000, 1000, false);
+//	test_dfpn_search(10000);
 //	test_rl();
 //	return 0;
 
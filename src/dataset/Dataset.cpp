@@ -7,11 +7,28 @@
 
 #include <alphagomoku/dataset/Dataset.hpp>
 #include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/utils/misc.hpp>
+#include <alphagomoku/utils/random.hpp>
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 
 namespace ag
 {
+	std::string StreamingStats::toString() const
+	{
+		std::string result;
+		result += "----StreamingStats----\n";
+		result += "draws     = " + std::to_string(draws) + '\n';
+		result += "hits      = " + std::to_string(hits) + '\n';
+		result += "prefetch  = " + std::to_string(prefetch_waits) + '\n';
+		result += "misses    = " + std::to_string(misses) + '\n';
+		result += "loads     = " + std::to_string(loads) + '\n';
+		result += "evictions = " + std::to_string(evictions) + '\n';
+		result += "wait time = " + std::to_string(wait_time) + "s\n";
+		return result;
+	}
 
 	GameDataBufferStats Dataset::getStats() const noexcept
 	{
@@ -19,12 +36,16 @@ namespace ag
 		GameDataBufferStats stats;
 		for (auto iter = m_list_of_buffers.begin(); iter != m_list_of_buffers.end(); iter++)
 			stats += iter->second.getStats();
+		for (auto iter = m_list_of_indexed_buffers.begin(); iter != m_list_of_indexed_buffers.end(); iter++)
+			stats += iter->second.getStats();
+		for (auto iter = m_streamed_buffers.begin(); iter != m_streamed_buffers.end(); iter++)
+			stats += iter->second.stats;
 		return stats;
 	}
 	int Dataset::numberOfBuffers() const noexcept
 	{
 		std::lock_guard<std::mutex> lock(m_list_mutex);
-		return m_list_of_buffers.size();
+		return m_list_of_buffers.size() + m_list_of_indexed_buffers.size() + m_streamed_buffers.size();
 	}
 	int Dataset::numberOfGames() const noexcept
 	{
@@ -32,6 +53,10 @@ namespace ag
 		int result = 0;
 		for (auto iter = m_list_of_buffers.begin(); iter != m_list_of_buffers.end(); iter++)
 			result += iter->second.numberOfGames();
+		for (auto iter = m_list_of_indexed_buffers.begin(); iter != m_list_of_indexed_buffers.end(); iter++)
+			result += iter->second.numberOfGames();
+		for (auto iter = m_streamed_buffers.begin(); iter != m_streamed_buffers.end(); iter++)
+			result += iter->second.stats.games;
 		return result;
 	}
 	int Dataset::numberOfSamples() const noexcept
@@ -40,20 +65,47 @@ namespace ag
 		int result = 0;
 		for (auto iter = m_list_of_buffers.begin(); iter != m_list_of_buffers.end(); iter++)
 			result += iter->second.numberOfSamples();
+		for (auto iter = m_list_of_indexed_buffers.begin(); iter != m_list_of_indexed_buffers.end(); iter++)
+			result += iter->second.numberOfSamples();
+		for (auto iter = m_streamed_buffers.begin(); iter != m_streamed_buffers.end(); iter++)
+			result += iter->second.stats.samples;
 		return result;
 	}
 	bool Dataset::isLoaded(int i) const noexcept
 	{
 		std::lock_guard<std::mutex> lock(m_list_mutex);
-		return m_list_of_buffers.find(i) != m_list_of_buffers.end();
+		return m_list_of_buffers.find(i) != m_list_of_buffers.end() or m_list_of_indexed_buffers.find(i) != m_list_of_indexed_buffers.end()
+				or m_streamed_buffers.find(i) != m_streamed_buffers.end();
 	}
 	void Dataset::load(int i, const std::string &path)
 	{
 		if (not isLoaded(i))
 		{
-			GameDataBuffer loaded(path);
-			std::lock_guard<std::mutex> lock(m_list_mutex);
-			m_list_of_buffers.insert( { i, GameDataBuffer(std::move(loaded)) });
+			if (isStreaming())
+			{
+				if (IndexedDataset::isIndexedDataset(path))
+					throw std::logic_error("Dataset::load() : indexed file '" + path + "' cannot be streamed");
+				const GameDataBufferSummary summary = GameDataBuffer::loadSummary(path);
+				StreamedBuffer buffer;
+				buffer.path = path;
+				buffer.config = summary.config;
+				buffer.stats = summary.stats;
+				buffer.samples_per_game = summary.samples_per_game;
+				std::lock_guard<std::mutex> lock(m_list_mutex);
+				m_streamed_buffers.insert( { i, std::move(buffer) });
+			}
+			else if (IndexedDataset::isIndexedDataset(path))
+			{
+				IndexedDataset loaded(path);
+				std::lock_guard<std::mutex> lock(m_list_mutex);
+				m_list_of_indexed_buffers.insert( { i, std::move(loaded) });
+			}
+			else
+			{
+				GameDataBuffer loaded(path);
+				std::lock_guard<std::mutex> lock(m_list_mutex);
+				m_list_of_buffers.insert( { i, GameDataBuffer(std::move(loaded)) });
+			}
 		}
 	}
 	void Dataset::unload(int i)
@@ -62,12 +114,20 @@ namespace ag
 		{
 			std::lock_guard<std::mutex> lock(m_list_mutex);
 			m_list_of_buffers.erase(i);
+			m_list_of_indexed_buffers.erase(i);
+			m_list_of_caches.erase(i);
+			m_streamed_buffers.erase(i);
+			m_schedule.erase(std::remove(m_schedule.begin(), m_schedule.end(), i), m_schedule.end());
 		}
 	}
 	void Dataset::clear()
 	{
 		std::lock_guard<std::mutex> lock(m_list_mutex);
 		m_list_of_buffers.clear();
+		m_list_of_indexed_buffers.clear();
+		m_list_of_caches.clear();
+		m_streamed_buffers.clear();
+		m_schedule.clear();
 	}
 	const GameDataBuffer& Dataset::getBuffer(int i) const
 	{
@@ -84,8 +144,267 @@ namespace ag
 		std::vector<int> result;
 		for (auto iter = m_list_of_buffers.begin(); iter != m_list_of_buffers.end(); iter++)
 			result.push_back(iter->first);
+		for (auto iter = m_list_of_indexed_buffers.begin(); iter != m_list_of_indexed_buffers.end(); iter++)
+			result.push_back(iter->first);
+		for (auto iter = m_streamed_buffers.begin(); iter != m_streamed_buffers.end(); iter++)
+			result.push_back(iter->first);
+		std::sort(result.begin(), result.end());
 		return result;
 	}
 
-} /* namespace ag */
+	GameConfig Dataset::getConfig(int bufferIndex) const
+	{
+		const IndexedDataset *indexed = find_indexed_buffer(bufferIndex);
+		if (indexed != nullptr)
+			return indexed->getConfig();
+		{
+			std::lock_guard<std::mutex> lock(m_list_mutex);
+			auto iter = m_streamed_buffers.find(bufferIndex);
+			if (iter != m_streamed_buffers.end())
+				return iter->second.config;
+		}
+		return getBuffer(bufferIndex).getConfig();
+	}
+	int Dataset::numberOfGames(int bufferIndex) const
+	{
+		const IndexedDataset *indexed = find_indexed_buffer(bufferIndex);
+		if (indexed != nullptr)
+			return indexed->numberOfGames();
+		{
+			std::lock_guard<std::mutex> lock(m_list_mutex);
+			auto iter = m_streamed_buffers.find(bufferIndex);
+			if (iter != m_streamed_buffers.end())
+				return iter->second.stats.games;
+		}
+		return getBuffer(bufferIndex).numberOfGames();
+	}
+	int Dataset::numberOfSamples(int bufferIndex, int gameIndex) const
+	{
+		const IndexedDataset *indexed = find_indexed_buffer(bufferIndex);
+		if (indexed != nullptr)
+			return indexed->numberOfSamples(gameIndex);
+		{
+			std::lock_guard<std::mutex> lock(m_list_mutex);
+			auto iter = m_streamed_buffers.find(bufferIndex);
+			if (iter != m_streamed_buffers.end())
+				return iter->second.samples_per_game.at(gameIndex);
+		}
+		return getBuffer(bufferIndex).getGameData(gameIndex).numberOfSamples();
+	}
+	void Dataset::getSample(SearchDataPack &result, int bufferIndex, int gameIndex, int sampleIndex) const
+	{
+		const IndexedDataset *indexed = find_indexed_buffer(bufferIndex);
+		if (indexed != nullptr)
+		{
+			indexed->getSample(result, gameIndex, sampleIndex);
+			return;
+		}
+		const std::shared_ptr<const GameDataBuffer> streamed = get_streamed_buffer(bufferIndex);
+		if (streamed != nullptr)
+			streamed->getGameData(gameIndex).getSample(result, sampleIndex);
+		else
+			getBuffer(bufferIndex).getGameData(gameIndex).getSample(result, sampleIndex);
+	}
+
+	void Dataset::loadCache(int i, const std::string &path)
+	{
+		if (isStreaming())
+			throw std::logic_error("Dataset::loadCache() : sample cache cannot be used with streamed dataset");
+		if (not isLoaded(i))
+			throw std::logic_error("Dataset::loadCache() : buffer " + std::to_string(i) + " is not loaded");
+
+		SampleCache loaded(path);
+		if (not loaded.isCreatedFrom(*this, i))
+			throw std::runtime_error("Dataset::loadCache() : cache '" + path + "' was not created from buffer " + std::to_string(i));
+
+		std::lock_guard<std::mutex> lock(m_list_mutex);
+		m_list_of_caches.erase(i);
+		m_list_of_caches.insert( { i, std::move(loaded) });
+	}
+	bool Dataset::hasCache(int i) const noexcept
+	{
+		return getCache(i) != nullptr;
+	}
+	const SampleCache* Dataset::getCache(int i) const noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_list_mutex);
+		auto iter = m_list_of_caches.find(i);
+		return (iter == m_list_of_caches.end()) ? nullptr : &(iter->second);
+	}
 
+	void Dataset::setStreaming(int maxResidentSamples, int prefetchDepth)
+	{
+		if (maxResidentSamples < 0 or prefetchDepth < 0)
+			throw std::invalid_argument("Dataset::setStreaming() : limits must be non-negative");
+		std::lock_guard<std::mutex> lock(m_list_mutex);
+		const bool is_empty = m_list_of_buffers.empty() and m_list_of_indexed_buffers.empty() and m_streamed_buffers.empty();
+		if ((maxResidentSamples > 0) != (m_max_resident_samples > 0) and not is_empty)
+			throw std::logic_error("Dataset::setStreaming() : streaming mode can be changed only when the dataset is empty");
+		m_max_resident_samples = maxResidentSamples;
+		m_prefetch_depth = prefetchDepth;
+	}
+	bool Dataset::isStreaming() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_list_mutex);
+		return m_max_resident_samples > 0;
+	}
+	std::shared_ptr<const GameDataBuffer> Dataset::drawBuffer() const
+	{
+		std::unique_lock<std::mutex> lock(m_list_mutex);
+		if (m_max_resident_samples == 0)
+			throw std::logic_error("Dataset::drawBuffer() : streaming is disabled");
+		if (m_streamed_buffers.empty())
+			throw std::logic_error("Dataset::drawBuffer() : there are no buffers to draw from");
+
+		collect_loaded_buffers();
+		while (m_schedule.size() < static_cast<size_t>(1 + m_prefetch_depth))
+			m_schedule.push_back(draw_buffer_index());
+		const int index = m_schedule.front();
+		m_schedule.pop_front();
+		m_schedule.push_back(draw_buffer_index());
+		m_streaming_stats.draws++;
+
+		const StreamedBuffer &drawn = m_streamed_buffers.at(index);
+		if (drawn.data != nullptr)
+			m_streaming_stats.hits++;
+		else
+		{
+			if (drawn.loading.valid())
+				m_streaming_stats.prefetch_waits++;
+			else
+				m_streaming_stats.misses++;
+		}
+		const std::shared_ptr<const GameDataBuffer> result = acquire_buffer(lock, index);
+
+		for (auto scheduled = m_schedule.begin(); scheduled != m_schedule.end(); scheduled++)
+		{
+			StreamedBuffer &buffer = m_streamed_buffers.at(*scheduled);
+			if (buffer.data == nullptr and not buffer.loading.valid())
+				start_loading(buffer);
+		}
+		evict_buffers();
+		return result;
+	}
+	StreamingStats Dataset::getStreamingStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_list_mutex);
+		return m_streaming_stats;
+	}
+	/*
+	 * private
+	 */
+	const IndexedDataset* Dataset::find_indexed_buffer(int i) const
+	{
+		std::lock_guard<std::mutex> lock(m_list_mutex);
+		auto iter = m_list_of_indexed_buffers.find(i);
+		return (iter == m_list_of_indexed_buffers.end()) ? nullptr : &(iter->second);
+	}
+	std::shared_ptr<const GameDataBuffer> Dataset::get_streamed_buffer(int i) const
+	{
+		std::unique_lock<std::mutex> lock(m_list_mutex);
+		if (m_streamed_buffers.find(i) == m_streamed_buffers.end())
+			return nullptr;
+		const std::shared_ptr<const GameDataBuffer> result = acquire_buffer(lock, i);
+		evict_buffers();
+		return result;
+	}
+	std::shared_ptr<const GameDataBuffer> Dataset::acquire_buffer(std::unique_lock<std::mutex> &lock, int i) const
+	{ // the mutex must be locked, it is released while waiting for the buffer to load
+		std::shared_ptr<const GameDataBuffer> result = m_streamed_buffers.at(i).data;
+		if (result == nullptr)
+		{
+			StreamedBuffer &buffer = m_streamed_buffers.at(i);
+			if (not buffer.loading.valid())
+				start_loading(buffer);
+			const std::shared_future<std::shared_ptr<const GameDataBuffer>> loading = buffer.loading;
+
+			lock.unlock();
+			const double start = getTime();
+			loading.wait();
+			const double stop = getTime();
+			lock.lock();
+
+			m_streaming_stats.wait_time += stop - start;
+			result = loading.get();
+			auto iter = m_streamed_buffers.find(i);
+			if (iter != m_streamed_buffers.end() and iter->second.data == nullptr) // the buffer could have been unloaded while we were waiting
+				set_loaded(iter->second, result);
+		}
+
+		auto iter = m_streamed_buffers.find(i);
+		if (iter != m_streamed_buffers.end())
+			iter->second.last_used = ++m_usage_counter;
+		return result;
+	}
+	int Dataset::draw_buffer_index() const
+	{
+		assert(not m_streamed_buffers.empty());
+		std::vector<std::pair<int, double>> weights;
+		double sum = 0.0;
+		for (auto iter = m_streamed_buffers.begin(); iter != m_streamed_buffers.end(); iter++)
+		{
+			sum += iter->second.stats.samples;
+			weights.push_back( { iter->first, sum });
+		}
+		if (sum == 0.0)
+			throw std::logic_error("Dataset::drawBuffer() : all buffers are empty");
+
+		const double r = randDouble() * sum;
+		for (size_t i = 0; i < weights.size(); i++)
+			if (r < weights[i].second)
+				return weights[i].first;
+		return weights.back().first;
+	}
+	void Dataset::collect_loaded_buffers() const
+	{
+		for (auto iter = m_streamed_buffers.begin(); iter != m_streamed_buffers.end(); iter++)
+		{
+			StreamedBuffer &buffer = iter->second;
+			if (buffer.loading.valid() and buffer.loading.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+				set_loaded(buffer, buffer.loading.get());
+		}
+	}
+	void Dataset::start_loading(StreamedBuffer &buffer) const
+	{
+		const std::string path = buffer.path;
+		buffer.loading = std::async(std::launch::async, [path]()
+		{	return std::shared_ptr<const GameDataBuffer>(std::make_shared<GameDataBuffer>(path));}).share();
+		m_streaming_stats.loads++;
+	}
+	void Dataset::set_loaded(StreamedBuffer &buffer, const std::shared_ptr<const GameDataBuffer> &data) const
+	{
+		const GameDataBufferSummary summary = data->getSummary(); // the file could have changed since the summary was read
+		buffer.data = data;
+		buffer.config = summary.config;
+		buffer.stats = summary.stats;
+		buffer.samples_per_game = summary.samples_per_game;
+		buffer.loading = std::shared_future<std::shared_ptr<const GameDataBuffer>>(); // must be the last one as 'data' may refer to the result stored in this future
+	}
+	void Dataset::evict_buffers() const
+	{
+		uint64_t resident_samples = 0;
+		for (auto iter = m_streamed_buffers.begin(); iter != m_streamed_buffers.end(); iter++)
+			if (iter->second.data != nullptr)
+				resident_samples += iter->second.stats.samples;
+
+		while (resident_samples > static_cast<uint64_t>(m_max_resident_samples))
+		{
+			StreamedBuffer *least_recently_used = nullptr;
+			for (auto iter = m_streamed_buffers.begin(); iter != m_streamed_buffers.end(); iter++)
+			{
+				StreamedBuffer &buffer = iter->second;
+				const bool is_scheduled = std::find(m_schedule.begin(), m_schedule.end(), iter->first) != m_schedule.end();
+				const bool is_in_use = buffer.data.use_count() > 1;
+				if (buffer.data != nullptr and not is_scheduled and not is_in_use)
+					if (least_recently_used == nullptr or buffer.last_used < least_recently_used->last_used)
+						least_recently_used = &buffer;
+			}
+			if (least_recently_used == nullptr)
+				break;
+			resident_samples -= least_recently_used->stats.samples;
+			least_recently_used->data.reset();
+			m_streaming_stats.evictions++;
+		}
+	}
+
+} /* namespace ag */
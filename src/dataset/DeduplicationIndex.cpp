@@ -0,0 +1,114 @@
+/*
+ * DeduplicationIndex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/DeduplicationIndex.hpp>
+
+#include <cassert>
+
+namespace
+{
+	using namespace ag;
+
+	int get_outcome_index(GameOutcome outcome, Sign signToMove) noexcept
+	{
+		switch (outcome)
+		{
+			case GameOutcome::CROSS_WIN:
+				return (signToMove == Sign::CROSS) ? 0 : 2;
+			case GameOutcome::DRAW:
+				return 1;
+			case GameOutcome::CIRCLE_WIN:
+				return (signToMove == Sign::CIRCLE) ? 0 : 2;
+			default:
+				return 3;
+		}
+	}
+}
+
+namespace ag
+{
+	DeduplicationIndex::DeduplicationIndex(int rows, int cols) :
+			hashing(rows, cols)
+	{
+		for (int i = 0; i < 2; i++)
+			sign_keys[i].init();
+		for (int i = 0; i < 4; i++)
+			outcome_keys[i].init();
+	}
+	void DeduplicationIndex::clear() noexcept
+	{
+		entries.clear();
+		merged_samples.clear();
+	}
+	int DeduplicationIndex::size() const noexcept
+	{
+		return entries.size();
+	}
+	HashKey128 DeduplicationIndex::getKey(const SearchDataPack &sample) const noexcept
+	{
+		const Sign sign_to_move = sample.played_move.sign;
+		assert(sign_to_move == Sign::CROSS || sign_to_move == Sign::CIRCLE);
+		return hashing.getHash(sample.board) ^ sign_keys[static_cast<int>(sign_to_move) - 1]
+				^ outcome_keys[get_outcome_index(sample.game_outcome, sign_to_move)];
+	}
+	DeduplicationIndex::Entry* DeduplicationIndex::find(const HashKey128 &key) noexcept
+	{
+		const auto iter = entries.find(key);
+		return (iter == entries.end()) ? nullptr : &(iter->second);
+	}
+	void DeduplicationIndex::insert(const HashKey128 &key, int gameIndex, int sampleIndex)
+	{
+		Entry entry;
+		entry.game_index = gameIndex;
+		entry.sample_index = sampleIndex;
+		entries.insert( { key, entry });
+	}
+	SearchDataPack* DeduplicationIndex::findMerged(const HashKey128 &key) noexcept
+	{
+		const auto iter = merged_samples.find(key);
+		return (iter == merged_samples.end()) ? nullptr : &(iter->second);
+	}
+	SearchDataPack& DeduplicationIndex::storeMerged(const HashKey128 &key, const SearchDataPack &sample)
+	{
+		return merged_samples.insert( { key, sample }).first->second;
+	}
+
+	void mergeSamples(SearchDataPack &dst, int dstMultiplicity, const SearchDataPack &src)
+	{
+		assert(dst.board == src.board);
+		float dst_weight = 0.0f, src_weight = 0.0f;
+		for (int i = 0; i < dst.board.size(); i++)
+		{
+			dst_weight += dst.visit_count[i];
+			src_weight += src.visit_count[i];
+		}
+		if (dst_weight + src_weight == 0.0f)
+		{
+			dst_weight = dstMultiplicity;
+			src_weight = 1.0f;
+		}
+		const float inv = 1.0f / (dst_weight + src_weight);
+		for (int i = 0; i < dst.board.size(); i++)
+		{
+			const int dst_visits = dst.visit_count[i];
+			const int src_visits = src.visit_count[i];
+			if (dst_visits + src_visits > 0)
+			{
+				const float w = static_cast<float>(src_visits) / (dst_visits + src_visits);
+				dst.action_values[i] = Value((1.0f - w) * dst.action_values[i].win_rate + w * src.action_values[i].win_rate,
+						(1.0f - w) * dst.action_values[i].draw_rate + w * src.action_values[i].draw_rate);
+			}
+			dst.visit_count[i] = dst_visits + src_visits;
+			dst.policy_prior[i] = (dst.policy_prior[i] * dst_weight + src.policy_prior[i] * src_weight) * inv;
+			if (not dst.action_scores[i].isProven() and src.action_scores[i].isProven())
+				dst.action_scores[i] = src.action_scores[i];
+		}
+		if (not dst.minimax_score.isProven() and src.minimax_score.isProven())
+			dst.minimax_score = src.minimax_score;
+	}
+
+} /* namespace ag */
@@ -7,18 +7,37 @@
 
 #include <alphagomoku/dataset/GameDataBuffer.hpp>
 #include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/dataset/GameDataWriter.hpp>
+#include <alphagomoku/dataset/data_packs.hpp>
 #include <alphagomoku/utils/file_util.hpp>
 #include <alphagomoku/utils/misc.hpp>
 
 #include <minml/utils/json.hpp>
 #include <minml/utils/serialization.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <stdexcept>
 #include <iostream>
 
 namespace ag
 {
+	GameDataBufferStats::GameDataBufferStats(const Json &json) :
+			games(json["games"].getLong()),
+			samples(json["samples"].getLong()),
+			cross_win(json["cross_win"].getLong()),
+			draws(json["draws"].getLong()),
+			circle_win(json["circle_win"].getLong()),
+			game_length(json["game_length"].getLong()),
+			duplicates(json["duplicates"].getLong())
+	{
+	}
+	Json GameDataBufferStats::toJson() const
+	{
+		return Json( { { "games", games }, { "samples", samples }, { "cross_win", cross_win }, { "draws", draws }, { "circle_win", circle_win }, {
+				"game_length", game_length }, { "duplicates", duplicates } });
+	}
 	GameDataBufferStats& GameDataBufferStats::operator+=(const GameDataBufferStats &other) noexcept
 	{
 		this->games += other.games;
@@ -27,8 +46,29 @@ namespace ag
 		this->draws += other.draws;
 		this->circle_win += other.circle_win;
 		this->game_length += other.game_length;
+		this->duplicates += other.duplicates;
 		return *this;
 	}
+	void GameDataBufferStats::addGame(const GameDataStorage &game)
+	{
+		games++;
+		samples += game.numberOfSamples();
+		game_length += game.numberOfMoves();
+		switch (game.getOutcome())
+		{
+			default:
+				break;
+			case GameOutcome::CROSS_WIN:
+				cross_win++;
+				break;
+			case GameOutcome::DRAW:
+				draws++;
+				break;
+			case GameOutcome::CIRCLE_WIN:
+				circle_win++;
+				break;
+		}
+	}
 	std::string GameDataBufferStats::toString() const
 	{
 		std::string result;
@@ -39,6 +79,27 @@ namespace ag
 		result += "draws   = " + std::to_string(draws) + '\n';
 		result += "circle  = " + std::to_string(circle_win) + '\n';
 		result += "avg len = " + std::to_string((float) game_length / games) + '\n';
+		if (duplicates > 0)
+			result += "dedup   = " + std::to_string(100.0 * duplicates / (samples + duplicates)) + "% (" + std::to_string(duplicates) + " merged)\n";
+		return result;
+	}
+
+	GameDataBufferSummary::GameDataBufferSummary(const Json &json) :
+			config(json["config"]),
+			stats(json["stats"])
+	{
+		const Json &samples = json["samples"];
+		for (int i = 0; i < samples.size(); i++)
+			samples_per_game.push_back(samples[i].getInt());
+		if (samples_per_game.size() != stats.games)
+			throw std::runtime_error("GameDataBufferSummary() : number of games does not match the stats");
+	}
+	Json GameDataBufferSummary::toJson() const
+	{
+		Json result( { { "config", config.toJson() }, { "stats", stats.toJson() } });
+		result["samples"] = Json(JsonType::Array);
+		for (size_t i = 0; i < samples_per_game.size(); i++)
+			result["samples"][i] = samples_per_game[i];
 		return result;
 	}
 
@@ -57,6 +118,9 @@ namespace ag
 	void GameDataBuffer::clear() noexcept
 	{
 		buffer_data.clear();
+		merged_samples = 0;
+		deduplication_index.clear();
+		is_index_valid = false;
 	}
 	int GameDataBuffer::numberOfGames() const noexcept
 	{
@@ -71,11 +135,25 @@ namespace ag
 	}
 	void GameDataBuffer::append(const GameDataBuffer &other)
 	{
-		this->buffer_data.insert(this->buffer_data.end(), other.buffer_data.begin(), other.buffer_data.end());
+		if (is_deduplicating)
+		{
+			for (int i = 0; i < other.numberOfGames(); i++)
+				addGameData(other.getGameData(i));
+		}
+		else
+			this->buffer_data.insert(this->buffer_data.end(), other.buffer_data.begin(), other.buffer_data.end());
+		this->merged_samples += other.merged_samples;
 	}
 	void GameDataBuffer::addGameData(const GameDataStorage &game)
 	{
 		buffer_data.push_back(game);
+		if (is_deduplicating)
+		{
+			if (is_index_valid)
+				merge_duplicates(numberOfGames() - 1);
+			else
+				deduplicate(); // also builds the index
+		}
 	}
 	const GameDataStorage& GameDataBuffer::getGameData(int index) const
 	{
@@ -88,10 +166,79 @@ namespace ag
 	void GameDataBuffer::removeFromBuffer(int index)
 	{
 		buffer_data.erase(buffer_data.begin() + index);
+		is_index_valid = false;
 	}
 	void GameDataBuffer::removeRange(int from, int to)
 	{
 		buffer_data.erase(buffer_data.begin() + from, buffer_data.begin() + to);
+		is_index_valid = false;
+	}
+	int GameDataBuffer::deduplicate()
+	{
+		struct Duplicate
+		{
+				DeduplicationIndex::Entry *entry;
+				int game_index;
+				int sample_index;
+		};
+
+		deduplication_index = DeduplicationIndex(game_config.rows, game_config.cols);
+		is_index_valid = true;
+
+		SearchDataPack sample(game_config.rows, game_config.cols);
+		std::vector<std::vector<int>> kept_samples(numberOfGames()); // the index stores positions of samples after removal of duplicates
+		std::vector<Duplicate> duplicates;
+		for (int i = 0; i < numberOfGames(); i++)
+			for (int j = 0; j < buffer_data[i].numberOfSamples(); j++)
+			{
+				buffer_data[i].getSample(sample, j);
+				const HashKey128 key = deduplication_index.getKey(sample);
+				DeduplicationIndex::Entry *entry = deduplication_index.find(key);
+				if (entry == nullptr)
+				{
+					deduplication_index.insert(key, i, kept_samples[i].size());
+					kept_samples[i].push_back(j);
+				}
+				else
+				{
+					entry->multiplicity++;
+					duplicates.push_back(Duplicate { entry, i, j });
+				}
+			}
+
+		// all duplicates of a position are merged at full precision, so that the first occurrence is encoded again only once
+		std::stable_sort(duplicates.begin(), duplicates.end(), [](const Duplicate &lhs, const Duplicate &rhs)
+		{	return std::less<const DeduplicationIndex::Entry*>()(lhs.entry, rhs.entry);});
+		SearchDataPack merged(game_config.rows, game_config.cols);
+		for (size_t i = 0; i < duplicates.size();)
+		{
+			const DeduplicationIndex::Entry *entry = duplicates[i].entry;
+			GameDataStorage &first = buffer_data[entry->game_index];
+			const int first_index = kept_samples[entry->game_index][entry->sample_index];
+			first.getSample(merged, first_index);
+			for (int multiplicity = 1; i < duplicates.size() and duplicates[i].entry == entry; i++, multiplicity++)
+			{
+				buffer_data[duplicates[i].game_index].getSample(sample, duplicates[i].sample_index);
+				mergeSamples(merged, multiplicity, sample);
+			}
+			first.replaceSample(first_index, merged);
+		}
+
+		std::sort(duplicates.begin(), duplicates.end(), [](const Duplicate &lhs, const Duplicate &rhs)
+		{	return std::make_pair(lhs.game_index, lhs.sample_index) > std::make_pair(rhs.game_index, rhs.sample_index);});
+		for (size_t i = 0; i < duplicates.size(); i++)
+			buffer_data[duplicates[i].game_index].removeSample(duplicates[i].sample_index);
+		merged_samples += duplicates.size();
+		return duplicates.size();
+	}
+	void GameDataBuffer::setDeduplication(bool enabled)
+	{
+		is_deduplicating = enabled;
+		if (not enabled)
+		{
+			deduplication_index = DeduplicationIndex();
+			is_index_valid = false;
+		}
 	}
 	void GameDataBuffer::save(const std::string &path) const
 	{
@@ -99,6 +246,8 @@ namespace ag
 		json["format"] = 201;
 		json["config"] = game_config.toJson();
 		json["offsets"] = Json(JsonType::Array);
+		json["merged_samples"] = merged_samples;
+		json["summary"] = getSummary().toJson();
 		SerializedObject so;
 		Json &list_of_offsets = json["offsets"];
 		for (size_t i = 0; i < buffer_data.size(); i++)
@@ -112,6 +261,17 @@ namespace ag
 	}
 	void GameDataBuffer::load(const std::string &path)
 	{
+		if (GameDataWriter::isGameDataStream(path))
+		{
+			std::vector<GameDataStorage> games;
+			GameDataWriter::read(path, game_config, games);
+			buffer_data.insert(buffer_data.end(), games.begin(), games.end());
+			is_index_valid = false;
+			if (is_deduplicating)
+				deduplicate();
+			return;
+		}
+
 		FileLoader fl(path, true);
 
 		const int format = fl.getJson().hasKey("format") ? fl.getJson()["format"].getInt() : 100;
@@ -125,31 +285,86 @@ namespace ag
 			size_t offset = list_of_offsets[i].getLong();
 			buffer_data.push_back(GameDataStorage(fl.getBinaryData(), offset, format));
 		}
+		if (fl.getJson().hasKey("merged_samples"))
+			merged_samples += fl.getJson()["merged_samples"].getLong();
+		is_index_valid = false;
+		if (is_deduplicating)
+			deduplicate();
 	}
 	GameDataBufferStats GameDataBuffer::getStats() const noexcept
 	{
 		GameDataBufferStats stats;
-		stats.games = buffer_data.size();
+		stats.duplicates = merged_samples;
+		for (size_t i = 0; i < buffer_data.size(); i++)
+			stats.addGame(buffer_data[i]);
+		return stats;
+	}
+	GameDataBufferSummary GameDataBuffer::getSummary() const
+	{
+		GameDataBufferSummary result;
+		result.config = game_config;
+		result.stats = getStats();
 		for (size_t i = 0; i < buffer_data.size(); i++)
+			result.samples_per_game.push_back(buffer_data[i].numberOfSamples());
+		return result;
+	}
+	GameDataBufferSummary GameDataBuffer::loadSummary(const std::string &path)
+	{
+		GameDataBufferSummary result;
+		if (GameDataWriter::isGameDataStream(path))
+		{
+			if (GameDataWriter::readSummary(path, result))
+				return result;
+		}
+		else if (isChunkedFile(path))
+		{
+			const Json json = ChunkedFileReader(path).readJson();
+			if (json.hasKey("summary"))
+				return GameDataBufferSummary(json["summary"]);
+		}
+		return GameDataBuffer(path).getSummary();
+	}
+	/*
+	 * private
+	 */
+	int GameDataBuffer::merge_duplicates(int gameIndex)
+	{
+		GameDataStorage &game = buffer_data.at(gameIndex);
+		SearchDataPack sample(game_config.rows, game_config.cols);
+		SearchDataPack sample_copy(game_config.rows, game_config.cols);
+
+		std::vector<int> kept_samples; // samples of this game are removed only at the end, so the index stores their positions after removal
+		std::vector<int> removed_samples;
+		for (int i = 0; i < game.numberOfSamples(); i++)
 		{
-			stats.samples += buffer_data[i].numberOfSamples();
-			stats.game_length += buffer_data[i].numberOfMoves();
-			switch (buffer_data[i].getOutcome())
+			game.getSample(sample, i);
+			const HashKey128 key = deduplication_index.getKey(sample);
+			DeduplicationIndex::Entry *entry = deduplication_index.find(key);
+			if (entry == nullptr)
 			{
-				default:
-					break;
-				case GameOutcome::CROSS_WIN:
-					stats.cross_win++;
-					break;
-				case GameOutcome::DRAW:
-					stats.draws++;
-					break;
-				case GameOutcome::CIRCLE_WIN:
-					stats.circle_win++;
-					break;
+				deduplication_index.insert(key, gameIndex, kept_samples.size());
+				kept_samples.push_back(i);
+			}
+			else
+			{
+				GameDataStorage &first = buffer_data.at(entry->game_index);
+				const int first_index = (entry->game_index == gameIndex) ? kept_samples.at(entry->sample_index) : entry->sample_index;
+				SearchDataPack *merged = deduplication_index.findMerged(key);
+				if (merged == nullptr)
+				{
+					first.getSample(sample_copy, first_index);
+					merged = &deduplication_index.storeMerged(key, sample_copy);
+				}
+				mergeSamples(*merged, entry->multiplicity, sample);
+				first.replaceSample(first_index, *merged); // encoded from the full precision copy, so the rounding does not accumulate
+				entry->multiplicity++;
+				removed_samples.push_back(i);
 			}
 		}
-		return stats;
+		for (auto iter = removed_samples.rbegin(); iter < removed_samples.rend(); iter++)
+			game.removeSample(*iter);
+		merged_samples += removed_samples.size();
+		return removed_samples.size();
 	}
 
 } /* namespace ag */
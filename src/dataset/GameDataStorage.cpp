@@ -185,6 +185,42 @@ namespace ag
 		}
 
 	}
+	void GameDataStorage::replaceSample(int index, const SearchDataPack &sample)
+	{
+		switch (format)
+		{
+			case 100:
+				search_data.at(index).loadFrom(sample);
+				break;
+			case 200:
+				search_data_v2.at(index).loadFrom(sample);
+				break;
+			case 201:
+				search_data_v201.at(index).loadFrom(sample);
+				break;
+			default:
+				throw std::logic_error("GameDataStorage::replaceSample() unsupported format " + std::to_string(format));
+		}
+	}
+	void GameDataStorage::removeSample(int index)
+	{
+		if (index < 0 or index >= numberOfSamples())
+			throw std::out_of_range("GameDataStorage::removeSample() : index " + std::to_string(index) + " out of range");
+		switch (format)
+		{
+			case 100:
+				search_data.erase(search_data.begin() + index);
+				break;
+			case 200:
+				search_data_v2.erase(search_data_v2.begin() + index);
+				break;
+			case 201:
+				search_data_v201.erase(search_data_v201.begin() + index);
+				break;
+			default:
+				throw std::logic_error("GameDataStorage::removeSample() unsupported format " + std::to_string(format));
+		}
+	}
 	void GameDataStorage::addMove(Move move)
 	{
 		assert(move.sign == Sign::CROSS || move.sign == Sign::CIRCLE);
@@ -249,6 +285,19 @@ namespace ag
 		binary_data.save<int>(rows);
 		binary_data.save<int>(columns);
 	}
+	void GameDataStorage::serializeSample(SerializedObject &binary_data, int index) const
+	{
+		if (format == 201)
+			search_data_v201.at(index).serialize(binary_data);
+		else
+		{
+			SearchDataPack pack(rows, columns);
+			getSample(pack, index);
+			SearchDataStorage_v201 tmp;
+			tmp.loadFrom(pack);
+			tmp.serialize(binary_data);
+		}
+	}
 
 } /* namespace ag */
 
@@ -0,0 +1,396 @@
+/*
+ * GameDataWriter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/GameDataWriter.hpp>
+#include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/utils/file_util.hpp>
+
+#include <minml/utils/json.hpp>
+#include <minml/utils/ZipWrapper.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace
+{
+	using namespace ag;
+
+	const char stream_magic[8] = { 'A', 'G', '_', 'G', 'A', 'M', 'E', 'S' };
+	const char footer_magic[8] = { 'A', 'G', '_', 'I', 'N', 'D', 'E', 'X' };
+	const uint32_t stream_version = 1;
+	const uint32_t chunk_marker = 0x4B4E4843; // 'CHNK'
+	const uint32_t index_marker = 0x58444E49; // 'INDX'
+
+	struct StreamHeader
+	{
+			char magic[8];
+			uint32_t version;
+			uint32_t json_size; // header is followed by json with game config
+	};
+	struct ChunkHeader
+	{
+			uint32_t marker;
+			uint32_t number_of_games;
+			uint64_t compressed_size; // for the index it is the size of its entries
+			uint64_t uncompressed_size; // for the index it is the size of json summary that follows the entries (0 if there is none)
+	};
+	struct IndexEntry
+	{
+			uint64_t offset; // of the chunk header, from the beginning of the file
+			uint64_t number_of_games;
+	};
+	struct StreamFooter
+	{
+			uint64_t index_offset; // of the index header (which is a chunk header with index marker)
+			char magic[8];
+	};
+
+	/*
+	 * \brief Location of all complete chunks in the file.
+	 */
+	struct StreamLayout
+	{
+			GameConfig config;
+			std::vector<uint64_t> chunk_offsets;
+			std::vector<uint32_t> chunk_sizes;
+			uint64_t end_of_chunks = 0;
+			bool is_complete = false;
+			std::string summary; // empty if the file is not complete or was written without summary
+	};
+
+	template<typename T>
+	bool read_at(std::ifstream &stream, uint64_t offset, T &result)
+	{
+		stream.clear();
+		stream.seekg(offset);
+		stream.read(reinterpret_cast<char*>(&result), sizeof(T));
+		return stream.good();
+	}
+	uint64_t get_file_size(const std::string &path)
+	{
+		return std::filesystem::file_size(path);
+	}
+	std::ifstream open_stream(const std::string &path)
+	{
+		std::ifstream result(path, std::ios::in | std::ios::binary);
+		if (not result.is_open())
+			throw std::runtime_error("GameDataWriter : could not open file '" + path + "'");
+		return result;
+	}
+	bool read_index(std::ifstream &stream, uint64_t fileSize, uint64_t dataBegin, StreamLayout &result)
+	{
+		StreamFooter footer;
+		if (fileSize < dataBegin + sizeof(ChunkHeader) + sizeof(StreamFooter) or not read_at(stream, fileSize - sizeof(StreamFooter), footer))
+			return false;
+		if (std::memcmp(footer.magic, footer_magic, sizeof(footer_magic)) != 0 or footer.index_offset < dataBegin)
+			return false;
+
+		ChunkHeader header;
+		if (not read_at(stream, footer.index_offset, header) or header.marker != index_marker)
+			return false;
+		if (footer.index_offset + sizeof(ChunkHeader) + header.compressed_size + header.uncompressed_size + sizeof(StreamFooter) != fileSize)
+			return false;
+		std::vector<IndexEntry> entries(header.compressed_size / sizeof(IndexEntry));
+		stream.read(reinterpret_cast<char*>(entries.data()), sizeof(IndexEntry) * entries.size());
+		std::string summary(header.uncompressed_size, '\0');
+		stream.read(&summary[0], summary.size());
+		if (not stream.good())
+			return false;
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			result.chunk_offsets.push_back(entries[i].offset);
+			result.chunk_sizes.push_back(entries[i].number_of_games);
+		}
+		result.end_of_chunks = footer.index_offset;
+		result.is_complete = true;
+		result.summary = summary;
+		return true;
+	}
+	StreamLayout scan_stream(const std::string &path)
+	{
+		std::ifstream stream = open_stream(path);
+		const uint64_t file_size = get_file_size(path);
+
+		StreamHeader header;
+		if (not read_at(stream, 0, header) or std::memcmp(header.magic, stream_magic, sizeof(stream_magic)) != 0)
+			throw std::runtime_error("GameDataWriter : file '" + path + "' is not a stream of games");
+		if (header.version != stream_version)
+			throw std::runtime_error("GameDataWriter : unsupported version " + std::to_string(header.version) + " of file '" + path + "'");
+		std::string json_string(header.json_size, '\0');
+		stream.read(&json_string[0], json_string.size());
+		if (not stream.good())
+			throw std::runtime_error("GameDataWriter : header of file '" + path + "' is truncated");
+
+		StreamLayout result;
+		result.config = GameConfig(Json::load(json_string)["config"]);
+		const uint64_t data_begin = sizeof(StreamHeader) + header.json_size;
+		if (read_index(stream, file_size, data_begin, result))
+			return result;
+
+		// the file was not closed, so complete chunks must be found by following their headers
+		uint64_t offset = data_begin;
+		result.end_of_chunks = offset;
+		ChunkHeader chunk;
+		while (offset + sizeof(ChunkHeader) <= file_size and read_at(stream, offset, chunk))
+		{
+			if (chunk.marker != chunk_marker or offset + sizeof(ChunkHeader) + chunk.compressed_size > file_size)
+				break; // incomplete chunk or index, both are discarded
+			result.chunk_offsets.push_back(offset);
+			result.chunk_sizes.push_back(chunk.number_of_games);
+			offset += sizeof(ChunkHeader) + chunk.compressed_size;
+			result.end_of_chunks = offset;
+		}
+		return result;
+	}
+	void read_chunk(std::ifstream &stream, uint64_t offset, SerializedObject &result, const std::string &path)
+	{
+		ChunkHeader header;
+		if (not read_at(stream, offset, header) or header.marker != chunk_marker)
+			throw std::runtime_error("GameDataWriter : invalid chunk at " + std::to_string(offset) + " in file '" + path + "'");
+		std::vector<char> compressed(header.compressed_size);
+		stream.read(compressed.data(), compressed.size());
+		if (not stream.good())
+			throw std::runtime_error("GameDataWriter : chunk at " + std::to_string(offset) + " in file '" + path + "' is truncated");
+		const std::vector<char> data = ZipWrapper::uncompress(compressed);
+		if (data.size() != header.uncompressed_size)
+			throw std::runtime_error("GameDataWriter : chunk at " + std::to_string(offset) + " in file '" + path + "' is corrupted");
+		result = SerializedObject();
+		result.save(data.data(), data.size());
+	}
+	bool is_same_config(const GameConfig &lhs, const GameConfig &rhs) noexcept
+	{
+		return lhs.rules == rhs.rules and lhs.rows == rhs.rows and lhs.cols == rhs.cols;
+	}
+}
+
+namespace ag
+{
+	GameDataWriter::GameDataWriter(const std::string &path, const GameConfig &cfg, int gamesPerChunk) :
+			path(path),
+			game_config(cfg),
+			games_per_chunk(std::max(1, gamesPerChunk))
+	{
+		if (pathExists(path))
+		{
+			if (not isGameDataStream(path))
+				throw std::runtime_error("GameDataWriter() : file '" + path + "' already exists and is not a stream of games");
+			const StreamLayout layout = scan_stream(path);
+			if (not is_same_config(layout.config, cfg))
+				throw std::runtime_error("GameDataWriter() : file '" + path + "' contains games with different config");
+
+			std::vector<GameDataStorage> games;
+			read(path, game_config, games);
+			for (size_t i = 0; i < games.size(); i++)
+			{
+				stats.addGame(games[i]);
+				samples_per_game.push_back(games[i].numberOfSamples());
+			}
+			number_of_games = games.size();
+			chunk_offsets = layout.chunk_offsets;
+			chunk_sizes = layout.chunk_sizes;
+			file_size = layout.end_of_chunks;
+			std::filesystem::resize_file(path, file_size); // removes the footer or incomplete chunk, new chunks are appended after the last complete one
+			stream.open(path, std::ios::out | std::ios::binary | std::ios::app);
+		}
+		else
+		{
+			Json json(JsonType::Object);
+			json["format"] = 201;
+			json["config"] = game_config.toJson();
+			const std::string json_string = json.dump();
+
+			StreamHeader header;
+			std::memcpy(header.magic, stream_magic, sizeof(stream_magic));
+			header.version = stream_version;
+			header.json_size = json_string.size();
+
+			stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			stream.write(json_string.data(), json_string.size());
+			stream.flush();
+			file_size = sizeof(header) + json_string.size();
+		}
+		if (not stream.good())
+			throw std::runtime_error("GameDataWriter() : could not open file '" + path + "' for writing");
+		is_open = true;
+	}
+	GameDataWriter::~GameDataWriter()
+	{
+		try
+		{
+			flush(); // without the index, so that an interrupted writer does not leave the file looking complete
+		} catch (...)
+		{
+		}
+	}
+	void GameDataWriter::add(const GameDataStorage &game)
+	{
+		SerializedObject to_write;
+		std::vector<int> samples_to_write;
+		{
+			std::lock_guard<std::mutex> lock(pending_mutex);
+			if (not is_open)
+				throw std::logic_error("GameDataWriter::add() : writer of '" + path + "' is closed");
+			game.serialize(pending_games);
+			pending_samples.push_back(game.numberOfSamples());
+			number_of_games++;
+			stats.addGame(game);
+			if (static_cast<int>(pending_samples.size()) >= games_per_chunk)
+			{
+				std::swap(to_write, pending_games);
+				std::swap(samples_to_write, pending_samples);
+				chunks_in_flight++;
+			}
+		}
+		if (not samples_to_write.empty())
+			write_chunk(to_write, samples_to_write);
+	}
+	void GameDataWriter::flush()
+	{
+		SerializedObject to_write;
+		std::vector<int> samples_to_write;
+		{
+			std::lock_guard<std::mutex> lock(pending_mutex);
+			std::swap(to_write, pending_games);
+			std::swap(samples_to_write, pending_samples);
+			if (not samples_to_write.empty())
+				chunks_in_flight++;
+		}
+		if (not samples_to_write.empty())
+			write_chunk(to_write, samples_to_write);
+	}
+	void GameDataWriter::close()
+	{
+		{
+			std::lock_guard<std::mutex> lock(pending_mutex);
+			if (not is_open)
+				return;
+			is_open = false;
+		}
+		flush();
+		{ // chunks taken by 'add()' before the writer was closed must be written before the index
+			std::unique_lock<std::mutex> lock(pending_mutex);
+			chunk_written.wait(lock, [this]()
+			{	return chunks_in_flight == 0;});
+		}
+
+		GameDataBufferSummary summary;
+		summary.config = game_config;
+		summary.stats = getStats();
+
+		std::lock_guard<std::mutex> lock(file_mutex);
+		summary.samples_per_game = samples_per_game;
+		const std::string summary_string = summary.toJson().dump();
+		std::vector<IndexEntry> entries(chunk_offsets.size());
+		for (size_t i = 0; i < entries.size(); i++)
+			entries[i] = IndexEntry { chunk_offsets[i], chunk_sizes[i] };
+		ChunkHeader header { index_marker, static_cast<uint32_t>(number_of_games), sizeof(IndexEntry) * entries.size(), summary_string.size() };
+		StreamFooter footer;
+		footer.index_offset = file_size;
+		std::memcpy(footer.magic, footer_magic, sizeof(footer_magic));
+
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		stream.write(reinterpret_cast<const char*>(entries.data()), sizeof(IndexEntry) * entries.size());
+		stream.write(summary_string.data(), summary_string.size());
+		stream.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+		stream.close();
+		if (stream.fail())
+			throw std::runtime_error("GameDataWriter::close() : could not write index to file '" + path + "'");
+	}
+	bool GameDataWriter::isOpen() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(pending_mutex);
+		return is_open;
+	}
+	const std::string& GameDataWriter::getPath() const noexcept
+	{
+		return path;
+	}
+	int GameDataWriter::numberOfGames() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(pending_mutex);
+		return number_of_games;
+	}
+	GameDataBufferStats GameDataWriter::getStats() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(pending_mutex);
+		return stats;
+	}
+	bool GameDataWriter::isGameDataStream(const std::string &path)
+	{
+		std::ifstream stream(path, std::ios::in | std::ios::binary);
+		char magic[sizeof(stream_magic)];
+		stream.read(magic, sizeof(magic));
+		return stream.good() and std::memcmp(magic, stream_magic, sizeof(stream_magic)) == 0;
+	}
+	bool GameDataWriter::isComplete(const std::string &path)
+	{
+		return scan_stream(path).is_complete;
+	}
+	bool GameDataWriter::readSummary(const std::string &path, GameDataBufferSummary &result)
+	{
+		const StreamLayout layout = scan_stream(path);
+		if (layout.summary.empty())
+			return false;
+		result = GameDataBufferSummary(Json::load(layout.summary));
+		return true;
+	}
+	void GameDataWriter::read(const std::string &path, GameConfig &config, std::vector<GameDataStorage> &games)
+	{
+		const StreamLayout layout = scan_stream(path);
+		config = layout.config;
+
+		std::ifstream stream = open_stream(path);
+		SerializedObject data;
+		for (size_t i = 0; i < layout.chunk_offsets.size(); i++)
+		{
+			read_chunk(stream, layout.chunk_offsets[i], data, path);
+			size_t offset = 0;
+			for (uint32_t j = 0; j < layout.chunk_sizes[i]; j++)
+				games.push_back(GameDataStorage(data, offset, 201));
+		}
+	}
+	/*
+	 * private
+	 */
+	void GameDataWriter::write_chunk(const SerializedObject &games, const std::vector<int> &samples)
+	{
+		auto finish = [this]()
+		{
+			{
+				std::lock_guard<std::mutex> lock(pending_mutex);
+				chunks_in_flight--;
+			}
+			chunk_written.notify_all();
+		};
+		try
+		{
+			const std::vector<char> compressed = ZipWrapper::compress(
+					std::vector<char>(reinterpret_cast<const char*>(games.data()), reinterpret_cast<const char*>(games.data()) + games.size()));
+			const ChunkHeader header { chunk_marker, static_cast<uint32_t>(samples.size()), compressed.size(), games.size() };
+
+			std::lock_guard<std::mutex> lock(file_mutex);
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			stream.write(compressed.data(), compressed.size());
+			stream.flush(); // so that readers can see complete chunk
+			if (not stream.good())
+				throw std::runtime_error("GameDataWriter : could not write chunk to file '" + path + "'");
+			chunk_offsets.push_back(file_size);
+			chunk_sizes.push_back(samples.size());
+			samples_per_game.insert(samples_per_game.end(), samples.begin(), samples.end());
+			file_size += sizeof(header) + compressed.size();
+		} catch (...)
+		{
+			finish();
+			throw;
+		}
+		finish();
+	}
+
+} /* namespace ag */
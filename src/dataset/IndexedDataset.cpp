@@ -0,0 +1,266 @@
+/*
+ * IndexedDataset.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/IndexedDataset.hpp>
+#include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/dataset/SearchDataStorage.hpp>
+#include <alphagomoku/dataset/data_packs.hpp>
+#include <alphagomoku/game/Board.hpp>
+
+#include <minml/utils/json.hpp>
+#include <minml/utils/serialization.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+	using namespace ag;
+
+	const char magic_string[8] = { 'A', 'G', '_', 'I', 'N', 'D', 'E', 'X' };
+	const uint32_t current_version = 1;
+
+	struct FileHeader
+	{
+			char magic[8];
+			uint32_t version;
+			uint32_t config_size;
+			uint64_t games;
+			uint64_t samples;
+			uint64_t data_offset;
+	};
+	struct GameIndexEntry
+	{
+			uint64_t offset;
+			uint32_t first_sample;
+			uint32_t samples;
+	};
+
+	template<typename T>
+	T read(const uint8_t *ptr, size_t offset) noexcept
+	{
+		T result;
+		std::memcpy(&result, ptr + offset, sizeof(T));
+		return result;
+	}
+	template<typename T>
+	void write(std::ofstream &stream, const T &value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+	size_t align_to_8(size_t x) noexcept
+	{
+		return (x + 7) & ~static_cast<size_t>(7);
+	}
+}
+
+namespace ag
+{
+	IndexedDataset::IndexedDataset(const std::string &path) :
+			file(path)
+	{
+		const uint8_t *ptr = reinterpret_cast<const uint8_t*>(file.data());
+		if (file.size() < sizeof(FileHeader))
+			throw std::runtime_error("IndexedDataset() : file '" + path + "' is too small");
+		const FileHeader header = read<FileHeader>(ptr, 0);
+		if (std::memcmp(header.magic, magic_string, sizeof(magic_string)) != 0)
+			throw std::runtime_error("IndexedDataset() : file '" + path + "' is not an indexed dataset");
+		if (header.version != current_version)
+			throw std::runtime_error("IndexedDataset() : unsupported version " + std::to_string(header.version) + " in file '" + path + "'");
+
+		if (header.config_size > file.size() or header.games > file.size() / sizeof(GameIndexEntry) or header.samples > file.size() / sizeof(uint64_t))
+			throw std::runtime_error("IndexedDataset() : file '" + path + "' is corrupted");
+		const size_t game_index_offset = align_to_8(sizeof(FileHeader) + header.config_size);
+		const size_t sample_index_offset = game_index_offset + sizeof(GameIndexEntry) * header.games;
+		if (sample_index_offset + sizeof(uint64_t) * header.samples > header.data_offset or header.data_offset > file.size())
+			throw std::runtime_error("IndexedDataset() : file '" + path + "' is corrupted");
+
+		game_config = GameConfig(Json::load(std::string(reinterpret_cast<const char*>(ptr) + sizeof(FileHeader), header.config_size)));
+		game_index = ptr + game_index_offset;
+		sample_index = ptr + sample_index_offset;
+		data_section = ptr + header.data_offset;
+		data_size = file.size() - header.data_offset;
+		number_of_games = header.games;
+		number_of_samples = header.samples;
+		validate_index(path);
+	}
+	const GameConfig& IndexedDataset::getConfig() const noexcept
+	{
+		return game_config;
+	}
+	int IndexedDataset::numberOfGames() const noexcept
+	{
+		return number_of_games;
+	}
+	int IndexedDataset::numberOfSamples() const noexcept
+	{
+		return number_of_samples;
+	}
+	int IndexedDataset::numberOfSamples(int gameIndex) const
+	{
+		if (gameIndex < 0 or gameIndex >= number_of_games)
+			throw std::out_of_range("IndexedDataset::numberOfSamples() : game index " + std::to_string(gameIndex) + " out of range");
+		return read<GameIndexEntry>(game_index, sizeof(GameIndexEntry) * gameIndex).samples;
+	}
+	int IndexedDataset::numberOfMoves(int gameIndex) const
+	{
+		if (gameIndex < 0 or gameIndex >= number_of_games)
+			throw std::out_of_range("IndexedDataset::numberOfMoves() : game index " + std::to_string(gameIndex) + " out of range");
+		const GameIndexEntry entry = read<GameIndexEntry>(game_index, sizeof(GameIndexEntry) * gameIndex);
+		return read<uint32_t>(data_section, entry.offset + sizeof(int32_t));
+	}
+	GameOutcome IndexedDataset::getOutcome(int gameIndex) const
+	{
+		if (gameIndex < 0 or gameIndex >= number_of_games)
+			throw std::out_of_range("IndexedDataset::getOutcome() : game index " + std::to_string(gameIndex) + " out of range");
+		const GameIndexEntry entry = read<GameIndexEntry>(game_index, sizeof(GameIndexEntry) * gameIndex);
+		return static_cast<GameOutcome>(read<int32_t>(data_section, entry.offset));
+	}
+	void IndexedDataset::getSample(SearchDataPack &result, int gameIndex, int sampleIndex) const
+	{
+		if (gameIndex < 0 or gameIndex >= number_of_games)
+			throw std::out_of_range("IndexedDataset::getSample() : game index " + std::to_string(gameIndex) + " out of range");
+		const GameIndexEntry entry = read<GameIndexEntry>(game_index, sizeof(GameIndexEntry) * gameIndex);
+		if (sampleIndex < 0 or sampleIndex >= static_cast<int>(entry.samples))
+			throw std::out_of_range("IndexedDataset::getSample() : sample index " + std::to_string(sampleIndex) + " out of range");
+
+		result.clear();
+		const size_t global_index = entry.first_sample + sampleIndex;
+		const size_t offset = read<uint64_t>(sample_index, sizeof(uint64_t) * global_index);
+		const size_t end = (global_index + 1 < static_cast<size_t>(number_of_samples)) ? read<uint64_t>(sample_index, sizeof(uint64_t) * (global_index + 1)) : data_size;
+		const int move_number = SearchDataStorage_v201::storeTo(result, data_section + offset, end - offset);
+
+		const GameOutcome outcome = static_cast<GameOutcome>(read<int32_t>(data_section, entry.offset));
+		const int number_of_moves = read<uint32_t>(data_section, entry.offset + sizeof(int32_t));
+		const uint8_t *moves = data_section + entry.offset + sizeof(int32_t) + sizeof(uint32_t);
+
+		if (move_number >= number_of_moves)
+			throw std::runtime_error("IndexedDataset::getSample() : move number " + std::to_string(move_number) + " of sample is out of range");
+		result.played_move = Move(read<uint16_t>(moves, sizeof(uint16_t) * move_number));
+		for (int i = 0; i < move_number; i++)
+			Board::putMove(result.board, Move(read<uint16_t>(moves, sizeof(uint16_t) * i)));
+		result.moves_left = number_of_moves - move_number;
+		result.game_outcome = outcome;
+	}
+	GameDataBufferStats IndexedDataset::getStats() const
+	{
+		GameDataBufferStats stats;
+		stats.games = number_of_games;
+		stats.samples = number_of_samples;
+		for (int i = 0; i < number_of_games; i++)
+		{
+			stats.game_length += numberOfMoves(i);
+			switch (getOutcome(i))
+			{
+				default:
+					break;
+				case GameOutcome::CROSS_WIN:
+					stats.cross_win++;
+					break;
+				case GameOutcome::DRAW:
+					stats.draws++;
+					break;
+				case GameOutcome::CIRCLE_WIN:
+					stats.circle_win++;
+					break;
+			}
+		}
+		return stats;
+	}
+	bool IndexedDataset::isIndexedDataset(const std::string &path)
+	{
+		std::ifstream stream(path, std::ios::in | std::ios::binary);
+		char magic[sizeof(magic_string)];
+		if (not stream.read(magic, sizeof(magic)))
+			return false;
+		return std::memcmp(magic, magic_string, sizeof(magic_string)) == 0;
+	}
+	void IndexedDataset::save(const GameDataBuffer &buffer, const std::string &path)
+	{
+		std::vector<GameIndexEntry> games;
+		std::vector<uint64_t> samples;
+		SerializedObject data;
+		for (int i = 0; i < buffer.numberOfGames(); i++)
+		{
+			const GameDataStorage &game = buffer.getGameData(i);
+			games.push_back(GameIndexEntry { data.size(), static_cast<uint32_t>(samples.size()), static_cast<uint32_t>(game.numberOfSamples()) });
+			data.save<int32_t>(static_cast<int32_t>(game.getOutcome()));
+			data.save<uint32_t>(game.numberOfMoves());
+			for (int j = 0; j < game.numberOfMoves(); j++)
+				data.save<uint16_t>(game.getMove(j).toShort());
+
+			for (int j = 0; j < game.numberOfSamples(); j++)
+			{
+				samples.push_back(data.size());
+				game.serializeSample(data, j);
+			}
+		}
+
+		const std::string config = buffer.getConfig().toJson().dump();
+		const size_t game_index_offset = align_to_8(sizeof(FileHeader) + config.size());
+
+		FileHeader header;
+		std::memcpy(header.magic, magic_string, sizeof(magic_string));
+		header.version = current_version;
+		header.config_size = config.size();
+		header.games = games.size();
+		header.samples = samples.size();
+		header.data_offset = align_to_8(game_index_offset + sizeof(GameIndexEntry) * games.size() + sizeof(uint64_t) * samples.size());
+
+		std::ofstream stream(path, std::ios::out | std::ios::binary);
+		if (not stream.is_open())
+			throw std::runtime_error("IndexedDataset::save() : could not open file '" + path + "'");
+		write(stream, header);
+		stream.write(config.data(), config.size());
+		stream.write(magic_string, game_index_offset - sizeof(FileHeader) - config.size()); // padding, its content is irrelevant
+		stream.write(reinterpret_cast<const char*>(games.data()), sizeof(GameIndexEntry) * games.size());
+		stream.write(reinterpret_cast<const char*>(samples.data()), sizeof(uint64_t) * samples.size());
+		stream.write(magic_string, header.data_offset - (game_index_offset + sizeof(GameIndexEntry) * games.size() + sizeof(uint64_t) * samples.size()));
+		stream.write(reinterpret_cast<const char*>(data.data()), data.size());
+		if (not stream.good())
+			throw std::runtime_error("IndexedDataset::save() : could not write to file '" + path + "'");
+	}
+	void IndexedDataset::convert(const std::string &srcPath, const std::string &dstPath)
+	{
+		const GameDataBuffer buffer(srcPath);
+		save(buffer, dstPath);
+	}
+	/*
+	 * private
+	 */
+	void IndexedDataset::validate_index(const std::string &path) const
+	{
+		// games are stored one after another, each game record followed by its samples (see save())
+		size_t expected_first_sample = 0;
+		size_t end_of_previous = 0;
+		for (int i = 0; i < number_of_games; i++)
+		{
+			const GameIndexEntry entry = read<GameIndexEntry>(game_index, sizeof(GameIndexEntry) * i);
+			if (entry.first_sample != expected_first_sample or entry.samples > static_cast<size_t>(number_of_samples) - expected_first_sample)
+				throw std::runtime_error("IndexedDataset() : invalid samples of game " + std::to_string(i) + " in file '" + path + "'");
+			if (entry.offset < end_of_previous or entry.offset > data_size or data_size - entry.offset < sizeof(int32_t) + sizeof(uint32_t))
+				throw std::runtime_error("IndexedDataset() : invalid offset of game " + std::to_string(i) + " in file '" + path + "'");
+			const size_t number_of_moves = read<uint32_t>(data_section, entry.offset + sizeof(int32_t));
+			if (number_of_moves > (data_size - entry.offset - sizeof(int32_t) - sizeof(uint32_t)) / sizeof(uint16_t))
+				throw std::runtime_error("IndexedDataset() : moves of game " + std::to_string(i) + " do not fit in file '" + path + "'");
+			end_of_previous = entry.offset + sizeof(int32_t) + sizeof(uint32_t) + sizeof(uint16_t) * number_of_moves;
+
+			for (uint32_t j = 0; j < entry.samples; j++)
+			{
+				const size_t offset = read<uint64_t>(sample_index, sizeof(uint64_t) * (entry.first_sample + j));
+				if (offset < end_of_previous or offset >= data_size)
+					throw std::runtime_error("IndexedDataset() : invalid offset of sample " + std::to_string(j) + " of game " + std::to_string(i) + " in file '" + path + "'");
+				end_of_previous = offset + 1; // the exact size is checked when the sample is read
+			}
+			expected_first_sample += entry.samples;
+		}
+		if (expected_first_sample != static_cast<size_t>(number_of_samples))
+			throw std::runtime_error("IndexedDataset() : games contain " + std::to_string(expected_first_sample) + " samples instead of " + std::to_string(number_of_samples) + " in file '" + path + "'");
+	}
+
+} /* namespace ag */
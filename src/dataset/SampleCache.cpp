@@ -0,0 +1,385 @@
+/*
+ * SampleCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/SampleCache.hpp>
+#include <alphagomoku/dataset/Dataset.hpp>
+#include <alphagomoku/dataset/Sampler.hpp>
+#include <alphagomoku/dataset/data_packs.hpp>
+#include <alphagomoku/networks/NNInputFeatures.hpp>
+#include <alphagomoku/patterns/PatternCalculator.hpp>
+
+#include <minml/utils/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+	using namespace ag;
+
+	const char magic_string[8] = { 'A', 'G', '_', 'C', 'A', 'C', 'H', 'E' };
+	const uint32_t current_version = 1; // must be increased whenever the layout of records or preparation of targets changes
+
+	struct FileHeader
+	{
+			char magic[8];
+			uint32_t version;
+			uint32_t json_size;
+			uint64_t encoder_hash;
+			uint64_t games;
+			uint64_t samples;
+			uint64_t record_size;
+			uint64_t data_offset;
+	};
+	struct GameIndexEntry
+	{
+			uint32_t first_sample;
+			uint32_t samples;
+	};
+	struct RecordHeader
+	{
+			float value_win;
+			float value_draw;
+			float minimax_win;
+			float minimax_draw;
+			float moves_left;
+			int32_t sign_to_move;
+	};
+
+	template<typename T>
+	T read(const uint8_t *ptr, size_t offset) noexcept
+	{
+		T result;
+		std::memcpy(&result, ptr + offset, sizeof(T));
+		return result;
+	}
+	template<typename T>
+	void write(std::ofstream &stream, const T &value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+	size_t align_to_8(size_t x) noexcept
+	{
+		return (x + 7) & ~static_cast<size_t>(7);
+	}
+	size_t get_record_size(const GameConfig &cfg) noexcept
+	{ // features, policy, visit count and two components of action value for each spot
+		return sizeof(RecordHeader) + cfg.rows * cfg.cols * (sizeof(uint32_t) + 4 * sizeof(uint16_t));
+	}
+	uint16_t quantize(float x) noexcept
+	{
+		return static_cast<uint16_t>(std::round(std::max(0.0f, std::min(1.0f, x)) * 65535.0f));
+	}
+	float dequantize(uint16_t x) noexcept
+	{
+		return x / 65535.0f;
+	}
+	bool is_same_config(const GameConfig &lhs, const GameConfig &rhs) noexcept
+	{
+		return lhs.rules == rhs.rules and lhs.rows == rhs.rows and lhs.cols == rhs.cols;
+	}
+
+	void encode_record(uint8_t *dst, const NNInputFeatures &features, const TrainingDataPack &sample)
+	{
+		const int size = features.size();
+		const RecordHeader header { sample.value_target.win_rate, sample.value_target.draw_rate, sample.minimax_target.win_rate,
+				sample.minimax_target.draw_rate, sample.moves_left, static_cast<int32_t>(sample.sign_to_move) };
+		std::memcpy(dst, &header, sizeof(RecordHeader));
+		std::memcpy(dst + sizeof(RecordHeader), features.data(), sizeof(uint32_t) * size);
+
+		uint16_t *policy = reinterpret_cast<uint16_t*>(dst + sizeof(RecordHeader) + sizeof(uint32_t) * size);
+		uint16_t *visits = policy + size;
+		uint16_t *action_values = visits + size;
+		for (int i = 0; i < size; i++)
+		{
+			policy[i] = quantize(sample.policy_target[i]);
+			visits[i] = std::min(65535, sample.visit_count[i]); // only the proportions of visits are used for training
+			action_values[2 * i + 0] = quantize(sample.action_values_target[i].win_rate);
+			action_values[2 * i + 1] = quantize(sample.action_values_target[i].draw_rate);
+		}
+	}
+	/*
+	 * \brief Returns true if the position is the one in the calculator after given move, so that its features can be updated instead of encoded again.
+	 */
+	bool is_followed_by(const PatternCalculator &calc, Move move, const matrix<Sign> &board, Sign signToMove) noexcept
+	{
+		if (move.sign != calc.getSignToMove() or signToMove != invertSign(move.sign) or calc.signAt(move.row, move.col) != Sign::NONE
+				or board.at(move.row, move.col) != move.sign)
+			return false;
+		for (int row = 0; row < board.rows(); row++)
+			for (int col = 0; col < board.cols(); col++)
+				if (board.at(row, col) != calc.signAt(row, col) and (row != move.row or col != move.col))
+					return false;
+		return true;
+	}
+	uint64_t hash_words(uint64_t hash, const uint32_t *data, size_t size) noexcept
+	{ // FNV-1a applied to 32-bit words
+		for (size_t i = 0; i < size; i++)
+			hash = (hash ^ data[i]) * 1099511628211ull;
+		return hash;
+	}
+}
+
+namespace ag
+{
+	SampleCache::SampleCache(const std::string &path) :
+			file(path)
+	{
+		const uint8_t *ptr = reinterpret_cast<const uint8_t*>(file.data());
+		if (file.size() < sizeof(FileHeader))
+			throw std::runtime_error("SampleCache() : file '" + path + "' is too small");
+		const FileHeader header = read<FileHeader>(ptr, 0);
+		if (std::memcmp(header.magic, magic_string, sizeof(magic_string)) != 0)
+			throw std::runtime_error("SampleCache() : file '" + path + "' is not a sample cache");
+		if (header.version != current_version)
+			throw std::runtime_error("SampleCache() : unsupported version " + std::to_string(header.version) + " in file '" + path + "'");
+
+		const size_t game_index_offset = align_to_8(sizeof(FileHeader) + header.json_size);
+		if (header.json_size > file.size() or header.data_offset > file.size() or game_index_offset > header.data_offset
+				or header.games > (header.data_offset - game_index_offset) / sizeof(GameIndexEntry) or header.samples > std::numeric_limits<int>::max())
+			throw std::runtime_error("SampleCache() : file '" + path + "' is corrupted");
+
+		const Json json = Json::load(std::string(reinterpret_cast<const char*>(ptr) + sizeof(FileHeader), header.json_size));
+		game_config = GameConfig(json["config"]);
+		sampler_type = json["sampler_type"].getString();
+		if (header.record_size != get_record_size(game_config))
+			throw std::runtime_error("SampleCache() : size of records in file '" + path + "' does not match the game config");
+		if (header.samples > (file.size() - header.data_offset) / header.record_size)
+			throw std::runtime_error("SampleCache() : file '" + path + "' is corrupted");
+
+		for (uint64_t i = 0; i < header.games; i++)
+		{ // samples of each game must be within the data section, so that they can be later accessed without checks
+			const GameIndexEntry entry = read<GameIndexEntry>(ptr, game_index_offset + sizeof(GameIndexEntry) * i);
+			if (static_cast<uint64_t>(entry.first_sample) + entry.samples > header.samples)
+				throw std::runtime_error("SampleCache() : game " + std::to_string(i) + " in file '" + path + "' is outside of the data section");
+		}
+
+		encoder_hash = header.encoder_hash;
+		game_index = ptr + game_index_offset;
+		data_section = ptr + header.data_offset;
+		number_of_games = header.games;
+		number_of_samples = header.samples;
+		record_size = header.record_size;
+	}
+	const GameConfig& SampleCache::getConfig() const noexcept
+	{
+		return game_config;
+	}
+	const std::string& SampleCache::getSamplerType() const noexcept
+	{
+		return sampler_type;
+	}
+	uint64_t SampleCache::getEncoderHash() const noexcept
+	{
+		return encoder_hash;
+	}
+	int SampleCache::numberOfGames() const noexcept
+	{
+		return number_of_games;
+	}
+	int SampleCache::numberOfSamples() const noexcept
+	{
+		return number_of_samples;
+	}
+	int SampleCache::numberOfSamples(int gameIndex) const
+	{
+		if (gameIndex < 0 or gameIndex >= number_of_games)
+			throw std::out_of_range("SampleCache::numberOfSamples() : game index " + std::to_string(gameIndex) + " out of range");
+		return read<GameIndexEntry>(game_index, sizeof(GameIndexEntry) * gameIndex).samples;
+	}
+	void SampleCache::getSample(NNInputFeatures &features, TrainingDataPack &result, int gameIndex, int sampleIndex) const
+	{
+		if (gameIndex < 0 or gameIndex >= number_of_games)
+			throw std::out_of_range("SampleCache::getSample() : game index " + std::to_string(gameIndex) + " out of range");
+		const GameIndexEntry entry = read<GameIndexEntry>(game_index, sizeof(GameIndexEntry) * gameIndex);
+		if (sampleIndex < 0 or sampleIndex >= static_cast<int>(entry.samples))
+			throw std::out_of_range("SampleCache::getSample() : sample index " + std::to_string(sampleIndex) + " out of range");
+
+		const int rows = game_config.rows;
+		const int cols = game_config.cols;
+		if (features.rows() != rows or features.cols() != cols)
+			features = NNInputFeatures(rows, cols);
+		if (result.board.rows() != rows or result.board.cols() != cols)
+			result = TrainingDataPack(rows, cols);
+
+		const uint8_t *record = data_section + record_size * (entry.first_sample + sampleIndex);
+		const RecordHeader header = read<RecordHeader>(record, 0);
+		result.board.clear();
+		result.value_target = Value(header.value_win, header.value_draw);
+		result.minimax_target = Value(header.minimax_win, header.minimax_draw);
+		result.moves_left = header.moves_left;
+		result.sign_to_move = static_cast<Sign>(header.sign_to_move);
+		result.last_move = Move();
+
+		const int size = rows * cols;
+		std::memcpy(features.data(), record + sizeof(RecordHeader), sizeof(uint32_t) * size);
+		const uint8_t *policy = record + sizeof(RecordHeader) + sizeof(uint32_t) * size;
+		const uint8_t *visits = policy + sizeof(uint16_t) * size;
+		const uint8_t *action_values = visits + sizeof(uint16_t) * size;
+		float sum_policy = 0.0f;
+		for (int i = 0; i < size; i++)
+		{
+			result.policy_target[i] = dequantize(read<uint16_t>(policy, sizeof(uint16_t) * i));
+			sum_policy += result.policy_target[i];
+			result.visit_count[i] = read<uint16_t>(visits, sizeof(uint16_t) * i);
+			result.action_values_target[i] = Value(dequantize(read<uint16_t>(action_values, sizeof(uint16_t) * (2 * i + 0))),
+					dequantize(read<uint16_t>(action_values, sizeof(uint16_t) * (2 * i + 1))));
+		}
+		if (sum_policy > 0.0f)
+			for (int i = 0; i < size; i++)
+				result.policy_target[i] /= sum_policy; // removes the error of quantization from the sum
+	}
+
+	bool SampleCache::isCreatedFrom(const Dataset &dataset, int bufferIndex) const
+	{
+		const GameConfig cfg = dataset.getConfig(bufferIndex);
+		if (not is_same_config(game_config, cfg) or number_of_games != dataset.numberOfGames(bufferIndex))
+			return false;
+		int samples = 0;
+		for (int i = 0; i < number_of_games; i++)
+		{
+			if (numberOfSamples(i) != dataset.numberOfSamples(bufferIndex, i))
+				return false;
+			samples += numberOfSamples(i);
+		}
+		return samples == number_of_samples;
+	}
+
+	uint64_t SampleCache::getEncoderHash(const GameConfig &cfg)
+	{
+		const int number_of_positions = 8;
+		const int stones_per_position = std::min(6, cfg.rows * cfg.cols / (2 * number_of_positions));
+
+		PatternCalculator calc(cfg);
+		NNInputFeatures features(cfg.rows, cfg.cols);
+		matrix<Sign> board(cfg.rows, cfg.cols);
+		uint64_t state = 0x9E3779B97F4A7C15ull; // positions are generated with own fixed generator, so they are always the same
+		uint64_t result = 14695981039346656037ull;
+		int stones = 0;
+		for (int p = 0; p < number_of_positions; p++)
+		{
+			for (int i = 0; i < stones_per_position; i++)
+			{
+				int spot = 0;
+				do
+				{
+					state = state * 6364136223846793005ull + 1442695040888963407ull;
+					spot = (state >> 33) % board.size();
+				} while (board[spot] != Sign::NONE);
+				board[spot] = (stones % 2 == 0) ? Sign::CROSS : Sign::CIRCLE;
+				stones++;
+			}
+			calc.setBoard(board, (stones % 2 == 0) ? Sign::CROSS : Sign::CIRCLE);
+			features.encode(calc);
+			result = hash_words(result, features.data(), features.size());
+		}
+		return result;
+	}
+	bool SampleCache::isSampleCache(const std::string &path)
+	{
+		std::ifstream stream(path, std::ios::in | std::ios::binary);
+		char magic[sizeof(magic_string)];
+		if (not stream.read(magic, sizeof(magic)))
+			return false;
+		return std::memcmp(magic, magic_string, sizeof(magic_string)) == 0;
+	}
+	bool SampleCache::isUpToDate(const std::string &path, const Dataset &dataset, int bufferIndex, const std::string &samplerType)
+	{
+		if (not isSampleCache(path))
+			return false;
+		try
+		{
+			const SampleCache cache(path);
+			return cache.isCreatedFrom(dataset, bufferIndex) and cache.getSamplerType() == samplerType
+					and cache.getEncoderHash() == getEncoderHash(cache.getConfig());
+		} catch (std::exception &e)
+		{ // for example older version of the format
+			return false;
+		}
+	}
+	void SampleCache::save(const Dataset &dataset, int bufferIndex, const std::string &samplerType, const std::string &path)
+	{
+		const GameConfig cfg = dataset.getConfig(bufferIndex);
+		std::unique_ptr<Sampler> sampler = createSampler(samplerType);
+
+		std::vector<GameIndexEntry> games;
+		uint32_t samples = 0;
+		for (int i = 0; i < dataset.numberOfGames(bufferIndex); i++)
+		{
+			const uint32_t n = dataset.numberOfSamples(bufferIndex, i);
+			games.push_back(GameIndexEntry { samples, n });
+			samples += n;
+		}
+
+		Json json(JsonType::Object);
+		json["config"] = cfg.toJson();
+		json["sampler_type"] = samplerType;
+		const std::string json_string = json.dump();
+		const size_t game_index_offset = align_to_8(sizeof(FileHeader) + json_string.size());
+
+		FileHeader header;
+		std::memcpy(header.magic, magic_string, sizeof(magic_string));
+		header.version = current_version;
+		header.json_size = json_string.size();
+		header.encoder_hash = getEncoderHash(cfg);
+		header.games = games.size();
+		header.samples = samples;
+		header.record_size = get_record_size(cfg);
+		header.data_offset = align_to_8(game_index_offset + sizeof(GameIndexEntry) * games.size());
+
+		// written under temporary name, so that interrupted conversion does not leave a cache that looks complete
+		const std::string tmp_path = path + ".tmp";
+		{ /* artificial scope for closing the file */
+			std::ofstream stream(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (not stream.is_open())
+				throw std::runtime_error("SampleCache::save() : could not open file '" + tmp_path + "'");
+			write(stream, header);
+			stream.write(json_string.data(), json_string.size());
+			stream.write(magic_string, game_index_offset - sizeof(FileHeader) - json_string.size()); // padding, its content is irrelevant
+			stream.write(reinterpret_cast<const char*>(games.data()), sizeof(GameIndexEntry) * games.size());
+			stream.write(magic_string, header.data_offset - (game_index_offset + sizeof(GameIndexEntry) * games.size()));
+
+			SearchDataPack sample(cfg.rows, cfg.cols);
+			TrainingDataPack training_sample(cfg.rows, cfg.cols);
+			PatternCalculator calc(cfg);
+			NNInputFeatures features(cfg.rows, cfg.cols);
+			std::vector<uint8_t> record(header.record_size);
+			for (size_t i = 0; i < games.size(); i++)
+			{
+				Move played_move; // move played in the position that is currently in the calculator
+				for (uint32_t j = 0; j < games[i].samples; j++)
+				{
+					dataset.getSample(sample, bufferIndex, i, j);
+					training_sample.clear();
+					sampler->prepare(training_sample, sample);
+					if (j > 0 and is_followed_by(calc, played_move, training_sample.board, training_sample.sign_to_move))
+					{ // usually every move of a game has a sample, so they are processed in the order of moves
+						calc.addMove(played_move);
+						features.update(calc);
+					}
+					else
+					{
+						calc.setBoard(training_sample.board, training_sample.sign_to_move);
+						features.encode(calc);
+					}
+					played_move = sample.played_move;
+					encode_record(record.data(), features, training_sample);
+					stream.write(reinterpret_cast<const char*>(record.data()), record.size());
+				}
+			}
+			if (not stream.good())
+				throw std::runtime_error("SampleCache::save() : could not write to file '" + tmp_path + "'");
+		}
+		std::filesystem::rename(tmp_path, path);
+	}
+
+} /* namespace ag */
@@ -0,0 +1,114 @@
+/*
+ * SampleIndex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/SampleIndex.hpp>
+#include <alphagomoku/dataset/Dataset.hpp>
+#include <alphagomoku/dataset/data_packs.hpp>
+#include <alphagomoku/search/Value.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+	using namespace ag;
+
+	double get_surprise(const SearchDataPack &sample)
+	{
+		const float outcome = convertOutcome(sample.game_outcome, sample.played_move.sign).getExpectation();
+		return 0.1 + std::fabs(sample.minimax_value.getExpectation() - outcome); // small constant so that no sample is completely ignored
+	}
+}
+
+namespace ag
+{
+	std::string toString(SampleWeighting weighting)
+	{
+		switch (weighting)
+		{
+			default:
+			case SampleWeighting::UNIFORM:
+				return "uniform";
+			case SampleWeighting::RECENCY:
+				return "recency";
+			case SampleWeighting::SURPRISE:
+				return "surprise";
+		}
+	}
+	SampleWeighting sampleWeightingFromString(const std::string &str)
+	{
+		if (str == "uniform")
+			return SampleWeighting::UNIFORM;
+		if (str == "recency")
+			return SampleWeighting::RECENCY;
+		if (str == "surprise")
+			return SampleWeighting::SURPRISE;
+		throw std::logic_error("unknown sample weighting '" + str + "'");
+	}
+
+	SampleIndex::SampleIndex(const Dataset &dataset, SampleWeighting weighting)
+	{
+		if (dataset.isStreaming())
+			throw std::logic_error("SampleIndex() : samples of a streamed dataset cannot be indexed");
+
+		std::vector<double> weights;
+		SearchDataPack sample;
+		const std::vector<int> list_of_buffers = dataset.getListOfBuffers();
+		for (size_t b = 0; b < list_of_buffers.size(); b++)
+		{
+			const int buffer_index = list_of_buffers[b];
+			if (weighting == SampleWeighting::SURPRISE)
+			{
+				const GameConfig cfg = dataset.getConfig(buffer_index);
+				sample = SearchDataPack(cfg.rows, cfg.cols);
+			}
+			const int number_of_games = dataset.numberOfGames(buffer_index);
+			for (int g = 0; g < number_of_games; g++)
+			{
+				const int number_of_samples = dataset.numberOfSamples(buffer_index, g);
+				if (number_of_samples == 0)
+					continue;
+				games.push_back(GameEntry { buffer_index, g, static_cast<uint32_t>(sample_to_game.size()) });
+				for (int s = 0; s < number_of_samples; s++)
+				{
+					sample_to_game.push_back(games.size() - 1);
+					switch (weighting)
+					{
+						case SampleWeighting::UNIFORM:
+							weights.push_back(1.0);
+							break;
+						case SampleWeighting::RECENCY:
+							weights.push_back(1.0 + b);
+							break;
+						case SampleWeighting::SURPRISE:
+							dataset.getSample(sample, buffer_index, g, s);
+							weights.push_back(get_surprise(sample));
+							break;
+					}
+				}
+			}
+		}
+		alias_table = AliasTable(weights);
+	}
+	int SampleIndex::numberOfSamples() const noexcept
+	{
+		return sample_to_game.size();
+	}
+	SampleLocation SampleIndex::draw() const
+	{
+		if (alias_table.isEmpty())
+			throw std::logic_error("SampleIndex::draw() : there are no samples to draw from");
+		const int index = alias_table.draw();
+		const GameEntry &game = games[sample_to_game[index]];
+		return SampleLocation { game.buffer_index, game.game_index, static_cast<int>(index - game.first_sample) };
+	}
+	double SampleIndex::getProbability(int sampleIndex) const
+	{
+		return alias_table.getProbability(sampleIndex);
+	}
+
+} /* namespace ag */
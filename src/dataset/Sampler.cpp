@@ -9,6 +9,8 @@
 #include <alphagomoku/dataset/Dataset.hpp>
 #include <alphagomoku/dataset/GameDataBuffer.hpp>
 #include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/dataset/SampleCache.hpp>
+#include <alphagomoku/dataset/SampleIndex.hpp>
 #include <alphagomoku/dataset/SearchDataStorage.hpp>
 #include <alphagomoku/utils/math_utils.hpp>
 #include <alphagomoku/utils/random.hpp>
@@ -22,6 +24,12 @@ namespace
 	{
 		return score.isProven() ? score.convertToValue() : value;
 	}
+	template<typename T>
+	void shuffle_in_place(std::vector<T> &vector)
+	{ // uses thread local generator so that samplers running on different threads are independent
+		for (int i = static_cast<int>(vector.size()) - 1; i > 0; i--)
+			std::swap(vector[i], vector[randInt(i + 1)]);
+	}
 	std::vector<std::pair<int, int>> list_all_games(const Dataset &dataset)
 	{
 		std::vector<std::pair<int, int>> result;
@@ -29,12 +37,18 @@ namespace
 		const std::vector<int> list_of_buffers = dataset.getListOfBuffers();
 		for (size_t i = 0; i < list_of_buffers.size(); i++)
 		{
-			const GameDataBuffer &buffer = dataset.getBuffer(list_of_buffers[i]);
-			for (int j = 0; j < buffer.numberOfGames(); j++)
+			const int number_of_games = dataset.numberOfGames(list_of_buffers[i]);
+			for (int j = 0; j < number_of_games; j++)
 				result.push_back( { list_of_buffers[i], j });
 		}
 		return result;
 	}
+
+	/*
+	 * In streaming mode samples are taken from a few buffers at once, and each drawn buffer provides one batch worth of samples before it is replaced.
+	 * This way loading of a buffer is amortized over many samples while consecutive samples still come from different buffers.
+	 */
+	const int number_of_streamed_buffers = 4;
 }
 
 namespace ag
@@ -42,52 +56,128 @@ namespace ag
 	void Sampler::init(const Dataset &dataset, int batchSize)
 	{
 		this->dataset = &dataset;
+		batch_size = batchSize;
+		streamed_buffers.clear();
+		sample_index = nullptr;
+		if (dataset.isStreaming())
+		{
+			streamed_buffers.resize(number_of_streamed_buffers, { nullptr, 0 });
+			return;
+		}
 		buffer_and_game_ordering = list_all_games(dataset);
-		std::random_shuffle(buffer_and_game_ordering.begin(), buffer_and_game_ordering.end());
+		shuffle_in_place(buffer_and_game_ordering);
+	}
+	void Sampler::init(const Dataset &dataset, int batchSize, std::shared_ptr<const SampleIndex> index)
+	{
+		if (index == nullptr)
+		{
+			init(dataset, batchSize);
+			return;
+		}
+		if (dataset.isStreaming())
+			throw std::logic_error("Sampler::init() : sample index cannot be used with streamed dataset");
+		this->dataset = &dataset;
 		batch_size = batchSize;
+		streamed_buffers.clear();
+		buffer_and_game_ordering.clear();
+		sample_index = index;
 	}
 	void Sampler::get(TrainingDataPack &result)
+	{
+		get_sample(result, nullptr);
+	}
+	bool Sampler::get(TrainingDataPack &result, NNInputFeatures &features)
+	{
+		return get_sample(result, &features);
+	}
+	void Sampler::prepare(TrainingDataPack &result, const SearchDataPack &sample)
+	{
+		prepare_training_data(result, sample);
+	}
+	/*
+	 * private
+	 */
+	bool Sampler::get_sample(TrainingDataPack &result, NNInputFeatures *features)
 	{
 		if (dataset == nullptr)
 			throw std::logic_error("Dataset is null. Most likely this Sampler was not initialized");
+		if (not streamed_buffers.empty())
+		{
+			get_streamed(result);
+			return false;
+		}
 		result.clear();
-		bool found = false;
-		while (not found)
+		if (sample_index != nullptr)
+		{
+			const SampleLocation location = sample_index->draw();
+			return load_sample(result, features, location.buffer_index, location.game_index, location.sample_index);
+		}
+		while (true)
 		{
 			const int buffer_index = buffer_and_game_ordering.at(counter).first;
 			const int game_index = buffer_and_game_ordering.at(counter).second;
-			std::vector<int> move_order(dataset->getBuffer(buffer_index).getGameData(game_index).numberOfSamples());
-			std::iota(move_order.begin(), move_order.end(), 0);
-			std::random_shuffle(move_order.begin(), move_order.end());
-			for (size_t i = 0; i < move_order.size(); i++)
-			{
-				const int sample_index = move_order[i]; // randInt(dataset->getBuffer(buffer_index).getGameData(game_index).numberOfSamples());
+			const int number_of_samples = dataset->numberOfSamples(buffer_index, game_index);
 
-				const GameConfig cfg = dataset->getBuffer(buffer_index).getConfig();
-				search_data_pack = SearchDataPack(cfg.rows, cfg.cols);
-				dataset->getBuffer(buffer_index).getGameData(game_index).getSample(search_data_pack, sample_index);
-
-//				if (search_data_pack.flags[0] == false) // exclude statically provable positions
-//				if (search_data_pack.flags[1] == false) // exclude recursively provable positions
-				{
-					prepare_training_data(result, search_data_pack);
-					found = true;
-					break;
-				}
+			counter++;
+			if (counter >= buffer_and_game_ordering.size())
+			{
+				shuffle_in_place(buffer_and_game_ordering);
+				counter = 0;
+			}
 
-//		buffer->getGameData(game_index)[sample_index].print();
-//		search_data_pack.print();
-//		result.print();
+			if (number_of_samples > 0)
+				return load_sample(result, features, buffer_index, game_index, randInt(number_of_samples));
+		}
+	}
+	void Sampler::get_streamed(TrainingDataPack &result)
+	{
+		result.clear();
+		while (true)
+		{
+			std::pair<std::shared_ptr<const GameDataBuffer>, int> &entry = streamed_buffers[randInt(streamed_buffers.size())];
+			if (entry.second <= 0)
+			{
+				entry.first = nullptr; // release the buffer first so that it can be evicted
+				entry.first = dataset->drawBuffer();
+				entry.second = std::max(1, batch_size);
+			}
+			entry.second--;
 
+			const GameDataBuffer &buffer = *entry.first;
+			if (buffer.numberOfGames() == 0)
+			{
+				entry.second = 0;
+				continue;
 			}
+			const GameDataStorage &game = buffer.getGameData(randInt(buffer.numberOfGames()));
+			if (game.numberOfSamples() == 0)
+				continue;
 
-			counter++;
-			if (counter >= buffer_and_game_ordering.size())
+			const GameConfig &cfg = buffer.getConfig();
+			if (search_data_pack.board.rows() != cfg.rows or search_data_pack.board.cols() != cfg.cols)
+				search_data_pack = SearchDataPack(cfg.rows, cfg.cols);
+			game.getSample(search_data_pack, randInt(game.numberOfSamples()));
+			prepare_training_data(result, search_data_pack);
+			return;
+		}
+	}
+	bool Sampler::load_sample(TrainingDataPack &result, NNInputFeatures *features, int bufferIndex, int gameIndex, int sampleIndex)
+	{
+		if (features != nullptr)
+		{
+			const SampleCache *cache = dataset->getCache(bufferIndex);
+			if (cache != nullptr)
 			{
-				std::random_shuffle(buffer_and_game_ordering.begin(), buffer_and_game_ordering.end());
-				counter = 0;
+				cache->getSample(*features, result, gameIndex, sampleIndex);
+				return true;
 			}
 		}
+		const GameConfig cfg = dataset->getConfig(bufferIndex);
+		if (search_data_pack.board.rows() != cfg.rows or search_data_pack.board.cols() != cfg.cols)
+			search_data_pack = SearchDataPack(cfg.rows, cfg.cols); // reallocated only when the board size changes
+		dataset->getSample(search_data_pack, bufferIndex, gameIndex, sampleIndex);
+		prepare_training_data(result, search_data_pack);
+		return false;
 	}
 
 	/*
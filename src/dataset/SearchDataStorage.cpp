@@ -14,6 +14,8 @@
 #include <minml/utils/serialization.hpp>
 
 #include <iostream>
+#include <cstring>
+#include <stdexcept>
 
 namespace
 {
@@ -48,6 +50,15 @@ namespace
 		}
 	}
 
+	template<typename T>
+	T load_from_memory(const uint8_t *binary_data, size_t &offset) noexcept
+	{
+		T result;
+		std::memcpy(&result, binary_data + offset, sizeof(T));
+		offset += sizeof(T);
+		return result;
+	}
+
 	Value get_valid_value(float winrate, float drawrate) noexcept
 	{
 		const float tmp = winrate + drawrate;
@@ -94,8 +105,7 @@ namespace ag
 			for (int col = 0; col < pack.board.cols(); col++)
 				if (pack.visit_count.at(row, col) > 0 or pack.action_scores.at(row, col).isProven())
 				{
-					const int visits = pack.visit_count.at(row, col);
-					assert(visits <= std::numeric_limits<uint16_t>::max());
+					const int visits = std::min(pack.visit_count.at(row, col), static_cast<int>(std::numeric_limits<uint16_t>::max())); // merged samples may exceed the range
 					const Value value = pack.action_values.at(row, col);
 					const Score score = pack.action_scores.at(row, col);
 
@@ -374,38 +384,7 @@ namespace ag
 	}
 	void SearchDataStorage_v201::storeTo(SearchDataPack &pack) const
 	{
-		int current_idx = 0;
-		float win_rate = 0.0f, draw_rate = 0.0f;
-		int sum_visits = 0;
-		for (size_t i = 0; i < storage.size(); i++)
-		{
-			const int loc_delta = storage[i].location_delta;
-			current_idx += loc_delta;
-			assert(pack.board[i] == Sign::NONE);
-			const float visits = visit_format::to_fp32(storage[i].visit_count) * visit_scale + 0.5f;
-			pack.visit_count[current_idx] = visits;
-
-			const Value q = get_valid_value(value_format::to_fp32(storage[i].win_rate) * value_scale,
-					value_format::to_fp32(storage[i].draw_rate) * value_scale);
-			pack.action_values[current_idx] = q;
-			pack.action_scores[current_idx] = int8_to_score(storage[i].score);
-			pack.policy_prior[current_idx] = policy_format::to_fp32(storage[i].policy_prior) * policy_scale;
-
-			sum_visits += visits;
-			win_rate += q.win_rate * visits;
-			draw_rate += q.draw_rate * visits;
-		}
-
-		pack.minimax_score = minimax_score;
-		if (sum_visits == 0)
-		{
-			assert(minimax_score.isProven());
-			pack.minimax_value = minimax_score.convertToValue();
-		}
-		else
-			pack.minimax_value = get_valid_value(win_rate / sum_visits, draw_rate / sum_visits);
-
-		pack.flags = flags;
+		store_entries(pack, storage.data(), storage.size(), value_scale, policy_scale, visit_scale, minimax_score, flags);
 	}
 	void SearchDataStorage_v201::serialize(SerializedObject &binary_data) const
 	{
@@ -434,5 +413,69 @@ namespace ag
 					<< (value_format::to_fp32(storage[i].draw_rate) * value_scale) << '\n';
 		std::cout << '\n';
 	}
+	int SearchDataStorage_v201::storeTo(SearchDataPack &pack, const uint8_t *binary_data, size_t size)
+	{
+		size_t offset = 0;
+		if (3 * sizeof(uint16_t) + sizeof(Score) + 2 * sizeof(uint16_t) + sizeof(uint32_t) > size)
+			throw std::runtime_error("SearchDataStorage_v201::storeTo() : sample header does not fit into " + std::to_string(size) + " bytes");
+		const float value_scale = fp16_format::to_fp32(load_from_memory<uint16_t>(binary_data, offset));
+		const float policy_scale = fp16_format::to_fp32(load_from_memory<uint16_t>(binary_data, offset));
+		const float visit_scale = fp16_format::to_fp32(load_from_memory<uint16_t>(binary_data, offset));
+		const Score minimax_score = load_from_memory<Score>(binary_data, offset);
+		const int move_number = load_from_memory<uint16_t>(binary_data, offset);
+		const BitMask1D<uint16_t> flags(load_from_memory<uint16_t>(binary_data, offset));
+		const size_t count = load_from_memory<uint32_t>(binary_data, offset);
+		if (count > (size - offset) / sizeof(entry))
+			throw std::runtime_error("SearchDataStorage_v201::storeTo() : " + std::to_string(count) + " entries do not fit into the sample");
+
+		const entry *entries = reinterpret_cast<const entry*>(binary_data + offset);
+		int last_idx = 0;
+		for (size_t i = 0; i < count; i++)
+			last_idx += entries[i].location_delta;
+		if (count > 0 and last_idx >= pack.board.size())
+			throw std::runtime_error("SearchDataStorage_v201::storeTo() : entries do not fit on the board");
+
+		store_entries(pack, entries, count, value_scale, policy_scale, visit_scale, minimax_score, flags);
+		return move_number;
+	}
+	/*
+	 * private
+	 */
+	void SearchDataStorage_v201::store_entries(SearchDataPack &pack, const entry *entries, size_t count, float valueScale, float policyScale,
+			float visitScale, Score minimaxScore, BitMask1D<uint16_t> flags)
+	{
+		int current_idx = 0;
+		float win_rate = 0.0f, draw_rate = 0.0f;
+		int sum_visits = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			const int loc_delta = entries[i].location_delta;
+			current_idx += loc_delta;
+			assert(pack.board[i] == Sign::NONE);
+			const float visits = visit_format::to_fp32(entries[i].visit_count) * visitScale + 0.5f;
+			pack.visit_count[current_idx] = visits;
+
+			const Value q = get_valid_value(value_format::to_fp32(entries[i].win_rate) * valueScale,
+					value_format::to_fp32(entries[i].draw_rate) * valueScale);
+			pack.action_values[current_idx] = q;
+			pack.action_scores[current_idx] = int8_to_score(entries[i].score);
+			pack.policy_prior[current_idx] = policy_format::to_fp32(entries[i].policy_prior) * policyScale;
+
+			sum_visits += visits;
+			win_rate += q.win_rate * visits;
+			draw_rate += q.draw_rate * visits;
+		}
+
+		pack.minimax_score = minimaxScore;
+		if (sum_visits == 0)
+		{
+			assert(minimaxScore.isProven());
+			pack.minimax_value = minimaxScore.convertToValue();
+		}
+		else
+			pack.minimax_value = get_valid_value(win_rate / sum_visits, draw_rate / sum_visits);
+
+		pack.flags = flags;
+	}
 
 } /* namespace ag */
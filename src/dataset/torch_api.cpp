@@ -10,23 +10,351 @@
 #include <alphagomoku/dataset/Sampler.hpp>
 #include <alphagomoku/dataset/GameDataBuffer.hpp>
 #include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/dataset/IndexedDataset.hpp>
 
 #include <alphagomoku/patterns/PatternCalculator.hpp>
 #include <alphagomoku/networks/NNInputFeatures.hpp>
 
 #include <alphagomoku/utils/random.hpp>
 #include <alphagomoku/utils/augmentations.hpp>
+#include <alphagomoku/utils/low_precision.hpp>
 
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 namespace
 {
 	using namespace ag;
 
-	Dataset& get_dataset()
+	using ieee_fp16 = LowFP<1, 5, 10, -15>;
+
+	/*
+	 * \brief Persistent threads that process items of a job. The calling thread also takes part in processing, as worker 0.
+	 */
+	class WorkerPool
+	{
+			std::vector<std::thread> threads;
+			std::mutex pool_mutex;
+			std::condition_variable pool_cond;
+			std::function<void(int, int)> task; // called with index of the item and index of the worker
+			int number_of_items = 0;
+			std::atomic<int> next_item { 0 };
+			int running_workers = 0;
+			uint64_t job_counter = 0;
+			std::exception_ptr task_exception;
+			bool is_stopping = false;
+		public:
+			WorkerPool(int numberOfThreads)
+			{
+				for (int i = 1; i < numberOfThreads; i++)
+					threads.push_back(std::thread([this, i]()
+					{	worker_loop(i);}));
+			}
+			WorkerPool(const WorkerPool &other) = delete;
+			WorkerPool& operator=(const WorkerPool &other) = delete;
+			~WorkerPool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(pool_mutex);
+					is_stopping = true;
+				}
+				pool_cond.notify_all();
+				for (size_t i = 0; i < threads.size(); i++)
+					threads[i].join();
+			}
+			int size() const noexcept
+			{
+				return 1 + threads.size();
+			}
+			void run(int numberOfItems, const std::function<void(int, int)> &function)
+			{
+				{
+					std::lock_guard<std::mutex> lock(pool_mutex);
+					task = function;
+					number_of_items = numberOfItems;
+					next_item.store(0);
+					running_workers = threads.size();
+					task_exception = nullptr;
+					job_counter++;
+				}
+				pool_cond.notify_all();
+				process_items(0);
+
+				std::unique_lock<std::mutex> lock(pool_mutex);
+				pool_cond.wait(lock, [this]()
+				{	return running_workers == 0;});
+				task = nullptr;
+				if (task_exception != nullptr)
+					std::rethrow_exception(task_exception);
+			}
+		private:
+			void worker_loop(int workerIndex)
+			{
+				uint64_t last_job = 0;
+				while (true)
+				{
+					{
+						std::unique_lock<std::mutex> lock(pool_mutex);
+						pool_cond.wait(lock, [this, last_job]()
+						{	return is_stopping or job_counter != last_job;});
+						if (is_stopping)
+							return;
+						last_job = job_counter;
+					}
+					process_items(workerIndex);
+					{
+						std::lock_guard<std::mutex> lock(pool_mutex);
+						running_workers--;
+					}
+					pool_cond.notify_all();
+				}
+			}
+			void process_items(int workerIndex)
+			{
+				try
+				{
+					for (int i = next_item++; i < number_of_items; i = next_item++)
+						task(i, workerIndex);
+				} catch (...)
+				{
+					std::lock_guard<std::mutex> lock(pool_mutex);
+					if (task_exception == nullptr)
+						task_exception = std::current_exception();
+					next_item.store(number_of_items); // other workers stop after their current item
+				}
+			}
+	};
+
+	/*
+	 * \brief Raw output buffer with elements of given type, filled one sample at a time.
+	 */
+	class OutputTensor
+	{
+			void *data;
+			DataType_t dtype;
+			size_t offset;
+		public:
+			OutputTensor(void *data, DataType_t dtype, int sampleIndex, size_t sampleSize) noexcept :
+					data(data),
+					dtype(dtype),
+					offset(sampleIndex * sampleSize)
+			{
+			}
+			void set(int index, float value) noexcept
+			{
+				switch (dtype)
+				{
+					default:
+					case DTYPE_FLOAT32:
+						reinterpret_cast<float*>(data)[offset + index] = value;
+						break;
+					case DTYPE_FLOAT16:
+						reinterpret_cast<uint16_t*>(data)[offset + index] = ieee_fp16::to_lowp(value);
+						break;
+					case DTYPE_UINT8:
+						reinterpret_cast<uint8_t*>(data)[offset + index] = static_cast<uint8_t>(value);
+						break;
+				}
+			}
+	};
+
+	size_t size_of(DataType_t dtype) noexcept
+	{
+		switch (dtype)
+		{
+			default:
+			case DTYPE_FLOAT32:
+				return 4;
+			case DTYPE_FLOAT16:
+				return 2;
+			case DTYPE_UINT8:
+				return 1;
+		}
+	}
+	/*
+	 * \brief Input tensor has one channel per bit of the features, and some of them must be permuted together with the cells.
+	 */
+	SymmetryIndexTable create_input_symmetry_table(MatrixShape shape)
+	{
+		SymmetryIndexTable result(shape, 32);
+		for (int s = 0; s < number_of_available_symmetries(shape); s++)
+		{
+			std::vector<int> permutation(32);
+			for (int c = 0; c < 32; c++)
+			{
+				uint32_t bit = 1u << c;
+				augment_feature_directions(&bit, 1, s);
+				permutation[c] = __builtin_ctz(bit);
+			}
+			result.permuteChannels(int_to_symmetry(s), permutation);
+		}
+		return result;
+	}
+
+	/*
+	 * \brief Objects needed to convert a sample, one per worker thread. They are created once and reused between batches.
+	 */
+	struct Workspace
+	{
+			GameConfig game_config;
+			SearchDataPack pack;
+			std::unique_ptr<PatternCalculator> calculator;
+			NNInputFeatures features;
+			const SymmetryIndexTable *cell_table = nullptr;
+			SymmetryIndexTable input_table; // created only when already loaded samples are augmented
+			std::vector<Symmetry> symmetry;
+			std::vector<char> augmentation_workspace;
+			void prepare(const GameConfig &cfg)
+			{
+				if (calculator != nullptr and game_config.rules == cfg.rules and game_config.rows == cfg.rows and game_config.cols == cfg.cols)
+					return;
+				game_config = cfg;
+				pack = SearchDataPack(cfg.rows, cfg.cols);
+				calculator = std::make_unique<PatternCalculator>(cfg);
+				features = NNInputFeatures(cfg.rows, cfg.cols);
+				cell_table = &SymmetryIndexTable::getShared(MatrixShape(cfg.rows, cfg.cols));
+				input_table = SymmetryIndexTable();
+			}
+			/*
+			 * \brief Applies symmetry to a sample that was already written into the output tensors, gathering with precomputed index tables.
+			 */
+			void augment(int sampleIndex, Symmetry s, DataType_t inputType, DataType_t targetType, void *input, void *policyTarget,
+					void *actionValuesTarget)
+			{
+				const MatrixShape shape(game_config.rows, game_config.cols);
+				assert(is_symmetry_allowed(s, shape));
+				if (s == Symmetry::IDENTITY)
+					return;
+				symmetry.assign(1, s);
+				auto augment_tensor = [&](void *data, DataType_t dtype, const SymmetryIndexTable &table)
+				{
+					const size_t sample_size = size_of(dtype) * table.length();
+					apply_symmetry_to_batch(reinterpret_cast<char*>(data) + sampleIndex * sample_size, size_of(dtype), table, symmetry,
+							augmentation_workspace);
+				};
+				if (input_table.length() == 0)
+					input_table = create_input_symmetry_table(shape);
+				augment_tensor(input, inputType, input_table);
+				augment_tensor(policyTarget, targetType, SymmetryIndexTable::getShared(shape, 1));
+				augment_tensor(actionValuesTarget, targetType, SymmetryIndexTable::getShared(shape, 3));
+			}
+	};
+
+	class DatasetLoader
+	{
+			Dataset dataset;
+			WorkerPool pool;
+			std::vector<Workspace> workspaces;
+			std::mutex loader_mutex; // only one batch of given loader is processed at a time
+		public:
+			DatasetLoader(int numberOfThreads) :
+					pool(std::max(1, numberOfThreads)),
+					workspaces(pool.size())
+			{
+			}
+			Dataset& getDataset() noexcept
+			{
+				return dataset;
+			}
+			void loadBatch(int batchSize, const Sample_t *samples, DataType_t inputType, DataType_t targetType, void *input, void *policyTarget,
+					void *valueTarget, void *movesLeftTarget, void *actionValuesTarget)
+			{
+				std::lock_guard<std::mutex> lock(loader_mutex);
+				pool.run(batchSize, [&](int b, int workerIndex)
+				{
+					const GameConfig cfg = dataset.getConfig(samples[b].buffer_index);
+					const int board_size = cfg.rows * cfg.cols;
+					Workspace &workspace = workspaces[workerIndex];
+					workspace.prepare(cfg);
+					load_sample(workspace, samples[b], OutputTensor(input, inputType, b, 32 * board_size), OutputTensor(policyTarget, targetType, b, board_size),
+							OutputTensor(valueTarget, targetType, b, 3), OutputTensor(movesLeftTarget, targetType, b, 1),
+							OutputTensor(actionValuesTarget, targetType, b, 3 * board_size));
+				});
+			}
+			void augmentBatch(int batchSize, const Sample_t *samples, DataType_t inputType, DataType_t targetType, void *input, void *policyTarget,
+					void *actionValuesTarget)
+			{
+				std::lock_guard<std::mutex> lock(loader_mutex);
+				pool.run(batchSize, [&](int b, int workerIndex)
+				{
+					Workspace &workspace = workspaces[workerIndex];
+					workspace.prepare(dataset.getConfig(samples[b].buffer_index));
+					workspace.augment(b, int_to_symmetry(samples[b].augmentation), inputType, targetType, input, policyTarget, actionValuesTarget);
+				});
+			}
+		private:
+			void load_sample(Workspace &workspace, const Sample_t &sample, OutputTensor input, OutputTensor policyTarget, OutputTensor valueTarget,
+					OutputTensor movesLeftTarget, OutputTensor actionValuesTarget) const
+			{
+				SearchDataPack &pack = workspace.pack;
+				dataset.getSample(pack, sample.buffer_index, sample.game_index, sample.sample_index);
+
+				workspace.calculator->setBoard(pack.board, pack.played_move.sign);
+				workspace.features.encode(*workspace.calculator);
+
+				// augmentation is fused with the conversion, each cell is written directly to its transformed location
+				const Symmetry s = int_to_symmetry(sample.augmentation);
+				assert(is_symmetry_allowed(s, pack.board.shape()));
+				const std::vector<int> &dst_index = workspace.cell_table->get(get_inverse_symmetry(s));
+				augment_feature_directions(workspace.features.data(), workspace.features.size(), sample.augmentation);
+
+				const Value qt = convertOutcome(pack.game_outcome, pack.played_move.sign);
+				valueTarget.set(0, qt.win_rate);
+				valueTarget.set(1, qt.draw_rate);
+				valueTarget.set(2, qt.loss_rate());
+
+				movesLeftTarget.set(0, pack.moves_left);
+
+				float policy_sum = 0.0f;
+				for (int i = 0; i < pack.board.size(); i++)
+				{
+					const int dst = dst_index[i];
+					uint32_t f = workspace.features[i];
+					for (int j = 0; j < 32; j++)
+					{
+						input.set(dst * 32 + j, (f & 1u) ? 1.0f : 0.0f);
+						f = (f >> 1u);
+					}
+
+					const Score score = pack.action_scores[i];
+					const Value value = score.isProven() ? score.convertToValue() : pack.action_values[i];
+
+					actionValuesTarget.set(dst * 3 + 0, value.win_rate);
+					actionValuesTarget.set(dst * 3 + 1, value.draw_rate);
+					actionValuesTarget.set(dst * 3 + 2, value.loss_rate());
+
+					switch (score.getProvenValue())
+					{
+						case ProvenValue::LOSS:
+							pack.policy_prior[i] = 1.0e-6f;
+							break;
+						case ProvenValue::DRAW:
+							pack.policy_prior[i] = std::max(1, pack.visit_count[i]);
+							break;
+						default:
+						case ProvenValue::UNKNOWN:
+							pack.policy_prior[i] = pack.visit_count[i];
+							break;
+						case ProvenValue::WIN:
+							pack.policy_prior[i] = 1.0e+6f;
+							break;
+					}
+					policy_sum += pack.policy_prior[i];
+				}
+				const float tmp = 1.0f / policy_sum;
+				for (int i = 0; i < pack.board.size(); i++)
+					policyTarget.set(dst_index[i], pack.policy_prior[i] * tmp); // policy prior is used as temporary storage as it is not needed anymore
+			}
+	};
+
+	DatasetLoader& get_loader(LoaderHandle_t handle)
 	{
-		static Dataset dataset;
-		return dataset;
+		static DatasetLoader default_loader(1);
+		return (handle == nullptr) ? default_loader : *reinterpret_cast<DatasetLoader*>(handle);
 	}
 
 	std::vector<std::pair<int, int>> list_all_games(const Dataset &dataset)
@@ -36,8 +364,8 @@ namespace
 		const std::vector<int> list_of_buffers = dataset.getListOfBuffers();
 		for (size_t i = 0; i < list_of_buffers.size(); i++)
 		{
-			const GameDataBuffer &buffer = dataset.getBuffer(list_of_buffers[i]);
-			for (int j = 0; j < buffer.numberOfGames(); j++)
+			const int number_of_games = dataset.numberOfGames(list_of_buffers[i]);
+			for (int j = 0; j < number_of_games; j++)
 				result.push_back( { list_of_buffers[i], j });
 		}
 		return result;
@@ -65,7 +393,7 @@ namespace
 
 				const int buffer_index = buffer_and_game_ordering.at(counter).first;
 				const int game_index = buffer_and_game_ordering.at(counter).second;
-				const int sample_index = randInt(dataset->getBuffer(buffer_index).getGameData(game_index).numberOfSamples());
+				const int sample_index = randInt(dataset->numberOfSamples(buffer_index, game_index));
 
 				counter++;
 				if (counter >= buffer_and_game_ordering.size())
@@ -77,13 +405,13 @@ namespace
 			}
 			GameConfig get_config(const Sample_t &sample) const
 			{
-				return dataset->getBuffer(sample.buffer_index).getConfig();
+				return dataset->getConfig(sample.buffer_index);
 			}
 			SearchDataPack load_data(const Sample_t &sample) const
 			{
-				const GameConfig cfg = dataset->getBuffer(sample.buffer_index).getConfig();
+				const GameConfig cfg = dataset->getConfig(sample.buffer_index);
 				SearchDataPack result(cfg.rows, cfg.cols);
-				dataset->getBuffer(sample.buffer_index).getGameData(sample.game_index).getSample(result, sample.sample_index);
+				dataset->getSample(result, sample.buffer_index, sample.game_index, sample.sample_index);
 
 				const Symmetry s = int_to_symmetry(randInt(number_of_available_symmetries(result.board.shape())));
 				ag::apply_symmetry_in_place(result.board, s);
@@ -117,61 +445,111 @@ namespace
 	{
 		return toString(cfg.rules) + ":" + std::to_string(cfg.rows) + "x" + std::to_string(cfg.cols);
 	}
+	GameConfig get_batch_config(const Dataset &dataset, int batchSize, const Sample_t *samples)
+	{
+		const GameConfig cfg = dataset.getConfig(samples[0].buffer_index);
+		for (int b = 1; b < batchSize; b++)
+		{
+			const GameConfig c = dataset.getConfig(samples[b].buffer_index);
+			if (not is_same_config(c, cfg))
+				throw std::runtime_error("GameConfig mismatch at " + std::to_string(b) + ", expected " + to_string(cfg) + ", got " + to_string(c));
+		}
+		return cfg;
+	}
 }
 
+
 namespace ag
 {
 	void load_dataset_fragment(int i, const char *path)
 	{
-		assert(path != nullptr);
-		get_dataset().load(i, path);
+		loader_load_dataset_fragment(nullptr, i, path);
 	}
 	void unload_dataset_fragment(int i)
 	{
-		get_dataset().unload(i);
+		loader_unload_dataset_fragment(nullptr, i);
+	}
+	void convert_dataset_fragment(const char *src_path, const char *dst_path)
+	{
+		assert(src_path != nullptr);
+		assert(dst_path != nullptr);
+		IndexedDataset::convert(src_path, dst_path);
 	}
 	void get_dataset_size(TensorSize_t *shape, int *size)
 	{
+		loader_get_dataset_size(nullptr, shape, size);
+	}
+	void print_dataset_info()
+	{
+		loader_print_dataset_info(nullptr);
+	}
+
+	void get_tensor_shapes(int batch_size, const Sample_t *samples, TensorSize_t *input, TensorSize_t *policy_target, TensorSize_t *value_target,
+			TensorSize_t *moves_left_target, TensorSize_t *action_values_target)
+	{
+		loader_get_tensor_shapes(nullptr, batch_size, samples, input, policy_target, value_target, moves_left_target, action_values_target);
+	}
+	void load_batch(int batch_size, const Sample_t *samples, float *input, float *policy_target, float *value_target, float *moves_left_target,
+			float *action_values_target)
+	{
+		load_batch_parallel(nullptr, batch_size, samples, DTYPE_FLOAT32, DTYPE_FLOAT32, input, policy_target, value_target, moves_left_target,
+				action_values_target);
+	}
+
+	LoaderHandle_t create_loader(int number_of_threads)
+	{
+		return new DatasetLoader(number_of_threads);
+	}
+	void destroy_loader(LoaderHandle_t handle)
+	{
+		delete reinterpret_cast<DatasetLoader*>(handle);
+	}
+	void loader_load_dataset_fragment(LoaderHandle_t handle, int i, const char *path)
+	{
+		assert(path != nullptr);
+		get_loader(handle).getDataset().load(i, path);
+	}
+	void loader_unload_dataset_fragment(LoaderHandle_t handle, int i)
+	{
+		get_loader(handle).getDataset().unload(i);
+	}
+	void loader_get_dataset_size(LoaderHandle_t handle, TensorSize_t *shape, int *size)
+	{
+		const Dataset &dataset = get_loader(handle).getDataset();
 		if (shape != nullptr)
 		{
 			assert(size == nullptr);
-			fill_tensor_size(shape, { get_dataset().numberOfGames(), 4 });
+			fill_tensor_size(shape, { dataset.numberOfGames(), 4 });
 			return;
 		}
 		assert(shape == nullptr);
 
 		size_t idx = 0;
-		const std::vector<int> list_of_buffers = get_dataset().getListOfBuffers();
+		const std::vector<int> list_of_buffers = dataset.getListOfBuffers();
 		for (size_t i = 0; i < list_of_buffers.size(); i++)
 		{
-			const GameDataBuffer &buffer = get_dataset().getBuffer(list_of_buffers[i]);
-			for (int j = 0; j < buffer.numberOfGames(); j++)
+			const GameConfig cfg = dataset.getConfig(list_of_buffers[i]);
+			const int number_of_games = dataset.numberOfGames(list_of_buffers[i]);
+			for (int j = 0; j < number_of_games; j++)
 			{
 				size[idx + 0] = list_of_buffers[i];
 				size[idx + 1] = j;
-				size[idx + 2] = buffer.getGameData(j).numberOfSamples();
-				size[idx + 3] = number_of_available_symmetries(MatrixShape(buffer.getConfig().rows, buffer.getConfig().cols));
+				size[idx + 2] = dataset.numberOfSamples(list_of_buffers[i], j);
+				size[idx + 3] = number_of_available_symmetries(MatrixShape(cfg.rows, cfg.cols));
 				idx += 4;
 			}
 		}
 	}
-	void print_dataset_info()
+	void loader_print_dataset_info(LoaderHandle_t handle)
 	{
-		std::cout << get_dataset().getStats().toString() << '\n';
+		std::cout << get_loader(handle).getDataset().getStats().toString() << '\n';
 	}
-
-	void get_tensor_shapes(int batch_size, const Sample_t *samples, TensorSize_t *input, TensorSize_t *policy_target, TensorSize_t *value_target,
-			TensorSize_t *moves_left_target, TensorSize_t *action_values_target)
+	void loader_get_tensor_shapes(LoaderHandle_t handle, int batch_size, const Sample_t *samples, TensorSize_t *input, TensorSize_t *policy_target,
+			TensorSize_t *value_target, TensorSize_t *moves_left_target, TensorSize_t *action_values_target)
 	{
 		if (batch_size <= 0)
 			return;
-		const GameConfig cfg = get_dataset().getBuffer(samples[0].buffer_index).getConfig();
-		for (int b = 1; b < batch_size; b++)
-		{
-			const GameConfig c = get_dataset().getBuffer(samples[b].buffer_index).getConfig();
-			if (not is_same_config(c, cfg))
-				throw std::runtime_error("GameConfig mismatch at " + std::to_string(b) + ", expected " + to_string(cfg) + ", got " + to_string(c));
-		}
+		const GameConfig cfg = get_batch_config(get_loader(handle).getDataset(), batch_size, samples);
 
 		const int rows = cfg.rows;
 		const int columns = cfg.cols;
@@ -182,8 +560,8 @@ namespace ag
 		fill_tensor_size(moves_left_target, { batch_size, 1 });
 		fill_tensor_size(action_values_target, { batch_size, rows, columns, 3 });
 	}
-	void load_batch(int batch_size, const Sample_t *samples, float *input, float *policy_target, float *value_target, float *moves_left_target,
-			float *action_values_target)
+	void load_batch_parallel(LoaderHandle_t handle, int batch_size, const Sample_t *samples, DataType_t input_dtype, DataType_t target_dtype,
+			void *input, void *policy_target, void *value_target, void *moves_left_target, void *action_values_target)
 	{
 		assert(samples != nullptr);
 		assert(input != nullptr);
@@ -192,90 +570,29 @@ namespace ag
 		assert(moves_left_target != nullptr);
 		assert(action_values_target != nullptr);
 
+		if (target_dtype == DTYPE_UINT8)
+			throw std::invalid_argument("load_batch_parallel() : targets cannot be stored as uint8");
 		if (batch_size <= 0)
 			return;
-		const GameConfig cfg = get_dataset().getBuffer(samples[0].buffer_index).getConfig();
-		for (int b = 1; b < batch_size; b++)
-		{
-			const GameConfig c = get_dataset().getBuffer(samples[b].buffer_index).getConfig();
-			if (not is_same_config(c, cfg))
-				throw std::runtime_error("GameConfig mismatch at " + std::to_string(b) + ", expected " + to_string(cfg) + ", got " + to_string(c));
-		}
-
-		const int rows = cfg.rows;
-		const int columns = cfg.cols;
-		SearchDataPack pack(rows, columns);
-		PatternCalculator calc(cfg);
-		NNInputFeatures features(rows, columns);
-
-		for (int b = 0; b < batch_size; b++)
-		{
-			const Sample_t sample = samples[b];
-
-			get_dataset().getBuffer(sample.buffer_index).getGameData(sample.game_index).getSample(pack, sample.sample_index);
-
-			const Symmetry s = int_to_symmetry(sample.augmentation);
-			assert(is_symmetry_allowed(s, pack.board.shape()));
-			ag::apply_symmetry_in_place(pack.board, s);
-			ag::apply_symmetry_in_place(pack.visit_count, s);
-			ag::apply_symmetry_in_place(pack.policy_prior, s);
-			ag::apply_symmetry_in_place(pack.action_values, s);
-			ag::apply_symmetry_in_place(pack.action_scores, s);
-
-			calc.setBoard(pack.board, pack.played_move.sign);
-			features.encode(calc);
-
-			const Value qt = convertOutcome(pack.game_outcome, pack.played_move.sign);
-			value_target[0] = qt.win_rate;
-			value_target[1] = qt.draw_rate;
-			value_target[2] = qt.loss_rate();
-
-			moves_left_target[0] = pack.moves_left;
-
-			float policy_sum = 0.0f;
-			for (int i = 0; i < rows * columns; i++)
-			{
-				uint32_t f = features[i];
-				for (int j = 0; j < 32; j++)
-				{
-					input[i * 32 + j] = (f & 1u) ? 1.0f : 0.0f;
-					f = (f >> 1u);
-				}
-
-				const Score score = pack.action_scores[i];
-				const Value value = score.isProven() ? score.convertToValue() : pack.action_values[i];
-
-				action_values_target[i * 3 + 0] = value.win_rate;
-				action_values_target[i * 3 + 1] = value.draw_rate;
-				action_values_target[i * 3 + 2] = value.loss_rate();
+		DatasetLoader &loader = get_loader(handle);
+		get_batch_config(loader.getDataset(), batch_size, samples);
+		loader.loadBatch(batch_size, samples, input_dtype, target_dtype, input, policy_target, value_target, moves_left_target, action_values_target);
+	}
+	void augment_batch(LoaderHandle_t handle, int batch_size, const Sample_t *samples, DataType_t input_dtype, DataType_t target_dtype, void *input,
+			void *policy_target, void *action_values_target)
+	{
+		assert(samples != nullptr);
+		assert(input != nullptr);
+		assert(policy_target != nullptr);
+		assert(action_values_target != nullptr);
 
-				switch (score.getProvenValue())
-				{
-					case ProvenValue::LOSS:
-						policy_target[i] = 1.0e-6f;
-						break;
-					case ProvenValue::DRAW:
-						policy_target[i] = std::max(1, pack.visit_count[i]);
-						break;
-					default:
-					case ProvenValue::UNKNOWN:
-						policy_target[i] = pack.visit_count[i];
-						break;
-					case ProvenValue::WIN:
-						policy_target[i] = 1.0e+6f;
-						break;
-				}
-				policy_sum += policy_target[i];
-			}
-			const float tmp = 1.0f / policy_sum;
-			for (int i = 0; i < rows * columns; i++)
-				policy_target[i] *= tmp;
-
-			input += 32 * rows * columns;
-			policy_target += rows * columns;
-			value_target += 3;
-			moves_left_target += 1;
-		}
+		if (target_dtype == DTYPE_UINT8)
+			throw std::invalid_argument("augment_batch() : targets cannot be stored as uint8");
+		if (batch_size <= 0)
+			return;
+		DatasetLoader &loader = get_loader(handle);
+		get_batch_config(loader.getDataset(), batch_size, samples);
+		loader.augmentBatch(batch_size, samples, input_dtype, target_dtype, input, policy_target, action_values_target);
 	}
 
 } /* namespace ag */
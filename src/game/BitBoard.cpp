@@ -0,0 +1,275 @@
+/*
+ * BitBoard.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/game/BitBoard.hpp>
+#include <alphagomoku/utils/math_utils.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+	using namespace ag;
+
+	/*
+	 * \brief Sets bits of all 'length' stones of the lines starting at the given bits.
+	 */
+	BitPlane spread(const BitPlane &lineStarts, int offset, int length) noexcept
+	{
+		BitPlane result = lineStarts;
+		for (int i = 1; i < length; i++)
+			result = result | (lineStarts << (i * offset));
+		return result;
+	}
+	/*
+	 * \brief Returns bits at which a line of at least five stones begins.
+	 */
+	BitPlane get_five_starts(const BitPlane &stones, int offset) noexcept
+	{
+		BitPlane result = stones;
+		for (int i = 1; i < 5; i++)
+			result = result & (result >> offset); // extends every line by one stone
+		return result;
+	}
+	/*
+	 * \brief Returns bits at which a line of exactly five stones begins.
+	 */
+	BitPlane get_exact_five_starts(const BitPlane &stones, const BitPlane &fiveStarts, int offset) noexcept
+	{
+		return andNot(andNot(fiveStarts, stones << offset), stones >> (5 * offset));
+	}
+	/*
+	 * \brief Returns bits at which a line of exactly five stones, that is not blocked by the opponent on both ends, begins.
+	 */
+	BitPlane get_unblocked_five_starts(const BitPlane &opponent, const BitPlane &exactFiveStarts, int offset) noexcept
+	{
+		return andNot(exactFiveStarts, (opponent << offset) & (opponent >> (5 * offset)));
+	}
+	struct Line
+	{
+			uint32_t own = 0;
+			uint32_t opponent = 0;
+	};
+	/*
+	 * \brief Gathers stones on the line of 11 cells centered at the move (bit 5 is the move itself).
+	 * The move is always treated as placed. Cells outside the board are empty on both masks.
+	 */
+	Line get_line(const BitBoard &board, Move move, int direction) noexcept
+	{
+		const BitPlane &own = board.get(move.sign);
+		const BitPlane &opponent = board.get(invertSign(move.sign));
+		const int idx = BitBoard::index(move.row, move.col);
+		const int offset = BitBoard::offset(direction);
+		Line result;
+		for (int i = -5; i <= 5; i++)
+		{
+			const int tmp = idx + i * offset;
+			if (0 <= tmp and tmp < BitPlane::size)
+			{
+				result.own |= static_cast<uint32_t>(own.get(tmp)) << (5 + i);
+				result.opponent |= static_cast<uint32_t>(opponent.get(tmp)) << (5 + i);
+			}
+		}
+		result.own |= (1u << 5);
+		result.opponent &= ~(1u << 5);
+		return result;
+	}
+	bool is_a_win(GameRules rules, Sign sign, Line line) noexcept
+	{
+		const int right = __builtin_ctz(~(line.own >> 5)); // number of stones starting from the move (inclusive)
+		const int left = __builtin_clz(~(line.own << 27)); // number of stones just before the move
+		const int length = left + right;
+		if (length < 5)
+			return false;
+		const bool left_blocked = (left < 5) and ((line.opponent >> (4 - left)) & 1u);
+		const bool right_blocked = (line.opponent >> (5 + right)) & 1u;
+		switch (rules)
+		{
+			case GameRules::FREESTYLE:
+				return true;
+			case GameRules::STANDARD:
+				return length == 5;
+			case GameRules::RENJU:
+				return (sign == Sign::CIRCLE) or (length == 5);
+			case GameRules::CARO5:
+				return (length == 5) and not (left_blocked and right_blocked);
+			case GameRules::CARO6:
+				return (length > 5) or not (left_blocked and right_blocked);
+			default:
+				return false;
+		}
+	}
+	bool is_overline(Line line) noexcept
+	{
+		return __builtin_ctz(~(line.own >> 5)) + __builtin_clz(~(line.own << 27)) > 5;
+	}
+	/*
+	 * \brief Checks if the move can possibly be a fork. This is only a fast filter for the expensive check for forbidden moves.
+	 */
+	bool may_be_a_fork(const std::array<Line, 4> &lines) noexcept
+	{
+		int directions_with_two = 0;
+		for (int dir = 0; dir < 4; dir++)
+		{
+			const int count = popcount(lines[dir].own & 0x3DEu); // own stones at distance 1 to 4 from the move
+			if (count >= 3) // there can be two fours in a single line
+				return true;
+			directions_with_two += (count >= 2);
+		}
+		return directions_with_two >= 2;
+	}
+}
+
+namespace ag
+{
+	int BitPlane::count() const noexcept
+	{
+		int result = 0;
+		for (size_t i = 0; i < m_data.size(); i++)
+			result += popcount(m_data[i]);
+		return result;
+	}
+	BitPlane BitPlane::operator<<(int shift) const noexcept
+	{
+		assert(shift >= 0);
+		const int words = shift / 64;
+		const int bits = shift % 64;
+		BitPlane result;
+		for (int i = 7; i >= words; i--)
+		{
+			result.m_data[i] = m_data[i - words] << bits;
+			if (bits != 0 and i - words - 1 >= 0)
+				result.m_data[i] |= m_data[i - words - 1] >> (64 - bits);
+		}
+		return result;
+	}
+	BitPlane BitPlane::operator>>(int shift) const noexcept
+	{
+		assert(shift >= 0);
+		const int words = shift / 64;
+		const int bits = shift % 64;
+		BitPlane result;
+		for (int i = 0; i + words < 8; i++)
+		{
+			result.m_data[i] = m_data[i + words] >> bits;
+			if (bits != 0 and i + words + 1 < 8)
+				result.m_data[i] |= m_data[i + words + 1] << (64 - bits);
+		}
+		return result;
+	}
+
+	BitBoard::BitBoard(int rows, int columns) :
+			m_rows(rows),
+			m_columns(columns)
+	{
+		if (rows > max_size or columns > max_size)
+			throw std::logic_error("BitBoard supports boards up to " + std::to_string(max_size) + "x" + std::to_string(max_size));
+	}
+	BitBoard::BitBoard(const matrix<Sign> &board) :
+			BitBoard(board.rows(), board.cols())
+	{
+		for (int row = 0; row < board.rows(); row++)
+			for (int col = 0; col < board.cols(); col++)
+				if (board.at(row, col) != Sign::NONE)
+					putMove(Move(row, col, board.at(row, col)));
+	}
+	void BitBoard::clear() noexcept
+	{
+		m_cross = BitPlane();
+		m_circle = BitPlane();
+	}
+	int BitBoard::numberOfMoves() const noexcept
+	{
+		return m_cross.count() + m_circle.count();
+	}
+	bool BitBoard::isFull() const noexcept
+	{
+		return numberOfMoves() == rows() * cols();
+	}
+	matrix<Sign> BitBoard::toMatrix() const
+	{
+		matrix<Sign> result(rows(), cols());
+		for (int row = 0; row < rows(); row++)
+			for (int col = 0; col < cols(); col++)
+				result.at(row, col) = at(row, col);
+		return result;
+	}
+	BitPlane BitBoard::getWinningLines(GameRules rules, Sign sign, int direction) const noexcept
+	{
+		const BitPlane &stones = get(sign);
+		const int offset = BitBoard::offset(direction);
+		const BitPlane five_starts = get_five_starts(stones, offset);
+		switch (rules)
+		{
+			case GameRules::FREESTYLE:
+				return spread(five_starts, offset, 5);
+			case GameRules::STANDARD:
+				return spread(get_exact_five_starts(stones, five_starts, offset), offset, 5);
+			case GameRules::RENJU:
+				if (sign == Sign::CROSS)
+					return spread(get_exact_five_starts(stones, five_starts, offset), offset, 5);
+				else
+					return spread(five_starts, offset, 5);
+			case GameRules::CARO5:
+			{
+				const BitPlane exact_five_starts = get_exact_five_starts(stones, five_starts, offset);
+				return spread(get_unblocked_five_starts(get(invertSign(sign)), exact_five_starts, offset), offset, 5);
+			}
+			case GameRules::CARO6:
+			{ // overline always wins, while exactly five stones must not be blocked on both ends
+				const BitPlane exact_five_starts = get_exact_five_starts(stones, five_starts, offset);
+				const BitPlane six_starts = five_starts & (five_starts >> offset);
+				return spread(get_unblocked_five_starts(get(invertSign(sign)), exact_five_starts, offset), offset, 5)
+						| spread(six_starts, offset, 6);
+			}
+			default:
+				return BitPlane();
+		}
+	}
+	BitPlane BitBoard::getWinningLines(GameRules rules, Sign sign) const noexcept
+	{
+		BitPlane result;
+		for (int dir = 0; dir < 4; dir++)
+			result = result | getWinningLines(rules, sign, dir);
+		return result;
+	}
+	BitPlane BitBoard::getOverlines(Sign sign, int direction) const noexcept
+	{
+		const int offset = BitBoard::offset(direction);
+		const BitPlane five_starts = get_five_starts(get(sign), offset);
+		return spread(five_starts & (five_starts >> offset), offset, 6);
+	}
+
+	GameOutcome getOutcome(GameRules rules, const BitBoard &board, Move lastMove, int numberOfMovesForDraw)
+	{
+		if (not board.isInside(lastMove.row, lastMove.col))
+			return GameOutcome::UNKNOWN;
+		assert(lastMove.sign != Sign::NONE);
+
+		std::array<Line, 4> lines;
+		for (int dir = 0; dir < 4; dir++)
+		{
+			lines[dir] = get_line(board, lastMove, dir);
+			if (is_a_win(rules, lastMove.sign, lines[dir]))
+				return (lastMove.sign == Sign::CROSS) ? GameOutcome::CROSS_WIN : GameOutcome::CIRCLE_WIN;
+		}
+
+		if (rules == GameRules::RENJU and lastMove.sign == Sign::CROSS)
+		{
+			for (int dir = 0; dir < 4; dir++)
+				if (is_overline(lines[dir]))
+					return GameOutcome::CIRCLE_WIN;
+			// forks must be checked using patterns, but most moves are quickly filtered out here
+			if (may_be_a_fork(lines) and isForbidden(board.toMatrix(), lastMove))
+				return GameOutcome::CIRCLE_WIN;
+		}
+
+		const bool is_draw = (numberOfMovesForDraw > 0) ? (board.numberOfMoves() >= numberOfMovesForDraw) : board.isFull();
+		return is_draw ? GameOutcome::DRAW : GameOutcome::UNKNOWN;
+	}
+
+} /* namespace ag */
@@ -22,12 +22,14 @@ namespace ag
 	Game::Game(GameConfig config) :
 			game_config(config),
 			played_moves(),
-			current_board(config.rows, config.cols)
+			current_board(config.rows, config.cols),
+			bit_board(config.rows, config.cols)
 	{
 	}
 	Game::Game(const Json &json, const SerializedObject &binary_data) :
 			game_config(json["game_config"]),
-			current_board(game_config.rows, game_config.cols)
+			current_board(game_config.rows, game_config.cols),
+			bit_board(game_config.rows, game_config.cols)
 	{
 		const size_t nb_of_moves = json["moves"].size();
 		for (size_t i = 0; i < nb_of_moves; i++)
@@ -55,6 +57,7 @@ namespace ag
 	{
 		played_moves.clear();
 		current_board.clear();
+		bit_board.clear();
 	}
 	void Game::loadOpening(const std::vector<Move> &moves)
 	{
@@ -96,6 +99,7 @@ namespace ag
 		assert(move == getLastMove());
 
 		Board::undoMove(current_board, move);
+		bit_board.undoMove(move);
 		played_moves.pop_back();
 	}
 	void Game::makeMove(Move move)
@@ -103,6 +107,7 @@ namespace ag
 		assert(move.sign == getSignToMove());
 
 		Board::putMove(current_board, move);
+		bit_board.putMove(move);
 		played_moves.push_back(move);
 	}
 
@@ -112,11 +117,11 @@ namespace ag
 	}
 	bool Game::isDraw() const
 	{
-		return Board::numberOfMoves(current_board) >= game_config.draw_after;
+		return bit_board.numberOfMoves() >= game_config.draw_after;
 	}
 	GameOutcome Game::getOutcome() const noexcept
 	{
-		return ag::getOutcome(game_config.rules, current_board, getLastMove(), game_config.draw_after);
+		return ag::getOutcome(game_config.rules, bit_board, getLastMove(), game_config.draw_after);
 	}
 	void Game::setPlayerNames(const std::string &crossPlayerName, const std::string &circlePlayerName)
 	{
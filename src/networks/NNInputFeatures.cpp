@@ -8,6 +8,13 @@
 #include <alphagomoku/networks/NNInputFeatures.hpp>
 #include <alphagomoku/patterns/PatternCalculator.hpp>
 #include <alphagomoku/utils/augmentations.hpp>
+#include <alphagomoku/utils/board_size.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <x86intrin.h>
 
 namespace
 {
@@ -30,6 +37,38 @@ namespace
 		else
 			return (result1 << 20u) | (result2 << 8u);
 	}
+#ifdef __AVX2__
+	/*
+	 * \brief Vectorized version of 'encode_patterns' for four consecutive spots, each stored in 64-bit element of the input.
+	 * Returns encoded features of those spots in 32-bit elements.
+	 */
+	__m128i encode_patterns(__m256i patterns, Sign ownSign) noexcept
+	{
+		static_assert(sizeof(TwoPlayerGroup<DirectionGroup<PatternType>>) == 8);
+		const __m256i open_3 = _mm256_set1_epi8(static_cast<char>(PatternType::OPEN_3));
+		const __m256i half_open_4 = _mm256_set1_epi8(static_cast<char>(PatternType::HALF_OPEN_4));
+		const __m256i direction_bits = _mm256_set1_epi32(0x08040201);
+		const __m256i isotropic_table = _mm256_setr_epi8(0, 0, 0, 0, 1, 2, 4, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 0, 0, 0, 0, 0, 0, 0, 0);
+
+		// each byte holds pattern type in one direction, so the features can be calculated for all of them at once
+		__m256i directional = _mm256_and_si256(_mm256_cmpeq_epi8(patterns, open_3), direction_bits);
+		directional = _mm256_or_si256(directional, _mm256_and_si256(_mm256_cmpeq_epi8(patterns, half_open_4), _mm256_slli_epi32(direction_bits, 4)));
+		__m256i isotropic = _mm256_shuffle_epi8(isotropic_table, patterns);
+
+		// now the features from four directions (bytes) are merged, separately for each player
+		directional = _mm256_or_si256(directional, _mm256_srli_epi32(directional, 8));
+		directional = _mm256_or_si256(directional, _mm256_srli_epi32(directional, 16));
+		isotropic = _mm256_or_si256(isotropic, _mm256_srli_epi32(isotropic, 8));
+		isotropic = _mm256_or_si256(isotropic, _mm256_srli_epi32(isotropic, 16));
+		__m256i result = _mm256_or_si256(_mm256_and_si256(directional, _mm256_set1_epi32(255)), _mm256_slli_epi32(_mm256_and_si256(isotropic, _mm256_set1_epi32(15)), 8));
+
+		// features of cross are in lower half of each 64-bit element, features of circle are in upper half
+		const __m256i shifts = (ownSign == Sign::CROSS) ? _mm256_setr_epi32(8, 20, 8, 20, 8, 20, 8, 20) : _mm256_setr_epi32(20, 8, 20, 8, 20, 8, 20, 8);
+		result = _mm256_sllv_epi32(result, shifts);
+		result = _mm256_or_si256(result, _mm256_srli_epi64(result, 32));
+		return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(result, _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0)));
+	}
+#endif
 	template<int D0, int D1, int D2, int D3>
 	uint32_t shuffle_directions(const uint32_t data) noexcept
 	{
@@ -48,6 +87,32 @@ namespace
 		result |= (((data >> D3) & mask) << 3);
 		return result;
 	}
+	/*
+	 * \brief Changes the perspective of encoded features to the other side to move (swaps own and opponent features).
+	 * Forbidden moves are cleared as they are only valid for one side.
+	 */
+	uint32_t swap_sides(const uint32_t data) noexcept
+	{
+		uint32_t result = data & 0x00000089; // legal move, ones and zeros do not change
+		result |= ((data & 0x00000002) << 1) | ((data & 0x00000004) >> 1); // own and opponent stone
+		result |= ((data & 0x00000010) << 1) | ((data & 0x00000020) >> 1); // cross and circle to move
+		result |= ((data & 0x000FFF00) << 12) | ((data >> 12) & 0x000FFF00); // own and opponent patterns
+		return result;
+	}
+#ifdef __AVX2__
+	/*
+	 * \brief Vectorized version of 'swap_sides' for eight consecutive spots.
+	 */
+	__m256i swap_sides(__m256i data) noexcept
+	{
+		__m256i result = _mm256_and_si256(data, _mm256_set1_epi32(0x00000089));
+		result = _mm256_or_si256(result, _mm256_slli_epi32(_mm256_and_si256(data, _mm256_set1_epi32(0x00000012)), 1));
+		result = _mm256_or_si256(result, _mm256_srli_epi32(_mm256_and_si256(data, _mm256_set1_epi32(0x00000024)), 1));
+		result = _mm256_or_si256(result, _mm256_slli_epi32(_mm256_and_si256(data, _mm256_set1_epi32(0x000FFF00)), 12));
+		result = _mm256_or_si256(result, _mm256_and_si256(_mm256_srli_epi32(data, 12), _mm256_set1_epi32(0x000FFF00)));
+		return result;
+	}
+#endif
 }
 
 namespace ag
@@ -89,20 +154,11 @@ namespace ag
 		 *  31		1	opponent overline
 		 */
 		const Sign own_sign = calc.getSignToMove();
-
-		const uint32_t table[4] = { 1u, (own_sign == Sign::CROSS) ? 2u : 4u, (own_sign == Sign::CROSS) ? 4u : 2u, 0u };
-		const uint32_t ones = 1u << 3u;
-		const uint32_t color_to_move = (own_sign == Sign::CROSS) ? (1u << 4u) : (1u << 5u);
 		const uint32_t forbidden = 1u << 6u;
 
-		for (int row = 0; row < rows(); row++)
-			for (int col = 0; col < cols(); col++)
-			{
-				uint32_t tmp = color_to_move | ones; // base value
-				tmp |= table[static_cast<int>(calc.signAt(row, col))];
-				tmp |= encode_patterns(calc.getPatternsAt(row, col), own_sign);
-				this->at(row, col) = tmp;
-			}
+		dispatchBoardSize(rows(), cols(), [&](auto boardSize)
+		{	this->encode_board<decltype(boardSize)::value>(calc);});
+
 		if (calc.getConfig().rules == GameRules::RENJU and own_sign == Sign::CROSS)
 		{
 			for (int row = 0; row < rows(); row++)
@@ -111,11 +167,61 @@ namespace ag
 						this->at(row, col) |= forbidden;
 		}
 	}
+	void NNInputFeatures::update(PatternCalculator &calc)
+	{
+		assert(rows() == calc.getConfig().rows);
+		assert(cols() == calc.getConfig().cols);
+		assert(calc.getSignToMove() != Sign::NONE);
+
+		const Sign own_sign = calc.getSignToMove();
+
+		const uint32_t table[4] = { 1u, (own_sign == Sign::CROSS) ? 2u : 4u, (own_sign == Sign::CROSS) ? 4u : 2u, 0u };
+		const uint32_t ones = 1u << 3u;
+		const uint32_t color_to_move = (own_sign == Sign::CROSS) ? (1u << 4u) : (1u << 5u);
+		const uint32_t forbidden = 1u << 6u;
+
+		// side to move has changed so the whole board must be switched to the other perspective, but this is just a permutation of bits
+		int i = 0;
+#ifdef __AVX2__
+		for (; i + 8 <= size(); i += 8)
+			_mm256_storeu_si256((__m256i*) (data() + i), swap_sides(_mm256_loadu_si256((const __m256i*) (data() + i))));
+#endif
+		for (; i < size(); i++)
+			data()[i] = swap_sides(data()[i]);
+
+		// calculator reports every spot at which patterns could have changed (including the spot of the move itself)
+		const Location move_location = calc.getChangeOfMoves().location;
+		this->at(move_location.row, move_location.col) = color_to_move | ones | table[static_cast<int>(calc.signAt(move_location.row, move_location.col))]
+				| encode_patterns(calc.getPatternsAt(move_location.row, move_location.col), own_sign);
+		for (auto iter = calc.getChangeOfThreats().begin(); iter < calc.getChangeOfThreats().end(); iter++)
+		{
+			const Location loc = iter->location;
+			this->at(loc.row, loc.col) = color_to_move | ones | table[static_cast<int>(calc.signAt(loc.row, loc.col))]
+					| encode_patterns(calc.getPatternsAt(loc.row, loc.col), own_sign);
+		}
+
+		if (calc.getConfig().rules == GameRules::RENJU and own_sign == Sign::CROSS)
+		{ // only spots with overline or some fork can be forbidden, and those are already listed in the threat histogram
+			// the locations must be copied because checking for forbidden 3x3 adds and removes moves, which reorders the histogram
+			forbidden_candidates.clear();
+			for (ThreatType tt : { ThreatType::FORK_3x3, ThreatType::FORK_4x4, ThreatType::OVERLINE })
+			{
+				const LocationList &threats = calc.getThreatHistogram(Sign::CROSS).get(tt);
+				forbidden_candidates.insert(forbidden_candidates.end(), threats.begin(), threats.end());
+			}
+			for (auto iter = forbidden_candidates.begin(); iter < forbidden_candidates.end(); iter++)
+				if (calc.isForbidden(Sign::CROSS, iter->row, iter->col))
+					this->at(iter->row, iter->col) |= forbidden;
+		}
+	}
 	void NNInputFeatures::augment(int mode) noexcept
 	{
 		ag::apply_symmetry_in_place(*this, int_to_symmetry(mode));
-
-		// now we have to shuffle bits 8-11, 12-15, 20-23, 24-17 because their values depend on direction
+		augment_feature_directions(this->data(), this->size(), mode);
+	}
+	void augment_feature_directions(uint32_t *features, int size, int mode) noexcept
+	{
+		// we have to shuffle bits 8-11, 12-15, 20-23, 24-17 because their values depend on direction
 		switch (mode)
 		{
 			case 0:
@@ -125,8 +231,8 @@ namespace ag
 			case 2: // reflect y
 			case -2:
 			{ // horizontal and vertical stays the same, diagonals are swapped
-				for (int i = 0; i < this->size(); i++)
-					this->operator [](i) = shuffle_directions<0, 1, 3, 2>(this->operator [](i));
+				for (int i = 0; i < size; i++)
+					features[i] = shuffle_directions<0, 1, 3, 2>(features[i]);
 				break;
 			}
 			case 3: // rotate 180 degrees
@@ -137,8 +243,8 @@ namespace ag
 			case 5: // reflect antidiagonal
 			case -5:
 			{ // horizontal and vertical are swapped, diagonals stays the same
-				for (int i = 0; i < this->size(); i++)
-					this->operator [](i) = shuffle_directions<1, 0, 2, 3>(this->operator [](i));
+				for (int i = 0; i < size; i++)
+					features[i] = shuffle_directions<1, 0, 2, 3>(features[i]);
 				break;
 			}
 			case 6: // rotate 90 degrees
@@ -146,12 +252,100 @@ namespace ag
 			case 7: // rotate 270 degrees
 			case -6:
 			{ // horizontal and vertical are swapped, diagonals are swapped too
-				for (int i = 0; i < this->size(); i++)
-					this->operator [](i) = shuffle_directions<1, 0, 3, 2>(this->operator [](i));
+				for (int i = 0; i < size; i++)
+					features[i] = shuffle_directions<1, 0, 3, 2>(features[i]);
 				break;
 			}
 		}
 	}
 
+	/*
+	 * private
+	 */
+	template<int N>
+	void NNInputFeatures::encode_board(const PatternCalculator &calc)
+	{
+		const int rows = get_board_size<N>(this->rows());
+		const int cols = get_board_size<N>(this->cols());
+		const Sign own_sign = calc.getSignToMove();
+		const Sign *board_ptr = calc.getBoard().data();
+		const TwoPlayerGroup<DirectionGroup<PatternType>> *patterns_ptr = &calc.getPatternsAt(0, 0);
+
+		const uint32_t table[4] = { 1u, (own_sign == Sign::CROSS) ? 2u : 4u, (own_sign == Sign::CROSS) ? 4u : 2u, 0u };
+		const uint32_t ones = 1u << 3u;
+		const uint32_t color_to_move = (own_sign == Sign::CROSS) ? (1u << 4u) : (1u << 5u);
+
+#ifdef __AVX2__
+		for (int row = 0; row < rows; row++)
+			for (int col = 0; col < cols; col += 4)
+			{
+				const int idx = row * cols + col;
+				const int elements = std::min(4, cols - col);
+				const __m256i load_mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(elements), _mm256_setr_epi64x(0, 1, 2, 3));
+				const __m256i patterns = _mm256_maskload_epi64(reinterpret_cast<const long long*>(patterns_ptr + idx), load_mask);
+
+				uint32_t base[4] = { 0u, 0u, 0u, 0u };
+				for (int i = 0; i < elements; i++)
+					base[i] = color_to_move | ones | table[static_cast<int>(board_ptr[idx + i])];
+				const __m128i tmp = _mm_or_si128(_mm_loadu_si128((const __m128i*) base), encode_patterns(patterns, own_sign));
+				if (elements == 4)
+					_mm_storeu_si128((__m128i*) (data() + idx), tmp);
+				else
+					_mm_maskstore_epi32(reinterpret_cast<int*>(data() + idx), _mm_cmpgt_epi32(_mm_set1_epi32(elements), _mm_setr_epi32(0, 1, 2, 3)), tmp);
+			}
+#else
+		for (int idx = 0; idx < rows * cols; idx++)
+		{
+			uint32_t tmp = color_to_move | ones; // base value
+			tmp |= table[static_cast<int>(board_ptr[idx])];
+			tmp |= encode_patterns(patterns_ptr[idx], own_sign);
+			data()[idx] = tmp;
+		}
+#endif
+	}
+
+	NNInputFeaturesEncoder::NNInputFeaturesEncoder(const GameConfig &cfg) :
+			game_config(cfg)
+	{
+	}
+	NNInputFeaturesEncoder::~NNInputFeaturesEncoder() = default;
+	void NNInputFeaturesEncoder::encode(const std::vector<matrix<Sign>> &boards, const std::vector<Sign> &signsToMove, uint32_t *dst,
+			int numberOfThreads)
+	{
+		if (boards.size() != signsToMove.size())
+			throw std::logic_error("NNInputFeaturesEncoder::encode() : number of boards does not match number of signs to move");
+		const int batch_size = static_cast<int>(boards.size());
+		const int num_threads = std::max(1, std::min(numberOfThreads, batch_size));
+		while (static_cast<int>(pattern_calculators.size()) < num_threads)
+		{
+			pattern_calculators.push_back(std::make_unique<PatternCalculator>(game_config));
+			input_features.push_back(NNInputFeatures(game_config.rows, game_config.cols));
+		}
+
+		// the calling thread also takes part in encoding, processing the first range
+		std::vector<std::future<void>> futures;
+		for (int i = 1; i < num_threads; i++)
+			futures.push_back(std::async(std::launch::async, [&, i]()
+			{	encode_range(i, i * batch_size / num_threads, (i + 1) * batch_size / num_threads, boards, signsToMove, dst);}));
+		encode_range(0, 0, batch_size / num_threads, boards, signsToMove, dst);
+		for (size_t i = 0; i < futures.size(); i++)
+			futures[i].get();
+	}
+	/*
+	 * private
+	 */
+	void NNInputFeaturesEncoder::encode_range(int threadIndex, int begin, int end, const std::vector<matrix<Sign>> &boards,
+			const std::vector<Sign> &signsToMove, uint32_t *dst)
+	{
+		PatternCalculator &calc = *pattern_calculators[threadIndex];
+		NNInputFeatures &features = input_features[threadIndex];
+		for (int i = begin; i < end; i++)
+		{
+			calc.setBoard(boards[i], signsToMove[i]);
+			features.encode(calc);
+			std::memcpy(dst + i * features.size(), features.data(), features.sizeInBytes());
+		}
+	}
+
 } /* namespace ag */
 
@@ -57,6 +57,10 @@ namespace
 	{
 		return ag::Value(f.x, f.y);
 	}
+	bool is_spatial(char key) noexcept
+	{ // moves left is not spatial even though it has 'rows * cols' elements
+		return key == 'p' or key == 's' or key == 'q';
+	}
 }
 
 namespace ag
@@ -139,6 +143,13 @@ namespace ag
 		assert(0 <= index && index < getBatchSize());
 		std::memcpy(get_pointer(input_on_cpu, { index, 0, 0, 0 }), features.data(), features.sizeInBytes());
 	}
+	void NetworkDataPack::packInputData(const std::vector<matrix<Sign>> &boards, const std::vector<Sign> &signsToMove, int numberOfThreads)
+	{
+		assert(static_cast<int>(boards.size()) <= getBatchSize());
+		if (features_encoder == nullptr)
+			features_encoder = std::make_unique<NNInputFeaturesEncoder>(game_config);
+		features_encoder->encode(boards, signsToMove, reinterpret_cast<uint32_t*>(get_pointer(input_on_cpu, { 0, 0, 0, 0 })), numberOfThreads);
+	}
 
 	void NetworkDataPack::packPolicyTarget(int index, const matrix<float> &target)
 	{
@@ -197,6 +208,39 @@ namespace ag
 		tensor.at( { index, target }) = 1.0f;
 	}
 
+	void NetworkDataPack::augment(const std::vector<Symmetry> &symmetries, const std::string &targets, const std::string &masks)
+	{
+		assert(static_cast<int>(symmetries.size()) <= getBatchSize());
+		if (std::all_of(symmetries.begin(), symmetries.end(), [](Symmetry s)
+		{	return s == Symmetry::IDENTITY;}))
+			return;
+		const MatrixShape shape(game_config.rows, game_config.cols);
+
+		uint32_t *input = reinterpret_cast<uint32_t*>(get_pointer(input_on_cpu, { 0, 0, 0, 0 }));
+		apply_symmetry_to_batch(input, sizeof(uint32_t), SymmetryIndexTable::getShared(shape), symmetries, augmentation_workspace);
+		for (size_t b = 0; b < symmetries.size(); b++)
+			if (symmetries[b] != Symmetry::IDENTITY)
+				augment_feature_directions(input + b * shape.rows * shape.cols, shape.rows * shape.cols, static_cast<int>(symmetries[b]));
+
+		auto augment_tensors = [&](TensorMap &tensors, const std::string &keys)
+		{
+			for (size_t i = 0; i < keys.size(); i++)
+			{
+				if (not is_spatial(keys[i]))
+					throw std::logic_error("NetworkDataPack::augment() : tensor '" + std::string(1, keys[i]) + "' is not spatial");
+				if (tensors.contains_key(keys[i])) // tensors are allocated on first use, so there is nothing to transform yet
+				{
+					ml::Tensor &t = tensors.get(keys[i]);
+					const int channels = t.volume() / (getBatchSize() * shape.rows * shape.cols);
+					apply_symmetry_to_batch(t.data(), ml::sizeOf(t.dtype()), SymmetryIndexTable::getShared(shape, channels), symmetries,
+							augmentation_workspace);
+				}
+			}
+		};
+		augment_tensors(targets_on_cpu, targets);
+		augment_tensors(masks_on_cpu, masks);
+	}
+
 	void NetworkDataPack::unpackPolicy(int index, matrix<float> &policy) const
 	{
 		assert(0 <= index && index < getBatchSize());
@@ -8,6 +8,7 @@
 #include <alphagomoku/patterns/PatternCalculator.hpp>
 #include <alphagomoku/patterns/Pattern.hpp>
 #include <alphagomoku/game/Board.hpp>
+#include <alphagomoku/utils/board_size.hpp>
 #include <alphagomoku/utils/configs.hpp>
 #include <alphagomoku/utils/misc.hpp>
 
@@ -15,6 +16,7 @@
 #include <algorithm>
 #include <numeric>
 #include <cstring>
+#include <cstdlib>
 #include <cassert>
 
 namespace ag
@@ -26,6 +28,7 @@ namespace ag
 			raw_patterns(gameConfig.rows, gameConfig.cols),
 			pattern_types(gameConfig.rows, gameConfig.cols),
 			threat_types(gameConfig.rows, gameConfig.cols),
+			forbidden_3x3_cache(gameConfig.rows, gameConfig.cols),
 			pattern_table(&PatternTable::get(gameConfig.rules)),
 			threat_table(&ThreatTable::get(gameConfig.rules)),
 			defensive_move_table(&DefensiveMoveTable::get(gameConfig.rules)),
@@ -53,17 +56,25 @@ namespace ag
 				else
 					current_depth++;
 
-//		features_init.startTimer();
+		features_init.startTimer();
 		raw_patterns.set(internal_board);
-//		features_init.stopTimer();
+		features_init.stopTimer();
 
-//		features_class.startTimer();
-		classify_feature_types();
-//		features_class.stopTimer();
-
-//		threats_init.startTimer();
-		prepare_threat_lists();
-//		threats_init.stopTimer();
+		dispatchBoardSize(game_config.rows, game_config.cols, [this](auto boardSize)
+		{
+			constexpr int N = decltype(boardSize)::value;
+			features_class.startTimer();
+			this->classify_feature_types<N>();
+			features_class.stopTimer();
+
+			threats_init.startTimer();
+			this->prepare_threat_lists<N>();
+			threats_init.stopTimer();
+		});
+
+		forbidden_3x3_cache.clear();
+		cached_3x3_checks.clear();
+		probe_depth = 0;
 	}
 	void PatternCalculator::addMove(Move move) noexcept
 	{
@@ -77,9 +88,9 @@ namespace ag
 		raw_patterns.addMove(move);
 //		features_update.stopTimer();
 
-//		threats_update.startTimer();
+		threats_update.startTimer();
 		update_around(move.row, move.col, move.sign, ADD_MOVE);
-//		threats_update.stopTimer();
+		threats_update.stopTimer();
 
 		sign_to_move = invertSign(sign_to_move);
 		current_depth++;
@@ -96,9 +107,9 @@ namespace ag
 		raw_patterns.undoMove(move);
 //		features_update.stopTimer();
 
-//		threats_update.startTimer();
+		threats_update.startTimer();
 		update_around(move.row, move.col, move.sign, UNDO_MOVE);
-//		threats_update.stopTimer();
+		threats_update.stopTimer();
 
 		sign_to_move = invertSign(sign_to_move);
 		current_depth--;
@@ -210,8 +221,10 @@ namespace ag
 	/*
 	 * private
 	 */
-	bool PatternCalculator::is_3x3_forbidden(Sign sign, int row, int col) noexcept
+	int PatternCalculator::check_3x3_forbidden(Sign sign, int row, int col) noexcept
 	{
+		// promotion moves are within 'padding' from (row, col) and their threats depend on stones within next 'padding' spots
+		int radius = 2 * padding;
 		int open3_count = 0;
 		for (Direction dir = 0; dir < 4; dir++)
 			if (getPatternTypeAt(Sign::CROSS, row, col, dir) == PatternType::OPEN_3)
@@ -226,9 +239,19 @@ namespace ag
 								and RawPatternCalculator::isStraightFourAt(internal_board, Move(Sign::CROSS, loc), dir))
 						{ // minor optimization as 'isStraightFourAt' works without adding new move to the pattern calculator
 							Board::undoMove(internal_board, Move(row, col, Sign::CROSS));
+							probe_depth++;
 							addMove(Move(row, col, Sign::CROSS));
-							const bool is_forbidden = isForbidden(sign, loc.row, loc.col);
+							bool is_forbidden;
+							if (getThreatAt(Sign::CROSS, loc.row, loc.col) == ThreatType::FORK_3x3)
+							{ // our result depends on everything that the result of the recursive check depends on
+								const int tmp = check_3x3_forbidden(sign, loc.row, loc.col);
+								is_forbidden = (tmp > 0);
+								radius = std::max(radius, padding + std::abs(tmp));
+							}
+							else
+								is_forbidden = isForbidden(sign, loc.row, loc.col);
 							undoMove(Move(row, col, Sign::CROSS));
+							probe_depth--;
 							Board::putMove(internal_board, Move(row, col, Sign::CROSS));
 
 							if (not is_forbidden)
@@ -240,12 +263,58 @@ namespace ag
 					}
 				Board::undoMove(internal_board, Move(row, col, Sign::CROSS));
 			}
-		return open3_count >= 2;
+
+		radius = std::min(radius, 127);
+		return (open3_count >= 2) ? radius : -radius;
+	}
+	void PatternCalculator::invalidate_forbidden_cache(int row, int col) noexcept
+	{
+		for (size_t i = 0; i < cached_3x3_checks.size();)
+		{
+			const Location loc = cached_3x3_checks[i];
+			const int radius = std::abs(static_cast<int>(forbidden_3x3_cache.at(loc.row, loc.col)));
+			if (std::max(std::abs(loc.row - row), std::abs(loc.col - col)) <= radius)
+			{
+				forbidden_3x3_cache.at(loc.row, loc.col) = 0;
+				cached_3x3_checks[i] = cached_3x3_checks.back();
+				cached_3x3_checks.pop_back();
+			}
+			else
+				i++;
+		}
 	}
+	template<int N>
 	void PatternCalculator::classify_feature_types() noexcept
 	{
-		for (int row = 0; row < game_config.rows; row++)
-			for (int col = 0; col < game_config.cols; col++)
+		const int rows = get_board_size<N>(game_config.rows);
+		const int cols = get_board_size<N>(game_config.cols);
+#ifdef __AVX2__
+		// patterns are processed for four consecutive spots in a row at once, each spot in a separate 64-bit element
+		static_assert(sizeof(TwoPlayerGroup<DirectionGroup<PatternType>>) == 8 && sizeof(Sign) == 2);
+		const __m256i central_spot_mask = _mm256_set1_epi64x(3072u);
+		const __m256i nibble_mask = _mm256_set1_epi64x(0x0F0F0F0F);
+		for (int row = 0; row < rows; row++)
+			for (int col = 0; col < cols; col += 4)
+			{
+				const __m256i horizontal = raw_patterns.getNormalPatternsInRow<HORIZONTAL, N>(row, col);
+				const __m256i is_empty = _mm256_cmpeq_epi64(_mm256_and_si256(horizontal, central_spot_mask), _mm256_setzero_si256());
+
+				// pattern types of all directions are placed in consecutive bytes of each element
+				__m256i types = get_pattern_types(horizontal);
+				types = _mm256_or_si256(types, _mm256_slli_epi64(get_pattern_types(raw_patterns.getNormalPatternsInRow<VERTICAL, N>(row, col)), 8));
+				types = _mm256_or_si256(types, _mm256_slli_epi64(get_pattern_types(raw_patterns.getNormalPatternsInRow<DIAGONAL, N>(row, col)), 16));
+				types = _mm256_or_si256(types, _mm256_slli_epi64(get_pattern_types(raw_patterns.getNormalPatternsInRow<ANTIDIAGONAL, N>(row, col)), 24));
+				// then they are split into cross (lower nibbles) and circle (upper nibbles) parts
+				types = _mm256_or_si256(_mm256_and_si256(types, nibble_mask), _mm256_slli_epi64(_mm256_and_si256(_mm256_srli_epi64(types, 4), nibble_mask), 32));
+				types = _mm256_and_si256(types, is_empty); // occupied spots have no patterns
+
+				const int remaining = cols - col;
+				const __m256i store_mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(remaining), _mm256_setr_epi64x(0, 1, 2, 3));
+				_mm256_maskstore_epi64(reinterpret_cast<long long*>(pattern_types.data() + row * cols + col), store_mask, types);
+			}
+#else
+		for (int row = 0; row < rows; row++)
+			for (int col = 0; col < cols; col++)
 				if (signAt(row, col) == Sign::NONE)
 				{
 					for (Direction dir = 0; dir < 4; dir++)
@@ -257,31 +326,52 @@ namespace ag
 				}
 				else
 					pattern_types.at(row, col) = TwoPlayerGroup<DirectionGroup<PatternType>>();
+#endif
 	}
+#ifdef __AVX2__
+	__m256i PatternCalculator::get_pattern_types(__m256i patterns) const noexcept
+	{
+		// pattern types are stored in bits 48-55 of PatternInfo
+		return _mm256_and_si256(_mm256_srli_epi64(pattern_table->getPatternInfo(patterns), 48), _mm256_set1_epi64x(255));
+	}
+#endif
+	template<int N>
 	void PatternCalculator::prepare_threat_lists()
 	{
+		const int rows = get_board_size<N>(game_config.rows);
+		const int cols = get_board_size<N>(game_config.cols);
 		cross_threats.clear();
 		circle_threats.clear();
-		for (int row = 0; row < game_config.rows; row++)
-			for (int col = 0; col < game_config.cols; col++)
-				if (signAt(row, col) == Sign::NONE)
+		for (int row = 0; row < rows; row++)
+			for (int col = 0; col < cols; col++)
+			{
+				const int idx = row * cols + col; // all these matrices have the same shape
+				if (internal_board[idx] == Sign::NONE)
 				{
-					const ThreatEncoding threat = threat_table->getThreat(pattern_types.at(row, col));
-					threat_types.at(row, col) = threat;
+					const ThreatEncoding threat = threat_table->getThreat(pattern_types[idx]);
+					threat_types[idx] = threat;
 
 					cross_threats.add(threat.forCross(), Location(row, col));
 					circle_threats.add(threat.forCircle(), Location(row, col));
 				}
 				else
-					threat_types.at(row, col) = ThreatEncoding();
+					threat_types[idx] = ThreatEncoding();
+			}
 	}
 	void PatternCalculator::update_around(int row, int col, Sign s, UpdateMode mode) noexcept
 	{
 		assert(internal_board.isInside(row, col));
+		if (probe_depth == 0)
+			invalidate_forbidden_cache(row, col);
 
+		// single lookup per direction provides both update mask and (if the stone was removed) pattern types at the central spot
+		DirectionGroup<PatternInfo> central_info;
 		DirectionGroup<UpdateMask> update_mask;
 		for (Direction dir = 0; dir < 4; dir++)
-			update_mask[dir] = pattern_table->getUpdateMask(getNormalPatternAt(row, col, dir), s);
+		{
+			central_info[dir] = pattern_table->getPatternInfo(NormalPattern(getNormalPatternAt(row, col, dir) & ~3072u)); // central spot is not a part of the pattern
+			update_mask[dir] = central_info[dir].getUpdateMask(s);
+		}
 
 		if (mode == ADD_MOVE)
 		{ // a stone was added
@@ -302,7 +392,7 @@ namespace ag
 			assert(signAt(row, col) == Sign::NONE);
 			for (Direction dir = 0; dir < 4; dir++)
 			{
-				const PatternEncoding tmp = pattern_table->getPatternType(getNormalPatternAt(row, col, dir));
+				const PatternEncoding tmp = central_info[dir].getPatternType();
 				pattern_types.at(row, col).for_cross[dir] = tmp.forCross();
 				pattern_types.at(row, col).for_circle[dir] = tmp.forCircle();
 			}
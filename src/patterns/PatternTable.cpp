@@ -11,11 +11,17 @@
 #include <alphagomoku/utils/BitMask.hpp>
 #include <alphagomoku/utils/misc.hpp>
 #include <alphagomoku/utils/math_utils.hpp>
+#include <alphagomoku/utils/os_utils.hpp>
+#include <alphagomoku/utils/Logger.hpp>
+#include <alphagomoku/version.hpp>
 
 #include <iostream>
+#include <fstream>
 #include <cassert>
 #include <algorithm>
 #include <cstring>
+#include <mutex>
+#include <type_traits>
 
 namespace
 {
@@ -26,6 +32,68 @@ namespace
 		return ((pattern >> 1) & 0x55555555) | ((pattern & 0x55555555) << 1);
 	}
 
+	/*
+	 * Layout of the file with precomputed tables:
+	 *  - TableFileHeader
+	 *  - TableFileEntry for each rule
+	 *  - for each rule, starting at page-aligned offset: array of PatternInfo
+	 */
+	struct TableFileHeader
+	{
+			static constexpr char expected_magic[8] = { 'A', 'G', 'P', 'A', 'T', 'T', 'B', 'L' };
+			static constexpr uint32_t current_format = 2; // must be incremented whenever the layout or the classification of patterns changes
+
+			char magic[8];
+			uint32_t format;
+			uint32_t program_version; // tables from other versions are not trusted, as the classification of patterns may have changed
+			uint32_t pattern_length;
+			uint32_t number_of_tables;
+
+			static uint32_t get_program_version() noexcept
+			{
+				return (Version::major << 16) | (Version::minor << 8) | Version::revision;
+			}
+			bool is_valid() const noexcept
+			{
+				return std::memcmp(magic, expected_magic, sizeof(magic)) == 0 and format == current_format
+						and program_version == get_program_version() and pattern_length == Pattern::length;
+			}
+	};
+	struct TableFileEntry
+	{
+			uint32_t rules;
+			uint32_t number_of_patterns;
+			uint64_t offset;
+			uint64_t size;
+			uint64_t checksum;
+	};
+	constexpr uint64_t table_alignment = 4096;
+
+	uint64_t get_checksum(const uint8_t *data, size_t size) noexcept
+	{ // FNV-1a applied to 64-bit words
+		uint64_t result = 14695981039346656037ull;
+		size_t i = 0;
+		for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+		{
+			uint64_t tmp;
+			std::memcpy(&tmp, data + i, sizeof(uint64_t));
+			result = (result ^ tmp) * 1099511628211ull;
+		}
+		for (; i < size; i++)
+			result = (result ^ data[i]) * 1099511628211ull;
+		return result;
+	}
+	std::string& table_file_path()
+	{
+		static std::string path;
+		return path;
+	}
+	std::mutex& table_file_mutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
 	class ThreatClassifier
 	{
 			IsOverline is_overline;
@@ -94,18 +162,8 @@ namespace ag
 	}
 
 	PatternTable::PatternTable(GameRules rules) :
-			pattern_types(power(4, Pattern::length - 1)),
-			update_mask(power(4, Pattern::length - 1)),
-			half_open_3_cross(power(4, Pattern::length - 1)),
-			half_open_3_circle(power(4, Pattern::length - 1)),
-			game_rules(rules)
+			PatternTable(rules, true)
 	{
-//		double t0 = getTime();
-		init_features();
-//		double t1 = getTime();
-		init_update_mask();
-//		double t2 = getTime();
-//		std::cout << (t1 - t0) << " " << (t2 - t1) << '\n';
 	}
 	const PatternTable& PatternTable::get(GameRules rules)
 	{
@@ -140,19 +198,130 @@ namespace ag
 				throw std::logic_error("PatternTable::get() unknown rule " + std::to_string((int) rules));
 		}
 	}
+	void PatternTable::setTableFile(const std::string &path)
+	{
+		std::lock_guard lock(table_file_mutex());
+		table_file_path() = path;
+	}
+	void PatternTable::generateTableFile(const std::string &path)
+	{
+		static_assert(sizeof(PatternInfo) == 8 and std::is_trivially_copyable<PatternInfo>::value);
+
+		const std::vector<GameRules> all_rules = { GameRules::FREESTYLE, GameRules::STANDARD, GameRules::RENJU, GameRules::CARO5, GameRules::CARO6 };
+		const uint64_t table_size = number_of_patterns() * sizeof(PatternInfo);
+
+		TableFileHeader header;
+		std::memcpy(header.magic, TableFileHeader::expected_magic, sizeof(header.magic));
+		header.format = TableFileHeader::current_format;
+		header.program_version = TableFileHeader::get_program_version();
+		header.pattern_length = Pattern::length;
+		header.number_of_tables = all_rules.size();
+
+		std::vector<TableFileEntry> entries(all_rules.size());
+		std::vector<std::vector<uint8_t>> tables(all_rules.size());
+		uint64_t offset = roundToMultipleOf<uint64_t>(sizeof(TableFileHeader) + sizeof(TableFileEntry) * entries.size(), table_alignment);
+		for (size_t i = 0; i < all_rules.size(); i++)
+		{
+			const PatternTable table(all_rules[i], false);
+			std::vector<uint8_t> &data = tables[i];
+			data.resize(table_size);
+			std::memcpy(data.data(), table.patterns_ptr, table_size);
+
+			entries[i].rules = static_cast<uint32_t>(all_rules[i]);
+			entries[i].number_of_patterns = number_of_patterns();
+			entries[i].offset = offset;
+			entries[i].size = table_size;
+			entries[i].checksum = get_checksum(data.data(), data.size());
+			offset = roundToMultipleOf<uint64_t>(offset + table_size, table_alignment);
+		}
+
+		std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (not file.good())
+			throw std::runtime_error("PatternTable::generateTableFile() : could not open file '" + path + "' for writing");
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(entries.data()), sizeof(TableFileEntry) * entries.size());
+		for (size_t i = 0; i < tables.size(); i++)
+		{
+			const std::vector<char> padding(entries[i].offset - static_cast<uint64_t>(file.tellp()), '\0');
+			file.write(padding.data(), padding.size());
+			file.write(reinterpret_cast<const char*>(tables[i].data()), tables[i].size());
+		}
+		if (not file.good())
+			throw std::runtime_error("PatternTable::generateTableFile() : could not write to file '" + path + "'");
+	}
 	/*
 	 * private
 	 */
+	PatternTable::PatternTable(GameRules rules, bool useTableFile) :
+			game_rules(rules)
+	{
+		std::string path;
+		if (useTableFile)
+		{
+			std::lock_guard lock(table_file_mutex());
+			path = table_file_path();
+		}
+		if (not path.empty())
+		{
+			if (load_from_file(path))
+				return;
+			Logger::write("PatternTable : could not load " + toString(rules) + " tables from '" + path + "', generating them instead");
+		}
+		generate();
+	}
+	bool PatternTable::load_from_file(const std::string &path)
+	{
+		std::shared_ptr<const MemoryMappedFile> file;
+		try
+		{
+			file = std::make_shared<const MemoryMappedFile>(path);
+		} catch (std::exception &e)
+		{
+			return false;
+		}
+		const uint8_t *data = reinterpret_cast<const uint8_t*>(file->data());
+		if (file->size() < sizeof(TableFileHeader))
+			return false;
+		const TableFileHeader *header = reinterpret_cast<const TableFileHeader*>(data);
+		if (not header->is_valid() or file->size() < sizeof(TableFileHeader) + sizeof(TableFileEntry) * header->number_of_tables)
+			return false;
+
+		const TableFileEntry *entries = reinterpret_cast<const TableFileEntry*>(data + sizeof(TableFileHeader));
+		for (uint32_t i = 0; i < header->number_of_tables; i++)
+			if (entries[i].rules == static_cast<uint32_t>(game_rules))
+			{
+				const TableFileEntry &entry = entries[i];
+				const uint64_t expected_size = number_of_patterns() * sizeof(PatternInfo);
+				if (entry.number_of_patterns != number_of_patterns() or entry.size != expected_size or entry.offset % table_alignment != 0
+						or entry.offset + entry.size > file->size())
+					return false;
+				if (get_checksum(data + entry.offset, entry.size) != entry.checksum)
+					return false;
+
+				patterns_ptr = reinterpret_cast<const PatternInfo*>(data + entry.offset);
+				mapped_file = file;
+				return true;
+			}
+		return false;
+	}
+	void PatternTable::generate()
+	{
+		patterns = std::vector<PatternInfo>(number_of_patterns());
+		patterns_ptr = patterns.data();
+
+		init_features();
+		init_update_mask();
+	}
 	void PatternTable::init_features()
 	{
-		std::vector<bool> was_processed(pattern_types.size());
+		std::vector<bool> was_processed(number_of_patterns());
 
 		const ThreatClassifier for_cross(game_rules, Sign::CROSS);
 		const ThreatClassifier for_circle(game_rules, Sign::CIRCLE);
 
 		Pattern line(Pattern::length);
 
-		for (size_t i = 0; i < pattern_types.size(); i++)
+		for (size_t i = 0; i < number_of_patterns(); i++)
 			if (was_processed[i] == false)
 			{
 				line.decode(expand(i));
@@ -171,19 +340,19 @@ namespace ag
 
 					if (cross == PatternType::HALF_OPEN_3)
 					{
-						half_open_3_cross[idx0] = true;
-						half_open_3_cross[idx1] = true;
+						patterns[idx0].setHalfOpenThree(Sign::CROSS);
+						patterns[idx1].setHalfOpenThree(Sign::CROSS);
 						cross = PatternType::NONE;
 					}
 					if (circle == PatternType::HALF_OPEN_3)
 					{
-						half_open_3_circle[idx0] = true;
-						half_open_3_circle[idx1] = true;
+						patterns[idx0].setHalfOpenThree(Sign::CIRCLE);
+						patterns[idx1].setHalfOpenThree(Sign::CIRCLE);
 						circle = PatternType::NONE;
 					}
 
-					pattern_types[idx0] = PatternEncoding(cross, circle);
-					pattern_types[idx1] = PatternEncoding(cross, circle);
+					patterns[idx0].setPatternType(PatternEncoding(cross, circle));
+					patterns[idx1].setPatternType(PatternEncoding(cross, circle));
 
 					was_processed[idx0] = true;
 					was_processed[idx1] = true;
@@ -194,13 +363,13 @@ namespace ag
 	{
 		std::vector<BitMask1D<uint16_t>> unique_masks;
 
-		std::vector<bool> was_processed(update_mask.size());
+		std::vector<bool> was_processed(number_of_patterns());
 
 		const int side_length = (Pattern::length - 1) / 2;
 		Pattern base_line(Pattern::length);
 		Pattern secondary_line(Pattern::length);
 
-		for (size_t i = 0; i < update_mask.size(); i++)
+		for (size_t i = 0; i < number_of_patterns(); i++)
 		{
 			const uint32_t idx = expand(i);
 			base_line.decode(idx);
@@ -258,8 +427,8 @@ namespace ag
 						mask_circle_altered.set(spot_index, cross_flag2, circle_flag2);
 					}
 
-				update_mask[i][0] = mask_cross_altered;
-				update_mask[i][1] = mask_circle_altered;
+				patterns[i].setUpdateMask(mask_cross_altered, Sign::CROSS);
+				patterns[i].setUpdateMask(mask_circle_altered, Sign::CIRCLE);
 
 				was_processed[i] = true;
 				base_line.decode(idx);
@@ -269,8 +438,8 @@ namespace ag
 				mask_circle_altered.flip(Pattern::length);
 
 				base_line.flip();
-				update_mask[narrow_down(base_line.encode())][0] = mask_cross_altered;
-				update_mask[narrow_down(base_line.encode())][1] = mask_circle_altered;
+				patterns[narrow_down(base_line.encode())].setUpdateMask(mask_cross_altered, Sign::CROSS);
+				patterns[narrow_down(base_line.encode())].setUpdateMask(mask_circle_altered, Sign::CIRCLE);
 				was_processed[narrow_down(base_line.encode())] = true;
 			}
 		}
@@ -10,8 +10,10 @@
 #include <alphagomoku/player/SearchThread.hpp>
 #include <alphagomoku/player/EngineController.hpp>
 #include <alphagomoku/search/monte_carlo/NNEvaluator.hpp>
+#include <alphagomoku/patterns/PatternTable.hpp>
 #include <alphagomoku/utils/file_util.hpp>
 #include <alphagomoku/utils/Logger.hpp>
+#include <alphagomoku/utils/misc.hpp>
 #include <alphagomoku/utils/selfcheck.hpp>
 #include <alphagomoku/networks/AGNetwork.hpp>
 #include <alphagomoku/version.hpp>
@@ -61,6 +63,7 @@ namespace ag
 			output_sender.send("Try '" + argument_parser.getExecutableName() + " --help' for more information.");
 			throw;
 		}
+		PatternTable::setTableFile(argument_parser.getLaunchPath() + name_of_table_file);
 		if (display_help)
 		{
 			help();
@@ -93,6 +96,11 @@ namespace ag
 			selfcheck();
 			return false;
 		}
+		if (run_table_generation)
+		{
+			generate_tables();
+			return false;
+		}
 		return true;
 	}
 	void ProgramManager::run()
@@ -235,6 +243,11 @@ namespace ag
 				{	this->run_benchmark = true;});
 		argument_parser.addArgument("--selfcheck").help("run some self-testing").action([this]()
 		{	this->run_selfcheck = true;});
+		argument_parser.addArgument("--generate-tables").help(
+				"precompute pattern tables for all rules, save them to file \"pattern_tables.bin\" and exit. "
+						"This file is then loaded at startup instead of recalculating the tables. If this file exists it will be overwritten.").action(
+				[this]()
+				{	this->run_table_generation = true;});
 	}
 	void ProgramManager::process_pre_launch_commands()
 	{
@@ -373,6 +386,13 @@ namespace ag
 
 		output_sender.send("Selfcheck completed");
 	}
+	void ProgramManager::generate_tables() const
+	{
+		output_sender.send("Generating pattern tables");
+		const double start = getTime();
+		PatternTable::generateTableFile(argument_parser.getLaunchPath() + name_of_table_file);
+		output_sender.send("Pattern tables generated in " + std::to_string(getTime() - start) + "s");
+	}
 	bool ProgramManager::load_config(const std::string &path)
 	{
 		if (pathExists(path))
@@ -85,12 +85,14 @@ namespace ag
 	SearchEngine::SearchEngine(const EngineSettings &settings) :
 			settings(settings),
 			nn_evaluators(settings),
+			root_solver(settings.getGameConfig(), settings.getThreadNum() - 1, settings.getSearchConfig().tss_config.hash_table_size),
 			tree(settings.getSearchConfig().tree_config)
 	{
 	}
 	void SearchEngine::reset()
 	{
 		tree.clear();
+		root_solver.clear();
 		for (size_t i = 0; i < search_threads.size(); i++)
 			search_threads[i]->reset();
 	}
@@ -99,6 +101,7 @@ namespace ag
 		assert(isSearchFinished());
 		HighPriorityLock lock = tree.high_priority_lock();
 		tree.setBoard(board, signToMove, true);
+		root_solver.increaseGeneration();
 		for (size_t i = 0; i < search_threads.size(); i++)
 			search_threads[i]->setPosition(board, signToMove);
 	}
@@ -274,11 +277,12 @@ namespace ag
 	 */
 	void SearchEngine::setup_search_threads()
 	{
+		root_solver.setNumberOfHelpers(settings.getThreadNum() - 1);
 		if (settings.getThreadNum() > static_cast<int>(search_threads.size()))
 		{
 			const int num_to_add = settings.getThreadNum() - static_cast<int>(search_threads.size());
 			for (int i = 0; i < num_to_add; i++)
-				search_threads.push_back(std::make_unique<SearchThread>(settings, tree, nn_evaluators));
+				search_threads.push_back(std::make_unique<SearchThread>(settings, tree, nn_evaluators, &root_solver));
 		}
 		if (settings.getThreadNum() < static_cast<int>(search_threads.size()))
 			search_threads.erase(search_threads.begin() + settings.getThreadNum(), search_threads.end());
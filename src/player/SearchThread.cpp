@@ -29,12 +29,13 @@ namespace
 
 namespace ag
 {
-	SearchThread::SearchThread(const EngineSettings &settings, Tree &tree, const NNEvaluatorPool &evaluators) :
+	SearchThread::SearchThread(const EngineSettings &settings, Tree &tree, const NNEvaluatorPool &evaluators, ParallelAlphaBetaSearch *rootSolver) :
 			settings(settings),
 			tree(tree),
 			evaluator_pool(evaluators),
 			search(settings.getGameConfig(), settings.getSearchConfig())
 	{
+		search.setRootSolver(rootSolver);
 //		search.getSolver().loadWeights(nnue::NNUEWeights(settings.getPathToNnueNetwork())); // TODO return back to this once TSS gets improved
 	}
 	SearchThread::~SearchThread()
@@ -44,7 +45,7 @@ namespace ag
 	}
 	void SearchThread::reset()
 	{
-		search.getSolver().clear();
+		search.clear();
 	}
 	void SearchThread::setPosition(const matrix<Sign> &board, Sign signToMove)
 	{
@@ -0,0 +1,85 @@
+/*
+ * ProvenPositionTable.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/search/ProvenPositionTable.hpp>
+#include <alphagomoku/utils/math_utils.hpp>
+
+#include <algorithm>
+
+namespace ag
+{
+	ProvenPositionTable::ProvenPositionTable(int rows, int columns, size_t initialSize) :
+			m_hashtable(std::max((size_t) 1, roundToPowerOf2(initialSize) / 4)),
+			m_hash_function(rows, columns),
+			m_bucket_mask(m_hashtable.size() - 1)
+	{
+		clear();
+	}
+	int64_t ProvenPositionTable::getMemory() const noexcept
+	{
+		return sizeof(Bucket) * m_hashtable.size() + m_hash_function.getMemory();
+	}
+	const FastZobristHashing& ProvenPositionTable::getHashFunction() const noexcept
+	{
+		return m_hash_function;
+	}
+	void ProvenPositionTable::clear() noexcept
+	{
+		std::fill(m_hashtable.begin(), m_hashtable.end(), Bucket());
+	}
+	bool ProvenPositionTable::seek(const HashKey128 &hash, Sign signToMove, Score &score, Move &bestMove) const noexcept
+	{
+		const Bucket &bucket = m_hashtable[hash.getLow() & m_bucket_mask];
+		for (size_t i = 0; i < bucket.size(); i++)
+			if (bucket[i].key == hash and bucket[i].sign_to_move == signToMove)
+			{
+				score = Score::from_short(bucket[i].score);
+				bestMove = Move(bucket[i].move);
+				return true;
+			}
+		return false;
+	}
+	void ProvenPositionTable::insert(const HashKey128 &hash, Sign signToMove, Score score, Move bestMove) noexcept
+	{
+		if (not score.isProven())
+			return;
+
+		Bucket &bucket = m_hashtable[hash.getLow() & m_bucket_mask];
+		int idx = 0;
+		for (size_t i = 0; i < bucket.size(); i++)
+		{
+			if (bucket[i].key == hash and bucket[i].sign_to_move == signToMove)
+			{ // the position is already stored, so we just update it
+				idx = i;
+				break;
+			}
+			if (bucket[i].sign_to_move == Sign::NONE)
+			{ // empty entries are used first, but we must still check if the position is not stored further in the bucket
+				if (bucket[idx].sign_to_move != Sign::NONE)
+					idx = i;
+				continue;
+			}
+			if (bucket[idx].sign_to_move != Sign::NONE
+					and Score::from_short(bucket[i].score).getDistance() < Score::from_short(bucket[idx].score).getDistance())
+				idx = i;
+		}
+		Entry &entry = bucket[idx];
+		entry.key = hash;
+		entry.score = Score::to_short(score);
+		entry.move = bestMove.toShort();
+		entry.sign_to_move = signToMove;
+	}
+	double ProvenPositionTable::loadFactor() const noexcept
+	{
+		uint64_t result = 0;
+		for (size_t i = 0; i < m_hashtable.size(); i++)
+			for (size_t j = 0; j < m_hashtable[i].size(); j++)
+				result += (m_hashtable[i][j].sign_to_move != Sign::NONE);
+		return static_cast<double>(result) / (m_hashtable.size() * 4);
+	}
+
+} /* namespace ag */
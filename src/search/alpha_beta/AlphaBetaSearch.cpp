@@ -50,25 +50,28 @@ namespace
 namespace ag
 {
 
-	AlphaBetaSearch::AlphaBetaSearch(const GameConfig &gameConfig) :
+	AlphaBetaSearch::AlphaBetaSearch(const GameConfig &gameConfig, std::shared_ptr<SharedHashTable> sharedTable) :
 			action_stack(get_max_nodes(gameConfig)),
 			game_config(gameConfig),
 			pattern_calculator(gameConfig),
 			move_generator(gameConfig, pattern_calculator),
 //			policy_nnue(gameConfig, 1, "nnue_policy_s2_5x5_32x32x1.bin"),
-			shared_table(gameConfig.rows, gameConfig.cols, 4 * 1024 * 1024),
+			shared_table(sharedTable),
+			nodes_per_ply(64, 0),
 			total_time("total_time"),
 			policy_time("policy_time")
 	{
+		if (shared_table == nullptr)
+			shared_table = std::make_shared<SharedHashTable>(gameConfig.rows, gameConfig.cols, 4 * 1024 * 1024);
 //		loadWeights(nnue::NNUEWeights("/home/maciek/Desktop/AlphaGomoku560/networks/standard_nnue_64x16x16x1.bin"));
 	}
 	void AlphaBetaSearch::increaseGeneration()
 	{
-		shared_table.increaseGeneration();
+		shared_table->increaseGeneration();
 	}
 	void AlphaBetaSearch::clear()
 	{
-		shared_table.clear();
+		shared_table->clear();
 	}
 	void AlphaBetaSearch::loadWeights(const nnue::NNUEWeights &weights)
 	{
@@ -86,11 +89,12 @@ namespace ag
 
 		node_counter = 0;
 
+		action_stack.resetMoveOrdering();
 		ActionList actions(action_stack);
 		Score result;
-		hash_key = shared_table.getHashFunction().getHash(task.getBoard()); // set up hash key
-		for (int depth = 0; depth <= max_depth; depth += 4)
-		{ // iterative deepening loop
+		hash_key = shared_table->getHashFunction().getHash(task.getBoard()); // set up hash key
+		for (int depth = helper_index % 4; depth <= max_depth; depth += 4)
+		{ // iterative deepening loop, helpers start from different depths so that they do not repeat the work of the main search
 //			double t0 = getTime();
 			const size_t max_stack_offset = action_stack.max_offset();
 			result = recursive_solve(depth, Score::min_value(), Score::max_value(), actions);
@@ -105,12 +109,13 @@ namespace ag
 			 * - we have proven score, or
 			 * - we have exceeded the max number of nodes, or
 			 * - no new nodes were added to the tree
-			 * - there is no time left
+			 * - there is no time left, or
+			 * - we were requested to stop
 			 */
-			if (actions.isEmpty() or result.isProven() or node_counter >= max_nodes or action_stack.max_offset() == max_stack_offset
-					or (getTime() - start_time) >= max_time)
+			if (actions.isEmpty() or result.isProven() or action_stack.max_offset() == max_stack_offset or is_out_of_budget())
 				break;
 		}
+		root_has_initiative = actions.has_initiative;
 		for (auto iter = actions.begin(); iter < actions.end(); iter++)
 		{
 			const Move m(iter->move);
@@ -160,7 +165,17 @@ namespace ag
 		std::cout << total_time.toString() << '\n';
 		std::cout << policy_time.toString() << '\n';
 		std::cout << "total positions = " << total_positions << " : " << total_positions / total_calls << "\n";
-		std::cout << "SharedHashTable load factor = " << shared_table.loadFactor(true) << '\n';
+		std::cout << "cutoffs = " << total_cutoffs << ", on first move = " << first_move_cutoffs << " ("
+				<< 100.0 * first_move_cutoffs / std::max((size_t) 1, total_cutoffs) << "%)\n";
+		std::cout << "nodes per ply (effective branching factor):\n";
+		for (size_t i = 0; i < nodes_per_ply.size() and nodes_per_ply[i] > 0; i++)
+		{
+			std::cout << "  " << i << " : " << nodes_per_ply[i];
+			if (i > 0)
+				std::cout << " (" << static_cast<double>(nodes_per_ply[i]) / nodes_per_ply[i - 1] << ")";
+			std::cout << '\n';
+		}
+		std::cout << "SharedHashTable load factor = " << shared_table->loadFactor(true) << '\n';
 		inference_nnue.print_stats();
 	}
 	int64_t AlphaBetaSearch::getMemory() const noexcept
@@ -179,6 +194,18 @@ namespace ag
 	{
 		max_time = time;
 	}
+	void AlphaBetaSearch::setStopFlag(const std::atomic<bool> *flag) noexcept
+	{
+		stop_flag = flag;
+	}
+	void AlphaBetaSearch::setHelperIndex(int index) noexcept
+	{
+		helper_index = index;
+	}
+	bool AlphaBetaSearch::hasInitiativeAtRoot() const noexcept
+	{
+		return root_has_initiative;
+	}
 	/*
 	 * private
 	 */
@@ -196,7 +223,7 @@ namespace ag
 
 		Move best_move;
 		{ // lookup to the shared hash table
-			const SharedTableData tt_entry = shared_table.seek(hash_key);
+			const SharedTableData tt_entry = shared_table->seek(hash_key);
 			const Bound tt_bound = tt_entry.bound();
 
 			if (tt_bound != Bound::NONE)
@@ -216,6 +243,8 @@ namespace ag
 		}
 
 		node_counter++;
+		if (actions.distanceFromRoot() < static_cast<int>(nodes_per_ply.size()))
+			nodes_per_ply[actions.distanceFromRoot()]++;
 
 //		if (not actions.isRoot() and not actions.performed_pattern_update)
 //		{
@@ -269,16 +298,16 @@ namespace ag
 			{
 				int idx = i;
 				for (int j = i + 1; j < actions.size(); j++)
-					if (actions[idx] < actions[j])
+					if (is_better(actions[j], actions[idx], actions))
 						idx = j;
 				std::swap(actions[i], actions[idx]);
 			}
 
-			if (actions[i].score.isUnproven() and node_counter < max_nodes and (getTime() - start_time) < max_time)
+			if (actions[i].score.isUnproven() and not is_out_of_budget())
 			{
 				const Move move = actions[i].move;
-				shared_table.getHashFunction().updateHash(hash_key, move);
-				shared_table.prefetch(hash_key);
+				shared_table->getHashFunction().updateHash(hash_key, move);
+				shared_table->prefetch(hash_key);
 
 				// construct next ply action list
 				ActionList next_ply_actions(action_stack, actions, i);
@@ -302,7 +331,7 @@ namespace ag
 //					pattern_calculator.undoMove(move);
 //					inference_nnue.update(pattern_calculator);
 //				}
-				shared_table.getHashFunction().updateHash(hash_key, move);
+				shared_table->getHashFunction().updateHash(hash_key, move);
 			}
 			best_score = std::max(best_score, actions[i].score);
 
@@ -312,7 +341,12 @@ namespace ag
 				best_move = actions[i].move;
 			}
 			if (actions[i].score >= beta or actions[i].score.isWin())
+			{
+				total_cutoffs++;
+				first_move_cutoffs += (i == 0);
+				action_stack.addCutoff(actions.distanceFromRoot(), actions.last_move, actions[i].move, depthRemaining);
 				break;
+			}
 		}
 		// if either
 		//  - no actions were generated, or
@@ -333,7 +367,7 @@ namespace ag
 				tt_bound = Bound::EXACT;
 		}
 		const SharedTableData entry(tt_bound, depthRemaining, best_score, best_move);
-		shared_table.insert(hash_key, entry);
+		shared_table->insert(hash_key, entry);
 
 		return best_score;
 	}
@@ -341,6 +375,26 @@ namespace ag
 	{
 		return m.sign == pattern_calculator.getSignToMove() and pattern_calculator.signAt(m.row, m.col) == Sign::NONE;
 	}
+	bool AlphaBetaSearch::is_better(const Action &lhs, const Action &rhs, const ActionList &actions) const noexcept
+	{
+		if (lhs.score != rhs.score)
+			return rhs < lhs;
+		// actions with equal scores are ordered by killer moves, countermoves and history of cutoffs
+		const int32_t lhs_priority = action_stack.getOrderingPriority(actions.distanceFromRoot(), actions.last_move, lhs.move);
+		const int32_t rhs_priority = action_stack.getOrderingPriority(actions.distanceFromRoot(), actions.last_move, rhs.move);
+		if (helper_index == 0 or lhs_priority != rhs_priority)
+			return lhs_priority > rhs_priority;
+		// helpers break remaining ties in a different order to diversify the search
+		const uint32_t lhs_key = (static_cast<uint32_t>(lhs.move.toShort()) ^ helper_index) * 2654435761u;
+		const uint32_t rhs_key = (static_cast<uint32_t>(rhs.move.toShort()) ^ helper_index) * 2654435761u;
+		return lhs_key > rhs_key;
+	}
+	bool AlphaBetaSearch::is_out_of_budget() const noexcept
+	{
+		if (stop_flag != nullptr and stop_flag->load(std::memory_order_relaxed))
+			return true;
+		return node_counter >= max_nodes or (getTime() - start_time) >= max_time;
+	}
 
 	Score AlphaBetaSearch::evaluate()
 	{
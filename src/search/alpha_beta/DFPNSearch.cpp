@@ -0,0 +1,315 @@
+/*
+ * DFPNSearch.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/search/alpha_beta/DFPNSearch.hpp>
+#include <alphagomoku/search/monte_carlo/SearchTask.hpp>
+#include <alphagomoku/utils/math_utils.hpp>
+#include <alphagomoku/utils/misc.hpp>
+
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	using namespace ag;
+
+	int get_max_nodes(GameConfig cfg) noexcept
+	{
+		const int size = cfg.rows * cfg.cols;
+		return size * (size + 1) / 2;
+	}
+	uint32_t saturated_add(uint32_t lhs, uint32_t rhs) noexcept
+	{
+		return std::min(ProofNumbers::infinity, lhs + rhs);
+	}
+}
+
+namespace ag
+{
+	ProofNumberTable::ProofNumberTable(int rows, int columns, size_t initialSize) :
+			m_hashtable(std::max((size_t) 1, roundToPowerOf2(initialSize) / 2)),
+			m_hash_function(rows, columns),
+			m_bucket_mask(m_hashtable.size() - 1)
+	{
+		clear();
+	}
+	int64_t ProofNumberTable::getMemory() const noexcept
+	{
+		return sizeof(Bucket) * m_hashtable.size() + m_hash_function.getMemory();
+	}
+	const FastZobristHashing& ProofNumberTable::getHashFunction() const noexcept
+	{
+		return m_hash_function;
+	}
+	void ProofNumberTable::clear() noexcept
+	{
+		std::fill(m_hashtable.begin(), m_hashtable.end(), Bucket());
+	}
+	bool ProofNumberTable::seek(const HashKey128 &hash, Sign attacker, ProofNumbers &result) const noexcept
+	{
+		const Bucket &bucket = m_hashtable[hash.getLow() & m_bucket_mask];
+		for (size_t i = 0; i < bucket.size(); i++)
+			if (bucket[i].key == hash.getHigh() and bucket[i].attacker == attacker)
+			{
+				result.phi = bucket[i].phi;
+				result.delta = bucket[i].delta;
+				result.distance = bucket[i].distance;
+				return true;
+			}
+		return false;
+	}
+	void ProofNumberTable::insert(const HashKey128 &hash, Sign attacker, const ProofNumbers &value, uint32_t work) noexcept
+	{
+		Bucket &bucket = m_hashtable[hash.getLow() & m_bucket_mask];
+		int idx = 0;
+		for (size_t i = 0; i < bucket.size(); i++)
+		{
+			if (bucket[i].key == hash.getHigh() and bucket[i].attacker == attacker)
+			{ // the position is already stored, so we just update it
+				idx = i;
+				break;
+			}
+			if (bucket[i].work < bucket[idx].work)
+				idx = i; // otherwise replace the entry that was cheapest to compute
+		}
+		Entry &entry = bucket[idx];
+		entry.key = hash.getHigh();
+		entry.phi = value.phi;
+		entry.delta = value.delta;
+		entry.work = work;
+		entry.distance = value.distance;
+		entry.attacker = attacker;
+	}
+	double ProofNumberTable::loadFactor() const noexcept
+	{
+		uint64_t result = 0;
+		for (size_t i = 0; i < m_hashtable.size(); i++)
+			for (size_t j = 0; j < m_hashtable[i].size(); j++)
+				result += (m_hashtable[i][j].attacker != Sign::NONE);
+		return static_cast<double>(result) / (m_hashtable.size() * 2);
+	}
+
+	DFPNSearch::DFPNSearch(const GameConfig &gameConfig, size_t hashTableSize) :
+			action_stack(get_max_nodes(gameConfig)),
+			child_numbers(action_stack.size()),
+			game_config(gameConfig),
+			pattern_calculator(gameConfig),
+			move_generator(gameConfig, pattern_calculator),
+			proof_table(gameConfig.rows, gameConfig.cols, hashTableSize),
+			total_time("total_time")
+	{
+	}
+	void DFPNSearch::clear()
+	{
+		proof_table.clear();
+	}
+	int DFPNSearch::solve(SearchTask &task)
+	{
+		TimerGuard tg(total_time);
+
+		start_time = getTime();
+		node_counter = 0;
+
+		pattern_calculator.setBoard(task.getBoard(), task.getSignToMove());
+		attacker = task.getSignToMove();
+		hash_key = proof_table.getHashFunction().getHash(task.getBoard());
+
+		ActionList actions(action_stack);
+		ProofNumbers result;
+		recursive_solve(ProofNumbers::infinity, ProofNumbers::infinity, result, actions);
+
+		if (result.isWin())
+		{ // we only use proofs, as a failed threat search does not tell anything about the real outcome of the game
+			int best_idx = -1;
+			for (int i = 0; i < actions.size(); i++)
+			{
+				const ProofNumbers &child = child_numbers_of(actions)[i];
+				if (child.isLoss() and (best_idx == -1 or child.distance < child_numbers_of(actions)[best_idx].distance))
+					best_idx = i;
+			}
+			if (best_idx != -1)
+			{
+				const Move move = actions[best_idx].move;
+				const Score score = Score::win_in(result.distance);
+				task.getActionScores().at(move.row, move.col) = score;
+				task.getActionValues().at(move.row, move.col) = score.convertToValue();
+				if (std::none_of(task.getEdges().begin(), task.getEdges().end(), [move](const Edge &edge)
+				{	return edge.getMove() == move;}))
+					task.addEdge(move);
+				task.setScore(score);
+				task.setValue(score.convertToValue());
+				task.setMovesLeft(score.getDistance());
+				task.setValueUncertainty(0.0f);
+				task.maskAsRecursivelySolved();
+				total_proofs++;
+			}
+		}
+
+		total_positions += node_counter;
+		total_calls++;
+		return node_counter;
+	}
+	void DFPNSearch::print_stats() const
+	{
+		std::cout << total_time.toString() << '\n';
+		std::cout << "total positions = " << total_positions << " : " << total_positions / std::max((size_t) 1, total_calls) << "\n";
+		std::cout << "total proofs = " << total_proofs << " / " << total_calls << '\n';
+		std::cout << "ProofNumberTable load factor = " << proof_table.loadFactor() << '\n';
+	}
+	int64_t DFPNSearch::getMemory() const noexcept
+	{
+		return action_stack.size() * (sizeof(Action) + sizeof(ProofNumbers)) + proof_table.getMemory();
+	}
+	void DFPNSearch::setNodeLimit(int nodes) noexcept
+	{
+		max_nodes = nodes;
+	}
+	void DFPNSearch::setTimeLimit(double time) noexcept
+	{
+		max_time = time;
+	}
+	void DFPNSearch::useOpenThrees(bool flag) noexcept
+	{
+		use_open_threes = flag;
+	}
+	/*
+	 * private
+	 */
+	void DFPNSearch::recursive_solve(uint32_t phiThreshold, uint32_t deltaThreshold, ProofNumbers &result, ActionList &actions)
+	{
+		node_counter++;
+		const int initial_node_counter = node_counter;
+
+		const bool has_children = generate_actions(actions, result);
+		ProofNumbers *children = child_numbers_of(actions);
+		for (int i = 0; i < actions.size(); i++)
+			children[i] = get_child_numbers(actions[i]);
+
+		while (has_children)
+		{
+			// phi of the node is the minimum of children deltas, delta of the node is the sum of children phis
+			int best_idx = -1;
+			uint32_t second_best_delta = ProofNumbers::infinity;
+			result = ProofNumbers( { ProofNumbers::infinity, 0, 0 });
+			int win_distance = std::numeric_limits<int>::max();
+			int loss_distance = 0;
+			for (int i = 0; i < actions.size(); i++)
+			{
+				if (children[i].delta < result.phi)
+				{
+					second_best_delta = result.phi;
+					result.phi = children[i].delta;
+					best_idx = i;
+				}
+				else
+					second_best_delta = std::min(second_best_delta, children[i].delta);
+				result.delta = saturated_add(result.delta, children[i].phi);
+				if (children[i].isLoss())
+					win_distance = std::min(win_distance, children[i].distance + 1);
+				loss_distance = std::max(loss_distance, children[i].distance + 1);
+			}
+			if (result.isWin())
+				result.distance = win_distance;
+			if (result.isLoss())
+				result.distance = loss_distance;
+
+			if (result.phi >= phiThreshold or result.delta >= deltaThreshold or is_out_of_budget())
+				break;
+
+			assert(best_idx != -1);
+			const uint32_t child_phi_threshold = saturated_add(deltaThreshold - result.delta, children[best_idx].phi);
+			const uint32_t child_delta_threshold = std::min(phiThreshold, saturated_add(second_best_delta, 1));
+
+			const Move move = actions[best_idx].move;
+			proof_table.getHashFunction().updateHash(hash_key, move);
+			pattern_calculator.addMove(move);
+			{
+				ActionList next_ply_actions(action_stack, actions, best_idx);
+				recursive_solve(child_phi_threshold, child_delta_threshold, children[best_idx], next_ply_actions);
+			}
+			pattern_calculator.undoMove(move);
+			proof_table.getHashFunction().updateHash(hash_key, move);
+		}
+		proof_table.insert(hash_key, attacker, result, node_counter - initial_node_counter + 1);
+	}
+	bool DFPNSearch::generate_actions(ActionList &actions, ProofNumbers &result)
+	{
+		const Sign sign_to_move = pattern_calculator.getSignToMove();
+		const bool is_attacker = (sign_to_move == attacker);
+
+		const Score static_score = move_generator.generate(actions, MoveGeneratorMode::THREATS);
+		if (static_score.isWin())
+		{
+			result = ProofNumbers::win(static_score.getDistance());
+			return false;
+		}
+		if (static_score.isLoss())
+		{
+			result = ProofNumbers::loss(static_score.getDistance());
+			return false;
+		}
+		if (static_score.isDraw())
+		{ // draw is a failure for the attacker
+			result = is_attacker ? ProofNumbers::loss(0) : ProofNumbers::win(0);
+			return false;
+		}
+
+		if (is_attacker)
+		{
+			if (use_open_threes and not actions.must_defend)
+			{ // moves creating open threes are also forcing, as they threaten to make an open four
+				for (ThreatType tt : { ThreatType::FORK_3x3, ThreatType::OPEN_3 })
+				{
+					const LocationList &threats = pattern_calculator.getThreatHistogram(sign_to_move).get(tt);
+					for (auto iter = threats.begin(); iter < threats.end(); iter++)
+						if (not actions.contains(*iter) and not pattern_calculator.isForbidden(sign_to_move, iter->row, iter->col))
+							actions.add(Move(sign_to_move, *iter), Score());
+				}
+			}
+			if (actions.isEmpty())
+			{ // the attacker has run out of threats
+				result = ProofNumbers::loss(0);
+				return false;
+			}
+		}
+		else
+		{
+			if (not actions.must_defend)
+			{ // the last move of the attacker was not forcing so the defender is free to play anywhere
+				result = ProofNumbers::win(0);
+				return false;
+			}
+		}
+		return true;
+	}
+	ProofNumbers DFPNSearch::get_child_numbers(const Action &action)
+	{
+		// action score is from the perspective of the side to move at the parent node
+		if (action.score.isWin())
+			return ProofNumbers::loss(action.score.getDistance() - 1);
+		if (action.score.isLoss())
+			return ProofNumbers::win(action.score.getDistance() - 1);
+		if (action.score.isDraw())
+			return (action.move.sign == attacker) ? ProofNumbers::win(0) : ProofNumbers::loss(0);
+
+		ProofNumbers result;
+		proof_table.getHashFunction().updateHash(hash_key, action.move);
+		proof_table.seek(hash_key, attacker, result);
+		proof_table.getHashFunction().updateHash(hash_key, action.move);
+		return result;
+	}
+	ProofNumbers* DFPNSearch::child_numbers_of(const ActionList &actions) noexcept
+	{
+		return child_numbers.data() + (actions.begin() - &action_stack[0]);
+	}
+	bool DFPNSearch::is_out_of_budget() const noexcept
+	{
+		return node_counter >= max_nodes or (getTime() - start_time) >= max_time;
+	}
+
+} /* namespace ag */
@@ -0,0 +1,117 @@
+/*
+ * ParallelAlphaBetaSearch.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/search/alpha_beta/ParallelAlphaBetaSearch.hpp>
+#include <alphagomoku/utils/Logger.hpp>
+
+#include <future>
+#include <string>
+
+namespace ag
+{
+	ParallelAlphaBetaSearch::ParallelAlphaBetaSearch(const GameConfig &gameConfig, int numberOfHelpers, size_t hashTableSize) :
+			game_config(gameConfig),
+			shared_table(std::make_shared<SharedHashTable>(gameConfig.rows, gameConfig.cols, hashTableSize)),
+			main_search(gameConfig, shared_table),
+			stop_flag(false),
+			number_of_helpers(std::max(0, numberOfHelpers))
+	{
+	}
+	void ParallelAlphaBetaSearch::increaseGeneration()
+	{
+		shared_table->increaseGeneration();
+	}
+	void ParallelAlphaBetaSearch::clear()
+	{
+		shared_table->clear();
+	}
+	void ParallelAlphaBetaSearch::setNumberOfHelpers(int number) noexcept
+	{
+		number_of_helpers = std::max(0, number);
+	}
+	int ParallelAlphaBetaSearch::getNumberOfHelpers() const noexcept
+	{
+		return number_of_helpers;
+	}
+	int64_t ParallelAlphaBetaSearch::getMemory() const noexcept
+	{
+		int64_t result = shared_table->getMemory() + main_search.getMemory();
+		for (size_t i = 0; i < helpers.size(); i++)
+			result += helpers[i]->getMemory();
+		return result;
+	}
+	void ParallelAlphaBetaSearch::setNodeLimit(int nodes) noexcept
+	{
+		max_nodes = nodes;
+	}
+	void ParallelAlphaBetaSearch::setTimeLimit(double time) noexcept
+	{
+		max_time = time;
+	}
+	int ParallelAlphaBetaSearch::solve(SearchTask &task)
+	{
+		std::unique_lock lock(solve_mutex, std::try_to_lock);
+		if (not lock.owns_lock())
+			return -1;
+
+		setup_helpers();
+		stop_flag.store(false);
+
+		std::vector<std::future<void>> helper_futures;
+		for (size_t i = 0; i < helpers.size(); i++)
+		{
+			helpers[i]->setNodeLimit(max_nodes);
+			helpers[i]->setTimeLimit(max_time);
+			helper_tasks[i].set(task.getBoard(), task.getSignToMove());
+			helper_futures.push_back(std::async(std::launch::async, [this, i]()
+			{	helpers[i]->solve(helper_tasks[i]);}));
+		}
+
+		main_search.setNodeLimit(max_nodes);
+		main_search.setTimeLimit(max_time);
+		int result = 0;
+		try
+		{
+			result = main_search.solve(task);
+		} catch (std::exception &e)
+		{
+			Logger::write(std::string("ParallelAlphaBetaSearch::solve() threw ") + e.what());
+		}
+
+		stop_flag.store(true); // once the main search has finished, the results of the helpers are no longer needed
+		for (size_t i = 0; i < helper_futures.size(); i++)
+		{
+			try
+			{
+				helper_futures[i].get();
+			} catch (std::exception &e)
+			{
+				Logger::write("ParallelAlphaBetaSearch::solve() helper " + std::to_string(i + 1) + " threw " + e.what());
+			}
+		}
+		return result;
+	}
+	/*
+	 * private
+	 */
+	void ParallelAlphaBetaSearch::setup_helpers()
+	{
+		while (static_cast<int>(helpers.size()) < number_of_helpers)
+		{
+			helpers.push_back(std::make_unique<AlphaBetaSearch>(game_config, shared_table));
+			helpers.back()->setHelperIndex(helpers.size());
+			helpers.back()->setStopFlag(&stop_flag);
+			helper_tasks.push_back(SearchTask(game_config));
+		}
+		if (static_cast<int>(helpers.size()) > number_of_helpers)
+		{
+			helpers.erase(helpers.begin() + number_of_helpers, helpers.end());
+			helper_tasks.erase(helper_tasks.begin() + number_of_helpers, helper_tasks.end());
+		}
+	}
+
+} /* namespace ag */
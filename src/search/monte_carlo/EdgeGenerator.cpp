@@ -8,6 +8,7 @@
 #include <alphagomoku/search/monte_carlo/EdgeGenerator.hpp>
 #include <alphagomoku/search/monte_carlo/SearchTask.hpp>
 #include <alphagomoku/search/Score.hpp>
+#include <alphagomoku/game/BitBoard.hpp>
 #include <alphagomoku/game/rules.hpp>
 #include <alphagomoku/utils/augmentations.hpp>
 #include <alphagomoku/utils/misc.hpp>
@@ -130,13 +131,14 @@ namespace
 		bool has_win_edge = false;
 		bool has_draw_edge = false;
 		int num_losing_edges = 0;
+		BitBoard board(task.getBoard());
 		for (auto edge = task.getEdges().begin(); edge < task.getEdges().end(); edge++)
 		{
 			const Move move = edge->getMove();
 
-			Board::putMove(task.getBoard(), move);
-			const GameOutcome outcome = getOutcome(task.getGameConfig().rules, task.getBoard(), move, task.getGameConfig().draw_after);
-			Board::undoMove(task.getBoard(), move);
+			board.putMove(move);
+			const GameOutcome outcome = getOutcome(task.getGameConfig().rules, board, move, task.getGameConfig().draw_after);
+			board.undoMove(move);
 
 			switch (convertProvenValue(outcome, task.getSignToMove()))
 			{
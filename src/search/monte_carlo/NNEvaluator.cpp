@@ -126,6 +126,11 @@ namespace ag
 		get_network().moveTo(config.device);
 		get_network().convertToHalfFloats();
 		get_network().forward(1);
+
+		const GameConfig &game_config = get_network().getGameConfig();
+		board_buffer = matrix<Sign>(game_config.rows, game_config.cols);
+		policy_buffer = matrix<float>(game_config.rows, game_config.cols);
+		action_values_buffer = matrix<Value>(game_config.rows, game_config.cols);
 	}
 	void NNEvaluator::unloadGraph()
 	{
@@ -244,7 +249,6 @@ namespace ag
 	void NNEvaluator::pack_to_network()
 	{
 		TimerGuard timer(stats.pack);
-		matrix<Sign> board(get_network().getGameConfig().rows, get_network().getGameConfig().cols);
 		for (size_t i = 0; i < in_progress_queue.size(); i++)
 		{
 			TaskData td = in_progress_queue.at(i);
@@ -255,29 +259,27 @@ namespace ag
 			}
 			else
 			{
-				apply_symmetry(board, td.ptr->getBoard(), int_to_symmetry(td.symmetry));
-				get_network().packInputData(i, board, td.ptr->getSignToMove());
+				apply_symmetry(board_buffer, td.ptr->getBoard(), int_to_symmetry(td.symmetry));
+				get_network().packInputData(i, board_buffer, td.ptr->getSignToMove());
 			}
 		}
 	}
 	void NNEvaluator::unpack_from_network()
 	{
 		TimerGuard timer(stats.unpack);
-		matrix<float> policy(get_network().getGameConfig().rows, get_network().getGameConfig().cols);
-		matrix<Value> action_values(get_network().getGameConfig().rows, get_network().getGameConfig().cols);
 		Value value;
 		float moves_left;
 		for (size_t i = 0; i < in_progress_queue.size(); i++)
 		{
 			TaskData td = in_progress_queue.at(i);
-			get_network().unpackOutput(i, policy, action_values, value, moves_left);
-			assert(is_ok(policy));
-			assert(is_ok(action_values));
+			get_network().unpackOutput(i, policy_buffer, action_values_buffer, value, moves_left);
+			assert(is_ok(policy_buffer));
+			assert(is_ok(action_values_buffer));
 			assert(is_ok(value));
 			assert(is_ok(moves_left));
 			const Symmetry inv_s = get_inverse_symmetry(int_to_symmetry(td.symmetry));
-			apply_symmetry(td.ptr->getPolicy(), policy, inv_s);
-			apply_symmetry(td.ptr->getActionValues(), action_values, inv_s); // TODO silently assuming that action values come from TSS
+			apply_symmetry(td.ptr->getPolicy(), policy_buffer, inv_s);
+			apply_symmetry(td.ptr->getActionValues(), action_values_buffer, inv_s); // TODO silently assuming that action values come from TSS
 			td.ptr->setValue(value);
 			if (td.ptr->getScore().isUnproven())
 				td.ptr->setMovesLeft(moves_left);
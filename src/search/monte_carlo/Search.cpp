@@ -9,6 +9,7 @@
 #include <alphagomoku/search/monte_carlo/Tree.hpp>
 #include <alphagomoku/search/monte_carlo/NNEvaluator.hpp>
 #include <alphagomoku/search/monte_carlo/EdgeSelector.hpp>
+#include <alphagomoku/search/alpha_beta/ParallelAlphaBetaSearch.hpp>
 #include <alphagomoku/utils/misc.hpp>
 
 #include <numeric>
@@ -33,6 +34,8 @@ namespace ag
 		result += "nb_proven_states       = " + std::to_string(nb_proven_states) + '\n';
 		result += "nb_network_evaluations = " + std::to_string(nb_network_evaluations) + '\n';
 		result += "nb_node_count          = " + std::to_string(nb_node_count) + '\n';
+		result += "nb_parallel_root_solves = " + std::to_string(nb_parallel_root_solves) + '\n';
+		result += "nb_proven_table_hits   = " + std::to_string(nb_proven_table_hits) + '\n';
 		result += select.toString() + '\n';
 		result += solve.toString() + '\n';
 		result += schedule.toString() + '\n';
@@ -56,6 +59,8 @@ namespace ag
 		this->nb_proven_states += other.nb_proven_states;
 		this->nb_network_evaluations += other.nb_network_evaluations;
 		this->nb_node_count += other.nb_node_count;
+		this->nb_parallel_root_solves += other.nb_parallel_root_solves;
+		this->nb_proven_table_hits += other.nb_proven_table_hits;
 		return *this;
 	}
 	SearchStats& SearchStats::operator/=(int i) noexcept
@@ -73,6 +78,8 @@ namespace ag
 		this->nb_proven_states /= i;
 		this->nb_network_evaluations /= i;
 		this->nb_node_count /= i;
+		this->nb_parallel_root_solves /= i;
+		this->nb_proven_table_hits /= i;
 		return *this;
 	}
 	double SearchStats::getTotalTime() const noexcept
@@ -83,15 +90,18 @@ namespace ag
 
 	Search::Search(const GameConfig &gameOptions, const SearchConfig &searchOptions) :
 			ab_search(gameOptions),
+			proven_table(gameOptions.rows, gameOptions.cols, searchOptions.tss_config.hash_table_size / 16),
 			game_config(gameOptions),
 			search_config(searchOptions)
 	{
 		for (int i = 0; i < 2; i++)
 			tasks_list_buffer[i] = SearchTaskList(gameOptions, searchOptions.max_batch_size);
+		if (searchOptions.tss_config.mode == 3)
+			dfpn_search = std::make_unique<DFPNSearch>(gameOptions, searchOptions.tss_config.hash_table_size);
 	}
 	int64_t Search::getMemory() const noexcept
 	{
-		return ab_search.getMemory();
+		return ab_search.getMemory() + ((dfpn_search != nullptr) ? dfpn_search->getMemory() : 0) + proven_table.getMemory();
 	}
 	const SearchConfig& Search::getConfig() const noexcept
 	{
@@ -101,6 +111,15 @@ namespace ag
 	{
 		return ab_search;
 	}
+	void Search::clear()
+	{
+		ab_search.clear();
+		proven_table.clear();
+	}
+	void Search::setRootSolver(ParallelAlphaBetaSearch *solver) noexcept
+	{
+		root_solver = solver;
+	}
 	void Search::clearStats() noexcept
 	{
 		stats = SearchStats();
@@ -159,25 +178,55 @@ namespace ag
 	void Search::solve(double endTime)
 	{
 		stats.solve.startTimer();
+		const int node_limit = (endTime < 0.0) ? search_config.tss_config.max_positions : 10000;
 		ab_search.setDepthLimit(100);
+		ab_search.setNodeLimit(node_limit);
 		if (endTime < 0.0)
-		{
 			ab_search.setTimeLimit(std::numeric_limits<double>::max());
-			ab_search.setNodeLimit(search_config.tss_config.max_positions);
-		}
-		else
-			ab_search.setNodeLimit(10000);
 
 		for (int i = 0; i < get_buffer().storedElements(); i++)
 			if (not get_buffer().get(i).wasProcessedBySolver())
 			{
+				double time_limit = std::numeric_limits<double>::max();
 				if (endTime >= 0.0)
 				{
 //					std::cout << i << "/" << getBatchSize() << ", time = " << 1.0e6 * (endTime - getTime()) / (getBatchSize() - i) << "us ("
 //							<< 1.0e6 * (endTime - getTime()) << "us)\n";
-					ab_search.setTimeLimit((endTime - getTime()) / (getBatchSize() - i));
+					time_limit = (endTime - getTime()) / (getBatchSize() - i);
+					ab_search.setTimeLimit(time_limit);
 				}
-				ab_search.solve(get_buffer().get(i));
+				SearchTask &task = get_buffer().get(i);
+				const HashKey128 hash = proven_table.getHashFunction().getHash(task.getBoard()); // the board does not change during the solve
+				if (load_proven_position(task, hash))
+				{
+					stats.nb_proven_table_hits++;
+					continue;
+				}
+				const double start_time = getTime();
+				ab_search.solve(task);
+				if (is_critical_root(task))
+				{ // the root is sharp but unproven, so we put the idle cores on it (other search threads are waiting for the root to be expanded)
+					const double remaining_time = time_limit - (getTime() - start_time); // the parallel solve gets only what is left of this task's share
+					if (remaining_time > 0.0)
+					{
+						SearchTask root_task(game_config);
+						root_task.set(task.getBoard(), task.getSignToMove());
+						root_solver->setNodeLimit(node_limit);
+						root_solver->setTimeLimit(remaining_time);
+						if (root_solver->solve(root_task) >= 0)
+						{
+							task = root_task;
+							stats.nb_parallel_root_solves++;
+						}
+					}
+				}
+				if (dfpn_search != nullptr and task.getScore().isUnproven())
+				{ // alpha-beta search only follows fours, the proof-number search can also find sequences that contain open threes
+					dfpn_search->setNodeLimit(node_limit);
+					dfpn_search->setTimeLimit(std::max(0.0, time_limit - (getTime() - start_time)));
+					dfpn_search->solve(task);
+				}
+				store_proven_position(task, hash);
 			}
 		stats.solve.stopTimer(get_buffer().storedElements());
 	}
@@ -257,6 +306,11 @@ namespace ag
 	{
 		return get_buffer().storedElements();
 	}
+	SearchTask& Search::getTask(int index)
+	{
+		assert(0 <= index && index < getBatchSize());
+		return get_buffer().get(index);
+	}
 	/*
 	 * private
 	 */
@@ -270,6 +324,11 @@ namespace ag
 		assert(current_task_buffer == 0 || current_task_buffer == 1);
 		return tasks_list_buffer[current_task_buffer];
 	}
+	bool Search::is_critical_root(const SearchTask &task) const noexcept
+	{
+		return root_solver != nullptr and root_solver->getNumberOfHelpers() > 0 and task.visitedPathLength() == 0 and task.getScore().isUnproven()
+				and ab_search.hasInitiativeAtRoot();
+	}
 	bool Search::is_duplicate(const SearchTask &task) const noexcept
 	{
 		for (int i = 0; i < get_buffer().storedElements() - 1; i++)
@@ -277,6 +336,43 @@ namespace ag
 				return true;
 		return false;
 	}
+	bool Search::load_proven_position(SearchTask &task, const HashKey128 &hash) const
+	{
+		if (task.visitedPathLength() == 0)
+			return false; // root is always searched as its features are also used for the network evaluation
+
+		Score score;
+		Move move;
+		if (not proven_table.seek(hash, task.getSignToMove(), score, move))
+			return false;
+
+		task.getActionScores().at(move.row, move.col) = score;
+		task.getActionValues().at(move.row, move.col) = score.convertToValue();
+		task.addEdge(move);
+		task.setScore(score);
+		task.setValue(score.convertToValue());
+		task.setMovesLeft(score.getDistance());
+		task.setValueUncertainty(0.0f);
+		task.maskAsRecursivelySolved();
+		task.markAsProcessedBySolver();
+		return true;
+	}
+	void Search::store_proven_position(const SearchTask &task, const HashKey128 &hash) noexcept
+	{
+		if (not task.wasRecursivelySolved() or not task.getScore().isProven())
+			return; // statically solved positions are cheap to find again
+
+		// the score of a proven position is the score of its best move, so it is enough to store only this single move
+		for (auto edge = task.getEdges().begin(); edge < task.getEdges().end(); edge++)
+		{
+			const Move move = edge->getMove();
+			if (task.getActionScores().at(move.row, move.col) == task.getScore())
+			{
+				proven_table.insert(hash, task.getSignToMove(), task.getScore(), move);
+				return;
+			}
+		}
+	}
 
 } /* namespace ag */
 
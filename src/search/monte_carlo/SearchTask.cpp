@@ -28,6 +28,9 @@ namespace ag
 	SearchTask::SearchTask(GameConfig config) :
 			game_config(config)
 	{
+		// the path and list of edges can never be longer than the number of cells on board so reserving it here guarantees that reused tasks never allocate
+		visited_path.reserve(config.rows * config.cols);
+		edges.reserve(config.rows * config.cols);
 	}
 	void SearchTask::set(const matrix<Sign> &base, Sign signToMove)
 	{
@@ -0,0 +1,125 @@
+/*
+ * BatchProducer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/selfplay/BatchProducer.hpp>
+#include <alphagomoku/dataset/Dataset.hpp>
+#include <alphagomoku/dataset/Sampler.hpp>
+#include <alphagomoku/dataset/SampleIndex.hpp>
+#include <alphagomoku/patterns/PatternCalculator.hpp>
+#include <alphagomoku/utils/misc.hpp>
+#include <alphagomoku/utils/random.hpp>
+
+#include <algorithm>
+
+namespace ag
+{
+	BatchProducer::BatchProducer(const Dataset &dataset, const std::string &samplerType, std::shared_ptr<const SampleIndex> index, GameConfig cfg,
+			int batchSize, ml::DataType dtype, int numberOfWorkers, FillFunction fill)
+	{
+		numberOfWorkers = std::max(1, numberOfWorkers);
+		for (int i = 0; i < 2 * numberOfWorkers; i++)
+			packs.push_back(NetworkDataPack(cfg, batchSize, dtype));
+		states.assign(packs.size(), SlotState::FREE);
+
+		const uint64_t seed = randLong();
+		for (int i = 0; i < numberOfWorkers; i++)
+			workers.push_back(std::async(std::launch::async, [this, &dataset, samplerType, index, batchSize, fill, seed, i]()
+			{	worker_loop(dataset, samplerType, index, batchSize, fill, seed + i);}));
+	}
+	BatchProducer::~BatchProducer()
+	{
+		{
+			std::lock_guard<std::mutex> lock(producer_mutex);
+			is_stopping = true;
+		}
+		producer_cond.notify_all();
+		for (size_t i = 0; i < workers.size(); i++)
+			workers[i].wait();
+	}
+	NetworkDataPack& BatchProducer::get()
+	{
+		const double start = getTime();
+		std::unique_lock<std::mutex> lock(producer_mutex);
+		const size_t slot = next_to_consume % packs.size();
+		producer_cond.wait(lock, [this, slot]()
+		{	return worker_exception != nullptr or states[slot] == SlotState::READY;});
+		if (worker_exception != nullptr)
+			std::rethrow_exception(worker_exception);
+		waiting_time += getTime() - start;
+		return packs[slot];
+	}
+	void BatchProducer::release()
+	{
+		{
+			std::lock_guard<std::mutex> lock(producer_mutex);
+			states[next_to_consume % packs.size()] = SlotState::FREE;
+			next_to_consume++;
+		}
+		producer_cond.notify_all();
+	}
+	double BatchProducer::getLoadingTime() const
+	{
+		std::lock_guard<std::mutex> lock(producer_mutex);
+		return loading_time;
+	}
+	double BatchProducer::getWaitingTime() const
+	{
+		std::lock_guard<std::mutex> lock(producer_mutex);
+		return waiting_time;
+	}
+	int BatchProducer::numberOfWorkers() const noexcept
+	{
+		return workers.size();
+	}
+	/*
+	 * private
+	 */
+	void BatchProducer::worker_loop(const Dataset &dataset, const std::string &samplerType, const std::shared_ptr<const SampleIndex> &index,
+			int batchSize, const FillFunction &fill, uint64_t seed)
+	{
+		try
+		{
+			setRandomSeed(seed);
+			std::unique_ptr<Sampler> sampler = createSampler(samplerType);
+			sampler->init(dataset, batchSize, index);
+			while (true)
+			{
+				uint64_t batch_index = 0;
+				{
+					std::unique_lock<std::mutex> lock(producer_mutex);
+					producer_cond.wait(lock, [this]()
+					{	return is_stopping or states[next_to_fill % packs.size()] == SlotState::FREE;});
+					if (is_stopping)
+						return;
+					batch_index = next_to_fill;
+					next_to_fill++;
+					states[batch_index % packs.size()] = SlotState::FILLING;
+				}
+
+				const double start = getTime();
+				fill(packs[batch_index % packs.size()], *sampler);
+				const double stop = getTime();
+
+				{
+					std::lock_guard<std::mutex> lock(producer_mutex);
+					states[batch_index % packs.size()] = SlotState::READY;
+					loading_time += stop - start;
+				}
+				producer_cond.notify_all();
+			}
+		} catch (...)
+		{
+			{
+				std::lock_guard<std::mutex> lock(producer_mutex);
+				if (worker_exception == nullptr)
+					worker_exception = std::current_exception();
+			}
+			producer_cond.notify_all();
+		}
+	}
+
+} /* namespace ag */
@@ -147,6 +147,7 @@ namespace ag
 			generators(selfplayOptions.device_config.size()),
 			game_buffer(gameOptions)
 	{
+		game_buffer.setDeduplication(selfplayOptions.deduplicate_samples);
 		for (size_t i = 0; i < generators.size(); i++)
 			generators[i] = std::make_unique<GeneratorThread>(*this, gameOptions, selfplayOptions, i);
 	}
@@ -158,9 +159,47 @@ namespace ag
 			generators[i]->setWorkingDirectory(path);
 	}
 	void GeneratorManager::addToBuffer(const GameDataStorage &gameData)
+	{
+		GameDataWriter *output = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(buffer_mutex);
+			if (outputs.empty())
+			{
+				game_buffer.addGameData(gameData);
+				return;
+			}
+			size_t index = 0;
+			while (index + 1 < outputs.size() and routed_games[index] >= output_limits[index])
+				index++;
+			routed_games[index]++;
+			output = outputs[index].get();
+		}
+		output->add(gameData); // compression and writing of full chunks does not block other generators
+	}
+	void GeneratorManager::addOutput(const std::string &path, int numberOfGames)
+	{
+		std::unique_ptr<GameDataWriter> writer = std::make_unique<GameDataWriter>(path, game_buffer.getConfig());
+		std::lock_guard<std::mutex> lock(buffer_mutex);
+		routed_games.push_back(writer->numberOfGames());
+		output_limits.push_back(numberOfGames);
+		outputs.push_back(std::move(writer));
+	}
+	void GeneratorManager::closeOutputs()
 	{
 		std::lock_guard<std::mutex> lock(buffer_mutex);
-		game_buffer.addGameData(gameData);
+		for (size_t i = 0; i < outputs.size(); i++)
+			outputs[i]->close();
+		outputs.clear();
+		output_limits.clear();
+		routed_games.clear();
+	}
+	int GeneratorManager::numberOfGames() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(buffer_mutex);
+		int result = game_buffer.numberOfGames();
+		for (size_t i = 0; i < routed_games.size(); i++)
+			result += routed_games[i];
+		return result;
 	}
 	const GameDataBuffer& GeneratorManager::getGameBuffer() const noexcept
 	{
@@ -176,8 +215,7 @@ namespace ag
 	}
 	bool GeneratorManager::hasEnoughGames() const noexcept
 	{
-		std::lock_guard<std::mutex> lock(buffer_mutex);
-		return game_buffer.numberOfGames() >= games_to_generate;
+		return numberOfGames() >= games_to_generate;
 	}
 	void GeneratorManager::generate(const NetworkLoader &loader, int numberOfGames)
 	{
@@ -216,10 +254,18 @@ namespace ag
 		if (counter < 60)
 			printStats();
 	}
+	GameDataBufferStats GeneratorManager::getStats() const
+	{
+		std::lock_guard<std::mutex> lock(buffer_mutex);
+		GameDataBufferStats result = game_buffer.getStats();
+		for (size_t i = 0; i < outputs.size(); i++)
+			result += outputs[i]->getStats();
+		return result;
+	}
 	void GeneratorManager::printStats()
 	{
-		std::cout << "Played games = " << game_buffer.numberOfGames() << "/" << games_to_generate << '\n';
-		std::cout << game_buffer.getStats().toString() << '\n';
+		std::cout << "Played games = " << numberOfGames() << "/" << games_to_generate << '\n';
+		std::cout << getStats().toString() << '\n';
 
 		NNEvaluatorStats evaluator_stats;
 		SearchStats search_stats;
@@ -251,6 +297,8 @@ namespace ag
 			std::cout << "Saving buffer" << std::endl;
 			game_buffer.save(path + "buffer.bin");
 		}
+		for (size_t i = 0; i < outputs.size(); i++)
+			outputs[i]->flush(); // streamed games are already in their files, only the unfinished chunks have to be written
 
 		std::cout << "Saving games" << std::endl;
 		for (size_t i = 0; i < generators.size(); i++)
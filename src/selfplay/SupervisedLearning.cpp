@@ -6,12 +6,14 @@
  */
 
 #include <alphagomoku/selfplay/SupervisedLearning.hpp>
+#include <alphagomoku/selfplay/BatchProducer.hpp>
 #include <alphagomoku/networks/AGNetwork.hpp>
 #include <alphagomoku/patterns/PatternCalculator.hpp>
 #include <alphagomoku/dataset/Dataset.hpp>
 #include <alphagomoku/dataset/GameDataBuffer.hpp>
 #include <alphagomoku/dataset/data_packs.hpp>
 #include <alphagomoku/dataset/Sampler.hpp>
+#include <alphagomoku/dataset/SampleIndex.hpp>
 #include <alphagomoku/game/Move.hpp>
 #include <alphagomoku/game/Board.hpp>
 #include <alphagomoku/utils/augmentations.hpp>
@@ -29,29 +31,25 @@
 #include <iostream>
 #include <iomanip>
 #include <future>
+#include <mutex>
 
 namespace
 {
 	using namespace ag;
 
-	void augment_data_pack(TrainingDataPack &pack)
+	/*
+	 * \brief Augments all samples of the pack with random symmetries. Only the listed targets and masks were packed, so only those are transformed.
+	 */
+	void augment_data_pack(NetworkDataPack &pack, const std::string &targets, const std::string &masks)
 	{
-		const int num_symmetries = number_of_available_symmetries(pack.board.shape());
-		const int r = randInt(num_symmetries);
-		const Symmetry s = int_to_symmetry(r);
-		apply_symmetry_in_place(pack.board, s);
-		apply_symmetry_in_place(pack.visit_count, s);
-		apply_symmetry_in_place(pack.policy_target, s);
-		apply_symmetry_in_place(pack.action_values_target, s);
+		const MatrixShape shape(pack.getGameConfig().rows, pack.getGameConfig().cols);
+		const int num_symmetries = number_of_available_symmetries(shape);
+		std::vector<Symmetry> symmetries(pack.getBatchSize());
+		for (size_t i = 0; i < symmetries.size(); i++)
+			symmetries[i] = int_to_symmetry(randInt(num_symmetries));
+		pack.augment(symmetries, targets, masks);
 	}
 
-	std::array<NetworkDataPack, 2> create_data_packs(GameConfig cfg, int batch_size, ml::DataType dtype)
-	{
-		std::array<NetworkDataPack, 2> result;
-		result[0] = NetworkDataPack(cfg, batch_size, dtype);
-		result[1] = NetworkDataPack(cfg, batch_size, dtype);
-		return result;
-	}
 	void fill_action_values_mask(matrix<float> &mask, const matrix<int> &visits)
 	{
 		assert(equal_shape(mask, visits));
@@ -65,6 +63,54 @@ namespace
 		const ml::Shape shape = ml::change_dim<0>(src.shape(), size);
 		return src.view(shape, offset * shape.volumeWithoutFirstDim());
 	}
+
+	/*
+	 * \brief Packs inputs of a batch in which features of some samples were read from the sample cache.
+	 * Those samples are placed at the end of the batch, while boards of the others are collected at the beginning and encoded together by 'flush'.
+	 */
+	class InputPacker
+	{
+			NetworkDataPack &pack;
+			std::vector<matrix<Sign>> boards;
+			std::vector<Sign> signs_to_move;
+			int next_cached;
+		public:
+			InputPacker(NetworkDataPack &pack) :
+					pack(pack),
+					next_cached(pack.getBatchSize())
+			{
+			}
+			/*
+			 * \brief Returns index in the batch at which the targets of the sample must be packed.
+			 */
+			int add(const TrainingDataPack &sample, const NNInputFeatures &features, bool isCached)
+			{
+				if (isCached)
+				{
+					next_cached--;
+					pack.packInputData(next_cached, features);
+					return next_cached;
+				}
+				boards.push_back(sample.board);
+				signs_to_move.push_back(sample.sign_to_move);
+				return boards.size() - 1;
+			}
+			void flush()
+			{
+				assert(static_cast<int>(boards.size()) == next_cached);
+				pack.packInputData(boards, signs_to_move); // batches are already prepared by several threads, so a single one is used here
+			}
+	};
+
+	std::shared_ptr<const SampleIndex> create_sample_index(const Dataset &dataset, const std::string &weighting)
+	{
+		if (weighting == "games" or dataset.isStreaming())
+			return nullptr; // streamed dataset does not keep all samples in memory, so it always uses its own sampling
+		const double start = getTime();
+		std::shared_ptr<const SampleIndex> result = std::make_shared<const SampleIndex>(dataset, sampleWeightingFromString(weighting));
+		std::cout << "built sample index (" << weighting << ") over " << result->numberOfSamples() << " samples in " << (getTime() - start) << "s\n";
+		return result;
+	}
 }
 
 namespace ag
@@ -91,50 +137,51 @@ namespace ag
 			validation_loss.at(1 + i) += loss.at(i);
 		addVectors(validation_accuracy, acc);
 	}
+	void SupervisedLearning::updateTimingStats(const BatchProducer &producer)
+	{
+		loading_time += producer.getLoadingTime();
+		waiting_time += producer.getWaitingTime();
+		std::cout << "compute time = " << compute_time << "s, loading time = " << loading_time << "s (summed over " << producer.numberOfWorkers()
+				<< " threads), waiting for data = " << waiting_time << "s\n";
+	}
 	void SupervisedLearning::train(AGNetwork &model, const Dataset &dataset, int steps)
 	{
 		ml::Device::cpu().setNumberOfThreads(1);
 		model.get_graph().context().enableTF32(true);
 
 		const int batch_size = model.getBatchSize();
+		const bool augment = config.augment_training_data;
 
-		std::unique_ptr<Sampler> sampler = createSampler(config.sampler_type);
-		sampler->init(dataset, batch_size);
-
-		std::array<NetworkDataPack, 2> data_packs = create_data_packs(model.getGameConfig(), batch_size, model.get_graph().dtype());
-		int current_pack_idx = 0;
-
-		auto loading_function = [&](int idx)
+		auto fill_function = [augment](NetworkDataPack &pack, Sampler &sampler)
 		{
-			const GameConfig cfg = data_packs[idx].getGameConfig();
+			const GameConfig cfg = pack.getGameConfig();
 			TrainingDataPack tdp(cfg.rows, cfg.cols);
+			NNInputFeatures features(cfg.rows, cfg.cols);
 			matrix<float> mask(cfg.rows, cfg.cols);
-			for (int b = 0; b < data_packs[idx].getBatchSize(); b++)
+			InputPacker input_packer(pack);
+			for (int i = 0; i < pack.getBatchSize(); i++)
 			{
-				sampler->get(tdp);
-				if (config.augment_training_data)
-				augment_data_pack(tdp);
-				data_packs[idx].packInputData(b, tdp.board, tdp.sign_to_move);
-				data_packs[idx].packPolicyTarget(b, tdp.policy_target);
-				data_packs[idx].packValueTarget(b, tdp.value_target);
+				const bool is_cached = sampler.get(tdp, features);
+				const int b = input_packer.add(tdp, features, is_cached);
+				pack.packPolicyTarget(b, tdp.policy_target);
+				pack.packValueTarget(b, tdp.value_target);
 				fill_action_values_mask(mask, tdp.visit_count);
-				data_packs[idx].packActionValuesTarget(b, tdp.action_values_target, mask);
-				data_packs[idx].packMovesLeftTarget(b, tdp.moves_left);
+				pack.packActionValuesTarget(b, tdp.action_values_target, mask);
+				pack.packMovesLeftTarget(b, tdp.moves_left);
 			}
+			input_packer.flush();
+			if (augment)
+				augment_data_pack(pack, "psq", "q");
 		};
-		std::future<void> loading_future = std::async(std::launch::async, loading_function, current_pack_idx);
+		BatchProducer producer(dataset, config.sampler_type, create_sample_index(dataset, config.sample_weighting), model.getGameConfig(), batch_size,
+				model.get_graph().dtype(), config.data_loader_threads, fill_function);
 
-		double compute_time = 0.0;
 		for (int i = 0; i < steps;)
 		{
 			if ((i + 1) % std::max(1, (steps / 10)) == 0)
 				std::cout << i + 1 << '\n';
 
-			loading_future.wait();
-			NetworkDataPack &data_pack = data_packs[current_pack_idx];
-
-			current_pack_idx = 1 - current_pack_idx;
-			loading_future = std::async(std::launch::async, loading_function, current_pack_idx);
+			NetworkDataPack &data_pack = producer.get();
 
 			const double t1 = getTime();
 			const std::vector<float> loss = model.train(batch_size, data_pack);
@@ -147,10 +194,11 @@ namespace ag
 				learning_steps++;
 				i++;
 			}
+			producer.release();
 			if (hasCapturedSignal(SignalType::INT))
 				exit(0);
 		}
-		std::cout << "compute time = " << compute_time << '\n';
+		updateTimingStats(producer);
 	}
 	void SupervisedLearning::train(AGNetwork &teacher, AGNetwork &student, const Dataset &dataset, int steps)
 	{
@@ -160,34 +208,37 @@ namespace ag
 		ml::Device::cpu().setNumberOfThreads(1);
 
 		const int batch_size = student.getBatchSize();
+		const bool augment = config.augment_training_data;
 
-		std::unique_ptr<Sampler> sampler = createSampler(config.sampler_type);
-		sampler->init(dataset, batch_size);
-
-		NetworkDataPack student_pack(student.getGameConfig(), batch_size, student.get_graph().dtype());
+		auto fill_function = [augment](NetworkDataPack &pack, Sampler &sampler)
+		{ // only inputs and mask of action values are packed here, the targets come from the teacher network
+			const GameConfig cfg = pack.getGameConfig();
+			TrainingDataPack tdp(cfg.rows, cfg.cols);
+			NNInputFeatures features(cfg.rows, cfg.cols);
+			matrix<Value> tmp_q(cfg.rows, cfg.cols);
+			matrix<float> mask_q(cfg.rows, cfg.cols);
+			InputPacker input_packer(pack);
+			for (int i = 0; i < pack.getBatchSize(); i++)
+			{
+				const bool is_cached = sampler.get(tdp, features);
+				const int b = input_packer.add(tdp, features, is_cached);
+				fill_action_values_mask(mask_q, tdp.visit_count);
+				pack.packActionValuesTarget(b, tmp_q, mask_q);
+			}
+			input_packer.flush();
+			if (augment)
+				augment_data_pack(pack, "", "q"); // targets are filled later by the teacher network, from already augmented input
+		};
+		BatchProducer producer(dataset, config.sampler_type, create_sample_index(dataset, config.sample_weighting), student.getGameConfig(), batch_size,
+				student.get_graph().dtype(), config.data_loader_threads, fill_function);
 		NetworkDataPack teacher_pack(teacher.getGameConfig(), teacher.getBatchSize(), teacher.get_graph().dtype());
 
-		const GameConfig cfg = student_pack.getGameConfig();
-		TrainingDataPack tdp(cfg.rows, cfg.cols);
-		matrix<Value> tmp_q(cfg.rows, cfg.cols);
-		matrix<float> mask_q(cfg.rows, cfg.cols);
-
-		double compute_time = 0.0;
 		for (int i = 0; i < steps;)
 		{
 			if ((i + 1) % std::max(1, (steps / 10)) == 0)
 				std::cout << i + 1 << '\n';
 
-			// pack student batch
-			for (int b = 0; b < student_pack.getBatchSize(); b++)
-			{
-				sampler->get(tdp);
-				if (config.augment_training_data)
-					augment_data_pack(tdp);
-				student_pack.packInputData(b, tdp.board, tdp.sign_to_move);
-				fill_action_values_mask(mask_q, tdp.visit_count);
-				student_pack.packActionValuesTarget(b, tmp_q, mask_q);
-			}
+			NetworkDataPack &student_pack = producer.get();
 
 			// process student batch by teacher network
 			for (int b = 0; b < student_pack.getBatchSize(); b += teacher.getBatchSize())
@@ -223,10 +274,11 @@ namespace ag
 				learning_steps++;
 				i++;
 			}
+			producer.release();
 			if (hasCapturedSignal(SignalType::INT))
 				exit(0);
 		}
-		std::cout << "compute time = " << compute_time << '\n';
+		updateTimingStats(producer);
 	}
 	void SupervisedLearning::validate(AGNetwork &model, const Dataset &dataset)
 	{
@@ -279,6 +331,7 @@ namespace ag
 				history_file << " train_top" << (i + 1) << "_acc";
 			for (size_t i = 0; i < (validation_accuracy.size() - 1); i++)
 				history_file << " val_top" << (i + 1) << "_acc";
+			history_file << " compute_time loading_time waiting_time";
 			history_file << '\n';
 		}
 		else
@@ -298,6 +351,7 @@ namespace ag
 				history_file << " " << 100 * train_acc.at(i);
 			for (size_t i = 0; i < valid_acc.size(); i++)
 				history_file << " " << 100 * valid_acc.at(i);
+			history_file << " " << compute_time << " " << loading_time << " " << waiting_time;
 			history_file << '\n';
 			history_file.close();
 		}
@@ -308,6 +362,9 @@ namespace ag
 		std::fill(training_accuracy.begin(), training_accuracy.end(), 0.0f);
 		std::fill(validation_loss.begin(), validation_loss.end(), 0.0f);
 		std::fill(validation_accuracy.begin(), validation_accuracy.end(), 0.0f);
+		compute_time = 0.0;
+		loading_time = 0.0;
+		waiting_time = 0.0;
 	}
 	Json SupervisedLearning::saveProgress() const
 	{
@@ -7,10 +7,14 @@
 
 #include <alphagomoku/selfplay/TrainingManager.hpp>
 #include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/GameDataWriter.hpp>
+#include <alphagomoku/dataset/IndexedDataset.hpp>
+#include <alphagomoku/dataset/SampleCache.hpp>
 #include <alphagomoku/utils/file_util.hpp>
 #include <alphagomoku/utils/misc.hpp>
 #include <alphagomoku/tuning/GSPRT.hpp>
 
+#include <filesystem>
 #include <string>
 
 namespace
@@ -175,8 +179,15 @@ namespace ag
 	void TrainingManager::generateGames()
 	{
 		const int epoch = get_last_checkpoint();
-		if (pathExists(working_dir + "/train_buffer/buffer_" + std::to_string(epoch) + ".bin"))
+		const std::string train_buffer_path = working_dir + "/train_buffer/buffer_" + std::to_string(epoch) + ".bin";
+		const std::string valid_buffer_path = working_dir + "/valid_buffer/buffer_" + std::to_string(epoch) + ".bin";
+		if (pathExists(train_buffer_path) and (not GameDataWriter::isGameDataStream(train_buffer_path) or GameDataWriter::isComplete(train_buffer_path)))
 		{
+			if (config.generation_config.deduplicate_samples)
+			{ // generation may have been interrupted after the streams were closed, but before they were deduplicated
+				deduplicateBuffer(valid_buffer_path);
+				deduplicateBuffer(train_buffer_path);
+			}
 			std::cout << "Buffer " + std::to_string(epoch) + " already exists\n";
 			return;
 		}
@@ -198,6 +209,10 @@ namespace ag
 			std::cout << "created game generator in " << (t1 - t0) << "s\n";
 		}
 
+		// games are streamed to the buffer files as they finish, interrupted generation continues the same files
+		generator_manager->addOutput(valid_buffer_path, validation_games);
+		generator_manager->addOutput(train_buffer_path, training_games);
+
 		const double start_time = getTime();
 		generator_manager->generate(network_loader, training_games + validation_games);
 		std::cout << "Finished generating games in " << (getTime() - start_time) << "s\n";
@@ -210,13 +225,16 @@ namespace ag
 			return;
 
 		const double t1 = getTime();
-		save_buffer_stats(generator_manager->getGameBuffer());
-		splitBuffer(generator_manager->getGameBuffer(), training_games, validation_games);
-		std::cout << "copied buffer in " << (getTime() - t1) << "s\n";
+		save_buffer_stats(generator_manager->getStats());
+		generator_manager->closeOutputs();
+		if (config.generation_config.deduplicate_samples)
+		{
+			deduplicateBuffer(valid_buffer_path);
+			deduplicateBuffer(train_buffer_path);
+		}
+		std::cout << "closed buffers in " << (getTime() - t1) << "s\n";
 
-		if (config.generation_config.keep_loaded)
-			generator_manager->getGameBuffer().clear();
-		else
+		if (not config.generation_config.keep_loaded)
 		{
 			const double t2 = getTime();
 			generator_manager = nullptr;
@@ -245,6 +263,8 @@ namespace ag
 		model->changeLearningRate(learning_rate);
 
 		sl_manager.train(*model, training_dataset, config.training_config.steps_per_iteration);
+		if (training_dataset.isStreaming())
+			std::cout << training_dataset.getStreamingStats().toString() << '\n';
 		if (not config.training_config.keep_loaded)
 			training_dataset.clear();
 
@@ -354,18 +374,17 @@ namespace ag
 		else
 			std::cout << "network " << last_checkpoint << " REJECTED\n";
 	}
-	void TrainingManager::splitBuffer(GameDataBuffer &buffer, int training_games, int validation_games)
+	void TrainingManager::deduplicateBuffer(const std::string &path)
 	{
-		std::cout << "Saving validation buffer\n";
-		GameDataBuffer tmp(config.game_config);
-		for (int i = 0; i < validation_games; i++)
-			tmp.addGameData(buffer.getGameData(training_games + i));
-		tmp.save(working_dir + "/valid_buffer/buffer_" + std::to_string(get_last_checkpoint()) + ".bin");
-		tmp.clear();
-
-		std::cout << "Saving training buffer\n";
-		buffer.removeRange(training_games, training_games + validation_games);
-		buffer.save(working_dir + "/train_buffer/buffer_" + std::to_string(get_last_checkpoint()) + ".bin");
+		if (not GameDataWriter::isGameDataStream(path))
+			return; // the stream has already been replaced with deduplicated buffer
+		std::cout << "Deduplicating " << path << '\n';
+		GameDataBuffer buffer(config.game_config);
+		buffer.setDeduplication(true);
+		buffer.load(path);
+		// the buffer is saved under temporary name and then replaces the stream, so that interrupted deduplication can be detected and repeated
+		buffer.save(path + ".tmp");
+		std::filesystem::rename(path + ".tmp", path);
 	}
 	void TrainingManager::loadDataset(Dataset &result, const std::string &path)
 	{
@@ -376,10 +395,35 @@ namespace ag
 		const int last_buffer = last_checkpoint;
 		std::cout << "Loading buffers from " << first_buffer << " to " << last_buffer << '\n';
 
+		// indexed buffers are memory mapped, so there is no point in streaming them
+		result.setStreaming(config.training_config.use_indexed_dataset ? 0 : config.training_config.max_resident_samples);
+
 		for (int i = 0; i < first_buffer; i++)
 			result.unload(i);
 		for (int i = first_buffer; i <= last_buffer; i++)
-			result.load(i, path + "buffer_" + std::to_string(i) + ".bin");
+		{
+			const std::string path_to_buffer = path + "buffer_" + std::to_string(i);
+			if (config.training_config.use_indexed_dataset)
+			{
+				if (not result.isLoaded(i) and not pathExists(path_to_buffer + ".idx"))
+					IndexedDataset::convert(path_to_buffer + ".bin", path_to_buffer + ".idx"); // done only once, later iterations just map the file
+				result.load(i, path_to_buffer + ".idx");
+			}
+			else
+				result.load(i, path_to_buffer + ".bin");
+
+			if (config.training_config.use_sample_cache and not result.isStreaming() and not result.hasCache(i))
+			{
+				const std::string path_to_cache = path_to_buffer + ".cache";
+				if (not SampleCache::isUpToDate(path_to_cache, result, i, config.training_config.sampler_type))
+				{ // done once per buffer, unless the encoding of features or the sampler has changed since
+					const double t0 = getTime();
+					SampleCache::save(result, i, config.training_config.sampler_type, path_to_cache);
+					std::cout << "Created sample cache for buffer " << i << " in " << (getTime() - t0) << "s\n";
+				}
+				result.loadCache(i, path_to_cache);
+			}
+		}
 	}
 
 	int TrainingManager::get_last_checkpoint() const
@@ -390,7 +434,7 @@ namespace ag
 	{
 		return metadata["best_checkpoint"].getInt();
 	}
-	void TrainingManager::save_buffer_stats(const GameDataBuffer &buffer) const
+	void TrainingManager::save_buffer_stats(const GameDataBufferStats &stats) const
 	{
 		if (working_dir.empty())
 			return;
@@ -400,7 +444,6 @@ namespace ag
 		if (get_last_checkpoint() == 0)
 			history_file << "#step avg_samples avg_length cross_wins draws circle_wins\n";
 
-		const GameDataBufferStats stats = buffer.getStats();
 		history_file << get_last_checkpoint() << ' ';
 		history_file << (double) stats.samples / stats.games << ' ';
 		history_file << (double) stats.game_length / stats.games << ' ';
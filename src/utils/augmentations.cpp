@@ -8,6 +8,26 @@
 #include <alphagomoku/utils/augmentations.hpp>
 
 #include <cassert>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+namespace
+{
+	using namespace ag;
+
+	template<typename T>
+	void gather(T *dst, const T *src, const std::vector<int> &indices) noexcept
+	{
+		for (size_t i = 0; i < indices.size(); i++)
+			dst[i] = src[indices[i]];
+	}
+}
 
 namespace ag
 {
@@ -41,4 +61,97 @@ namespace ag
 		}
 	}
 
+	SymmetryIndexTable::SymmetryIndexTable(MatrixShape shape, int channels) :
+			shape(shape),
+			channels(channels)
+	{
+		if (channels <= 0)
+			throw std::invalid_argument("SymmetryIndexTable() : number of channels must be positive");
+		matrix<int> cells(shape.rows, shape.cols);
+		std::iota(cells.begin(), cells.end(), 0);
+		matrix<int> tmp = empty_like(cells);
+
+		for (int s = 0; s < number_of_available_symmetries(shape); s++)
+		{
+			apply_symmetry(tmp, cells, int_to_symmetry(s));
+			std::vector<int> table(cells.size() * channels);
+			for (int i = 0; i < tmp.size(); i++)
+				for (int c = 0; c < channels; c++)
+					table[i * channels + c] = tmp[i] * channels + c;
+			indices.push_back(table);
+		}
+	}
+	void SymmetryIndexTable::permuteChannels(Symmetry s, const std::vector<int> &permutation)
+	{
+		if (static_cast<int>(permutation.size()) != channels)
+			throw std::invalid_argument("SymmetryIndexTable::permuteChannels() : expected permutation of " + std::to_string(channels) + " channels");
+		std::vector<int> &table = indices.at(static_cast<int>(s));
+		const std::vector<int> old_table = table;
+		for (size_t i = 0; i < table.size(); i += channels)
+			for (int c = 0; c < channels; c++)
+				table.at(i + permutation[c]) = old_table[i + c];
+	}
+	MatrixShape SymmetryIndexTable::getShape() const noexcept
+	{
+		return shape;
+	}
+	int SymmetryIndexTable::numberOfChannels() const noexcept
+	{
+		return channels;
+	}
+	int SymmetryIndexTable::length() const noexcept
+	{
+		return shape.rows * shape.cols * channels;
+	}
+	const std::vector<int>& SymmetryIndexTable::get(Symmetry s) const noexcept
+	{
+		assert(is_symmetry_allowed(s, shape));
+		return indices[static_cast<int>(s)];
+	}
+	const SymmetryIndexTable& SymmetryIndexTable::getShared(MatrixShape shape, int channels)
+	{
+		static std::mutex table_mutex;
+		static std::map<std::tuple<int, int, int>, std::unique_ptr<SymmetryIndexTable>> tables;
+
+		std::lock_guard<std::mutex> lock(table_mutex);
+		std::unique_ptr<SymmetryIndexTable> &result = tables[std::make_tuple(shape.rows, shape.cols, channels)];
+		if (result == nullptr)
+			result = std::make_unique<SymmetryIndexTable>(shape, channels);
+		return *result;
+	}
+
+	void apply_symmetry_to_batch(void *data, size_t elementSize, const SymmetryIndexTable &table, const std::vector<Symmetry> &symmetries,
+			std::vector<char> &workspace)
+	{
+		const size_t sample_size = elementSize * table.length();
+		workspace.resize(sample_size);
+		for (size_t b = 0; b < symmetries.size(); b++)
+		{
+			if (symmetries[b] == Symmetry::IDENTITY)
+				continue;
+			char *sample = reinterpret_cast<char*>(data) + b * sample_size;
+			std::memcpy(workspace.data(), sample, sample_size);
+			const std::vector<int> &indices = table.get(symmetries[b]);
+			switch (elementSize)
+			{
+				case 1:
+					gather(reinterpret_cast<uint8_t*>(sample), reinterpret_cast<const uint8_t*>(workspace.data()), indices);
+					break;
+				case 2:
+					gather(reinterpret_cast<uint16_t*>(sample), reinterpret_cast<const uint16_t*>(workspace.data()), indices);
+					break;
+				case 4:
+					gather(reinterpret_cast<uint32_t*>(sample), reinterpret_cast<const uint32_t*>(workspace.data()), indices);
+					break;
+				case 8:
+					gather(reinterpret_cast<uint64_t*>(sample), reinterpret_cast<const uint64_t*>(workspace.data()), indices);
+					break;
+				default:
+					for (size_t i = 0; i < indices.size(); i++)
+						std::memcpy(sample + i * elementSize, workspace.data() + indices[i] * elementSize, elementSize);
+					break;
+			}
+		}
+	}
+
 } /* namespace ag */
@@ -141,7 +141,12 @@ namespace ag
 	TrainingConfig::TrainingConfig(const Json &options) :
 			network_arch(get_value<std::string>(options, "network_arch")),
 			sampler_type(get_value<std::string>(options, "sampler_type", "visits")),
+			sample_weighting(get_value<std::string>(options, "sample_weighting", "games")),
 			keep_loaded(get_value<bool>(options, "keep_loaded", true)),
+			use_indexed_dataset(get_value<bool>(options, "use_indexed_dataset", false)),
+			max_resident_samples(get_value<int>(options, "max_resident_samples", 0)),
+			use_sample_cache(get_value<bool>(options, "use_sample_cache", false)),
+			data_loader_threads(get_value<int>(options, "data_loader_threads", 1)),
 			augment_training_data(get_value<bool>(options, "augment_training_data")),
 			device_config(options["device_config"]),
 			steps_per_iteration(get_value<int>(options, "steps_per_iteration")),
@@ -160,7 +165,12 @@ namespace ag
 		Json result;
 		result["network_arch"] = network_arch;
 		result["sampler_type"] = sampler_type;
+		result["sample_weighting"] = sample_weighting;
 		result["keep_loaded"] = keep_loaded;
+		result["use_indexed_dataset"] = use_indexed_dataset;
+		result["max_resident_samples"] = max_resident_samples;
+		result["use_sample_cache"] = use_sample_cache;
+		result["data_loader_threads"] = data_loader_threads;
 		result["augment_training_data"] = augment_training_data;
 		result["device_config"] = device_config.toJson();
 		result["steps_per_iteration"] = steps_per_iteration;
@@ -231,6 +241,7 @@ namespace ag
 			use_opening(get_value<bool>(options, "use_opening")),
 			use_symmetries(get_value<bool>(options, "use_symmetries")),
 			keep_loaded(get_value<bool>(options, "keep_loaded", false)),
+			deduplicate_samples(get_value<bool>(options, "deduplicate_samples", false)),
 			games_per_iteration(get_value<int>(options, "games_per_iteration")),
 			games_per_thread(get_value<int>(options, "games_per_thread")),
 			final_selector(get_value<EdgeSelectorConfig>(options, "final_selector")),
@@ -251,6 +262,7 @@ namespace ag
 		result["use_opening"] = use_opening;
 		result["use_symmetries"] = use_symmetries;
 		result["keep_loaded"] = keep_loaded;
+		result["deduplicate_samples"] = deduplicate_samples;
 		result["games_per_iteration"] = games_per_iteration;
 		result["games_per_thread"] = games_per_thread;
 		result["constraints"] = constraints.toJson();
@@ -14,6 +14,95 @@
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
+#include <cstring>
+#include <future>
+#include <thread>
+
+namespace
+{
+	const char chunked_magic[8] = { 'A', 'G', '_', 'C', 'H', 'U', 'N', 'K' };
+	const uint32_t chunked_version = 1;
+
+	struct ChunkedHeader
+	{
+			char magic[8];
+			uint32_t version;
+			uint32_t number_of_chunks;
+			uint64_t chunk_size;
+			uint64_t total_size;
+	};
+	struct ChunkIndexEntry
+	{
+			uint64_t offset; // from the beginning of the file
+			uint64_t size;
+	};
+
+	ChunkedHeader read_header(const char *ptr, size_t size)
+	{
+		ChunkedHeader result;
+		if (size < sizeof(ChunkedHeader))
+			throw std::runtime_error("read_header() : data is too small to be in chunked format");
+		std::memcpy(&result, ptr, sizeof(ChunkedHeader));
+		if (std::memcmp(result.magic, chunked_magic, sizeof(chunked_magic)) != 0)
+			throw std::runtime_error("read_header() : data is not in chunked format");
+		if (result.version != chunked_version)
+			throw std::runtime_error("read_header() : unsupported version " + std::to_string(result.version));
+		if (result.chunk_size == 0 and result.total_size > 0)
+			throw std::runtime_error("read_header() : invalid chunk size");
+		return result;
+	}
+	size_t get_chunk_length(const ChunkedHeader &header, size_t index) noexcept
+	{
+		return std::min(header.chunk_size, header.total_size - index * header.chunk_size);
+	}
+	/*
+	 * \brief Reads index of chunks that follows the header, checking that all chunks lie after the index and within 'dataSize' bytes.
+	 * 'size' is the number of bytes available under 'ptr', which points to the beginning of the header.
+	 */
+	std::vector<ChunkIndexEntry> read_index(const ChunkedHeader &header, const char *ptr, size_t size, uint64_t dataSize)
+	{
+		const uint64_t expected_chunks = (header.total_size == 0) ? 0 : (1 + (header.total_size - 1) / header.chunk_size);
+		if (header.number_of_chunks != expected_chunks)
+			throw std::runtime_error("read_index() : number of chunks does not match size of the data");
+		const uint64_t index_end = sizeof(ChunkedHeader) + sizeof(ChunkIndexEntry) * static_cast<uint64_t>(header.number_of_chunks);
+		if (index_end > size)
+			throw std::runtime_error("read_index() : index of chunks is truncated");
+
+		std::vector<ChunkIndexEntry> result(header.number_of_chunks);
+		for (size_t i = 0; i < result.size(); i++)
+		{
+			std::memcpy(&result[i], ptr + sizeof(ChunkedHeader) + sizeof(ChunkIndexEntry) * i, sizeof(ChunkIndexEntry));
+			if (result[i].offset < index_end or result[i].offset > dataSize or result[i].size > dataSize - result[i].offset)
+				throw std::runtime_error("read_index() : chunk " + std::to_string(i) + " is outside of the data");
+		}
+		return result;
+	}
+
+	/*
+	 * \brief Calls function(i) for all i in [0, n) using several threads.
+	 */
+	template<typename Fn>
+	void parallel_for(size_t n, int numberOfThreads, Fn function)
+	{
+		const size_t available = (numberOfThreads <= 0) ? std::max(1u, std::thread::hardware_concurrency()) : numberOfThreads;
+		const size_t threads = std::max(static_cast<size_t>(1), std::min(available, n));
+		if (threads == 1)
+		{
+			for (size_t i = 0; i < n; i++)
+				function(i);
+			return;
+		}
+		std::vector<std::future<void>> futures;
+		for (size_t t = 0; t < threads; t++)
+			futures.push_back(std::async(std::launch::async, [&function, n, threads, t]()
+			{
+				for (size_t i = t; i < n; i += threads)
+					function(i);
+			}));
+		for (size_t t = 0; t < futures.size(); t++)
+			futures[t].get();
+	}
+}
 
 namespace ag
 {
@@ -30,6 +119,163 @@ namespace ag
 		return std::filesystem::remove(path);
 	}
 
+	bool isChunkedFormat(const std::vector<char> &data) noexcept
+	{
+		return data.size() >= sizeof(chunked_magic) and std::memcmp(data.data(), chunked_magic, sizeof(chunked_magic)) == 0;
+	}
+	bool isChunkedFile(const std::string &path)
+	{
+		std::ifstream stream(path, std::ios::in | std::ios::binary);
+		std::vector<char> magic(sizeof(chunked_magic));
+		stream.read(magic.data(), magic.size());
+		return stream.good() and isChunkedFormat(magic);
+	}
+	std::vector<char> compressChunked(const std::vector<char> &data, size_t chunkSize, int numberOfThreads)
+	{
+		if (chunkSize == 0)
+			throw std::invalid_argument("compressChunked() : chunk size must be positive");
+		const size_t number_of_chunks = (data.size() + chunkSize - 1) / chunkSize;
+
+		std::vector<std::vector<char>> chunks(number_of_chunks);
+		parallel_for(number_of_chunks, numberOfThreads, [&](size_t i)
+		{
+			const size_t begin = i * chunkSize;
+			const size_t end = std::min(data.size(), begin + chunkSize);
+			chunks[i] = ZipWrapper::compress(std::vector<char>(data.begin() + begin, data.begin() + end));
+		});
+
+		ChunkedHeader header;
+		std::memcpy(header.magic, chunked_magic, sizeof(chunked_magic));
+		header.version = chunked_version;
+		header.number_of_chunks = number_of_chunks;
+		header.chunk_size = chunkSize;
+		header.total_size = data.size();
+
+		std::vector<ChunkIndexEntry> index(number_of_chunks);
+		size_t offset = sizeof(ChunkedHeader) + sizeof(ChunkIndexEntry) * number_of_chunks;
+		for (size_t i = 0; i < number_of_chunks; i++)
+		{
+			index[i] = ChunkIndexEntry { offset, chunks[i].size() };
+			offset += chunks[i].size();
+		}
+
+		std::vector<char> result(offset);
+		std::memcpy(result.data(), &header, sizeof(ChunkedHeader));
+		for (size_t i = 0; i < number_of_chunks; i++)
+		{
+			std::memcpy(result.data() + sizeof(ChunkedHeader) + sizeof(ChunkIndexEntry) * i, &index[i], sizeof(ChunkIndexEntry));
+			std::memcpy(result.data() + index[i].offset, chunks[i].data(), chunks[i].size());
+		}
+		return result;
+	}
+	std::vector<char> uncompressChunked(const std::vector<char> &data, int numberOfThreads)
+	{
+		const ChunkedHeader header = read_header(data.data(), data.size());
+		const std::vector<ChunkIndexEntry> index = read_index(header, data.data(), data.size(), data.size());
+
+		std::vector<char> result(header.total_size);
+		parallel_for(header.number_of_chunks, numberOfThreads, [&](size_t i)
+		{
+			const ChunkIndexEntry entry = index[i];
+			const std::vector<char> chunk = ZipWrapper::uncompress(std::vector<char>(data.begin() + entry.offset, data.begin() + entry.offset + entry.size));
+			if (chunk.size() != get_chunk_length(header, i))
+				throw std::runtime_error("uncompressChunked() : chunk " + std::to_string(i) + " is corrupted");
+			std::memcpy(result.data() + i * header.chunk_size, chunk.data(), chunk.size());
+		});
+		return result;
+	}
+
+	ChunkedFileReader::ChunkedFileReader(const std::string &path) :
+			path(path)
+	{
+		std::ifstream stream(path, std::ios::in | std::ios::binary);
+		if (not stream.is_open())
+			throw std::runtime_error("ChunkedFileReader() : could not open file '" + path + "'");
+		const uint64_t file_size = std::filesystem::file_size(path);
+
+		std::vector<char> buffer(sizeof(ChunkedHeader));
+		stream.read(buffer.data(), buffer.size());
+		const ChunkedHeader header = read_header(buffer.data(), stream.gcount());
+		chunk_size = header.chunk_size;
+		total_size = header.total_size;
+
+		const uint64_t index_size = sizeof(ChunkIndexEntry) * static_cast<uint64_t>(header.number_of_chunks);
+		if (sizeof(ChunkedHeader) + index_size > file_size)
+			throw std::runtime_error("ChunkedFileReader() : index of chunks in file '" + path + "' is truncated");
+		buffer.resize(sizeof(ChunkedHeader) + index_size);
+		stream.read(buffer.data() + sizeof(ChunkedHeader), index_size);
+		const std::vector<ChunkIndexEntry> index = read_index(header, buffer.data(), sizeof(ChunkedHeader) + stream.gcount(), file_size);
+		for (size_t i = 0; i < index.size(); i++)
+		{
+			chunk_offsets.push_back(index[i].offset);
+			chunk_sizes.push_back(index[i].size);
+		}
+	}
+	size_t ChunkedFileReader::size() const noexcept
+	{
+		return total_size;
+	}
+	std::vector<char> ChunkedFileReader::read(size_t offset, size_t length, int numberOfThreads) const
+	{
+		if (offset > total_size or length > total_size - offset)
+			throw std::out_of_range("ChunkedFileReader::read() : range [" + std::to_string(offset) + ", " + std::to_string(offset + length)
+					+ ") is outside of the data of size " + std::to_string(total_size));
+		std::vector<char> result(length);
+		if (length == 0)
+			return result;
+
+		const size_t first_chunk = offset / chunk_size;
+		const size_t last_chunk = (offset + length - 1) / chunk_size;
+
+		// chunks are stored one after another, so all needed ones can be read at once
+		const uint64_t file_begin = chunk_offsets[first_chunk];
+		std::vector<char> compressed(chunk_offsets[last_chunk] + chunk_sizes[last_chunk] - file_begin);
+		std::ifstream stream(path, std::ios::in | std::ios::binary);
+		stream.seekg(file_begin);
+		stream.read(compressed.data(), compressed.size());
+		if (not stream.good())
+			throw std::runtime_error("ChunkedFileReader::read() : could not read chunks from file '" + path + "'");
+
+		parallel_for(last_chunk - first_chunk + 1, numberOfThreads, [&](size_t i)
+		{
+			const size_t chunk_index = first_chunk + i;
+			const size_t begin = chunk_offsets[chunk_index] - file_begin;
+			const std::vector<char> chunk = ZipWrapper::uncompress(std::vector<char>(compressed.begin() + begin, compressed.begin() + begin + chunk_sizes[chunk_index]));
+			const size_t chunk_begin = chunk_index * chunk_size;
+			if (chunk.size() != std::min(chunk_size, total_size - chunk_begin))
+				throw std::runtime_error("ChunkedFileReader::read() : chunk " + std::to_string(chunk_index) + " of file '" + path + "' is corrupted");
+
+			// intersection of this chunk with the requested range
+			const size_t copy_begin = std::max(offset, chunk_begin);
+			const size_t copy_end = std::min(offset + length, chunk_begin + chunk.size());
+			if (copy_end > copy_begin)
+				std::memcpy(result.data() + (copy_begin - offset), chunk.data() + (copy_begin - chunk_begin), copy_end - copy_begin);
+		});
+		return result;
+	}
+	Json ChunkedFileReader::readJson() const
+	{
+		std::string json_string;
+		int opened_braces = 0;
+		for (size_t offset = 0; offset < total_size; offset += chunk_size)
+		{
+			const std::vector<char> chunk = read(offset, std::min(chunk_size, total_size - offset));
+			for (size_t i = 0; i < chunk.size(); i++)
+			{
+				json_string.push_back(chunk[i]);
+				if (json_string == "null")
+					return Json();
+				if (chunk[i] == '{' || chunk[i] == '[')
+					opened_braces++;
+				if (chunk[i] == '}' || chunk[i] == ']')
+					opened_braces--;
+				if (opened_braces == 0 and json_string.size() > 1) // same rule as in FileLoader, but the first character must be a brace
+					return Json::load(json_string);
+			}
+		}
+		throw std::runtime_error("ChunkedFileReader::readJson() : json in file '" + path + "' is not complete");
+	}
+
 	FileSaver::FileSaver(const std::string &path) :
 			path(path),
 			stream(path, std::ofstream::out)
@@ -47,7 +293,7 @@ namespace ag
 		to_save.push_back('\n');
 		to_save.insert(to_save.end(), binary_data.data(), binary_data.data() + binary_data.size());
 		if (compress == true)
-			to_save = ZipWrapper::compress(to_save);
+			to_save = compressChunked(to_save);
 		stream.write(to_save.data(), to_save.size());
 	}
 	void FileSaver::save(const Json &json, int indent)
@@ -73,7 +319,7 @@ namespace ag
 		file.close();
 
 		if (uncompress == true)
-			loaded_data = ZipWrapper::uncompress(loaded_data);
+			loaded_data = isChunkedFormat(loaded_data) ? uncompressChunked(loaded_data) : ZipWrapper::uncompress(loaded_data); // files saved as a single stream are still supported
 		split_point = std::min(loaded_data.size(), find_split_point());
 		load_all_data();
 	}
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <stdexcept>
+#include <utility>
 #include <csignal>
 
 #if defined(_WIN32)
@@ -16,6 +17,9 @@
 #elif defined(__linux__)
 #  include <limits.h>
 #  include <unistd.h>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
 #  include <sys/utsname.h>
 #endif
 
@@ -203,5 +207,91 @@ namespace ag
 				return false; // unknown signal type
 		}
 	}
+
+	MemoryMappedFile::MemoryMappedFile(const std::string &path)
+	{
+#if defined(_WIN32)
+		m_file_handle = CreateFileA(path.data(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (m_file_handle == INVALID_HANDLE_VALUE)
+		{
+			m_file_handle = nullptr;
+			throw std::runtime_error("MemoryMappedFile() : could not open file '" + path + "'");
+		}
+		LARGE_INTEGER file_size;
+		if (GetFileSizeEx(m_file_handle, &file_size) == 0 or file_size.QuadPart == 0)
+		{
+			close();
+			throw std::runtime_error("MemoryMappedFile() : file '" + path + "' is empty or its size cannot be read");
+		}
+		m_mapping_handle = CreateFileMappingA(m_file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (m_mapping_handle != nullptr)
+			m_data = MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0);
+		if (m_data == nullptr)
+		{
+			close();
+			throw std::runtime_error("MemoryMappedFile() : could not map file '" + path + "'");
+		}
+		m_size = static_cast<size_t>(file_size.QuadPart);
+#elif defined(__linux__)
+		const int fd = open(path.data(), O_RDONLY);
+		if (fd == -1)
+			throw std::runtime_error("MemoryMappedFile() : could not open file '" + path + "'");
+		struct stat file_info;
+		if (fstat(fd, &file_info) == -1 or file_info.st_size == 0)
+		{
+			::close(fd);
+			throw std::runtime_error("MemoryMappedFile() : file '" + path + "' is empty or its size cannot be read");
+		}
+		void *ptr = mmap(nullptr, file_info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd); // the mapping remains valid after closing the descriptor
+		if (ptr == MAP_FAILED)
+			throw std::runtime_error("MemoryMappedFile() : could not map file '" + path + "'");
+		m_data = ptr;
+		m_size = static_cast<size_t>(file_info.st_size);
+#endif
+	}
+	MemoryMappedFile::MemoryMappedFile(MemoryMappedFile &&other) noexcept :
+			m_data(std::exchange(other.m_data, nullptr)),
+			m_size(std::exchange(other.m_size, 0))
+#if defined(_WIN32)
+			,
+			m_file_handle(std::exchange(other.m_file_handle, nullptr)),
+			m_mapping_handle(std::exchange(other.m_mapping_handle, nullptr))
+#endif
+	{
+	}
+	MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile &&other) noexcept
+	{
+		std::swap(this->m_data, other.m_data);
+		std::swap(this->m_size, other.m_size);
+#if defined(_WIN32)
+		std::swap(this->m_file_handle, other.m_file_handle);
+		std::swap(this->m_mapping_handle, other.m_mapping_handle);
+#endif
+		return *this;
+	}
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		close();
+	}
+	void MemoryMappedFile::close() noexcept
+	{
+#if defined(_WIN32)
+		if (m_data != nullptr)
+			UnmapViewOfFile(m_data);
+		if (m_mapping_handle != nullptr)
+			CloseHandle(m_mapping_handle);
+		if (m_file_handle != nullptr)
+			CloseHandle(m_file_handle);
+		m_mapping_handle = nullptr;
+		m_file_handle = nullptr;
+#elif defined(__linux__)
+		if (m_data != nullptr)
+			munmap(const_cast<void*>(m_data), m_size);
+#endif
+		m_data = nullptr;
+		m_size = 0;
+	}
+
 } /* namespace ag */
 
@@ -68,6 +68,11 @@ namespace ag
 	{
 		return static_cast<bool>(int32_generator() & 1);
 	}
+	void setRandomSeed(uint64_t seed)
+	{
+		int32_generator.seed(static_cast<uint32_t>(seed ^ (seed >> 32)));
+		int64_generator.seed(seed);
+	}
 
 	float randBeta(float alpha, float beta)
 	{
@@ -0,0 +1,166 @@
+/*
+ * test_Dataset.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/Dataset.hpp>
+#include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/GameDataWriter.hpp>
+#include <alphagomoku/dataset/data_packs.hpp>
+#include <alphagomoku/utils/file_util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "test_utils.hpp"
+
+namespace ag
+{
+	TEST(TestDataset, streamingKeepsMemoryLimit)
+	{
+		const int number_of_buffers = 6;
+		for (int i = 0; i < number_of_buffers; i++)
+			create_buffer(std::vector<int>(10, 5)).save(get_path("streamed_buffer", i)); // 50 samples each
+
+		Dataset dataset;
+		dataset.setStreaming(120, 1); // 2 buffers fit within the limit
+		for (int i = 0; i < number_of_buffers; i++)
+			dataset.load(i, get_path("streamed_buffer", i));
+		EXPECT_TRUE(dataset.isStreaming());
+		EXPECT_EQ(dataset.numberOfBuffers(), number_of_buffers);
+
+		std::vector<std::weak_ptr<const GameDataBuffer>> drawn;
+		for (int i = 0; i < 200; i++)
+		{
+			const std::shared_ptr<const GameDataBuffer> buffer = dataset.drawBuffer();
+			EXPECT_EQ(buffer->numberOfSamples(), 50);
+			drawn.push_back(buffer);
+
+			std::set<const GameDataBuffer*> resident;
+			for (size_t j = 0; j < drawn.size(); j++)
+				if (not drawn[j].expired())
+					resident.insert(drawn[j].lock().get());
+			EXPECT_LE(resident.size(), 2u + 2u); // limit plus buffers scheduled for the next draws
+		}
+
+		const StreamingStats stats = dataset.getStreamingStats();
+		EXPECT_EQ(stats.draws, 200u);
+		EXPECT_EQ(stats.hits + stats.prefetch_waits + stats.misses, stats.draws);
+		EXPECT_GT(stats.evictions, 0u);
+		EXPECT_EQ(dataset.numberOfSamples(), number_of_buffers * 50);
+
+		dataset.clear();
+		for (int i = 0; i < number_of_buffers; i++)
+			removeFile(get_path("streamed_buffer", i));
+	}
+	TEST(TestDataset, streamingDrawsProportionallyToSamples)
+	{
+		create_buffer(std::vector<int>(10, 5)).save(get_path("streamed_buffer", 0));
+		create_buffer(std::vector<int>(30, 5)).save(get_path("streamed_buffer", 1));
+
+		Dataset dataset;
+		dataset.setStreaming(1000);
+		dataset.load(0, get_path("streamed_buffer", 0));
+		dataset.load(1, get_path("streamed_buffer", 1));
+
+		const int draws = 4000;
+		int larger = 0;
+		for (int i = 0; i < draws; i++)
+			larger += (dataset.drawBuffer()->numberOfGames() == 30) ? 1 : 0;
+		EXPECT_NEAR(static_cast<double>(larger) / draws, 0.75, 0.05);
+		EXPECT_EQ(dataset.getStreamingStats().evictions, 0u);
+
+		dataset.clear();
+		removeFile(get_path("streamed_buffer", 0));
+		removeFile(get_path("streamed_buffer", 1));
+	}
+	TEST(TestDataset, accessToStreamedBuffers)
+	{
+		auto fill_sample = [](SearchDataPack &sample, int m)
+		{	sample.visit_count.at(14, 14) = 1 + m;};
+		create_buffer(std::vector<int>(10, 5), fill_sample).save(get_path("streamed_buffer", 0));
+		create_buffer(std::vector<int>(20, 3), fill_sample).save(get_path("streamed_buffer", 1));
+
+		Dataset dataset;
+		dataset.setStreaming(40, 0); // only one buffer can be kept in memory
+		dataset.load(0, get_path("streamed_buffer", 0));
+		dataset.load(1, get_path("streamed_buffer", 1));
+		EXPECT_EQ(dataset.numberOfGames(), 10 + 20);
+		EXPECT_EQ(dataset.numberOfSamples(), 50 + 60);
+		EXPECT_EQ(dataset.getStats().samples, 50u + 60u);
+
+		EXPECT_EQ(dataset.getConfig(0).rows, 15);
+		EXPECT_EQ(dataset.numberOfGames(0), 10);
+		EXPECT_EQ(dataset.numberOfGames(1), 20);
+		EXPECT_EQ(dataset.numberOfSamples(0, 9), 5);
+		EXPECT_EQ(dataset.numberOfSamples(1, 19), 3);
+		EXPECT_EQ(dataset.getStreamingStats().loads, 0u); // all of the above is known from the summaries saved in the files
+
+		SearchDataPack sample(15, 15);
+		for (int b = 0; b < 2; b++)
+			for (int i = 0; i < dataset.numberOfGames(b); i++)
+				for (int j = 0; j < dataset.numberOfSamples(b, i); j++)
+				{
+					dataset.getSample(sample, b, i, j);
+					EXPECT_EQ(sample.played_move, Move(j, i % 15, (j % 2 == 0) ? Sign::CROSS : Sign::CIRCLE));
+					EXPECT_EQ(sample.visit_count.at(14, 14), 1 + j);
+				}
+		EXPECT_THROW(dataset.getSample(sample, 2, 0, 0), std::runtime_error);
+		EXPECT_EQ(dataset.getStreamingStats().loads, 2u);
+		EXPECT_GT(dataset.getStreamingStats().evictions, 0u); // the first buffer was evicted when the second one was loaded
+
+		dataset.clear();
+		removeFile(get_path("streamed_buffer", 0));
+		removeFile(get_path("streamed_buffer", 1));
+	}
+	TEST(TestDataset, streamingReadsSummaryOfAllKindsOfFiles)
+	{
+		const GameDataBuffer buffer = create_buffer( { 3, 5, 7 });
+		buffer.save(get_path("streamed_buffer", 0));
+		{ /* artificial scope for closing the file */
+			GameDataWriter writer(get_path("streamed_buffer", 1), get_test_config(), 2);
+			for (int i = 0; i < buffer.numberOfGames(); i++)
+				writer.add(buffer.getGameData(i));
+			writer.close();
+		}
+		GameDataWriter unfinished(get_path("streamed_buffer", 2), get_test_config(), 1); // stream without summary must be loaded to calculate it
+		for (int i = 0; i < buffer.numberOfGames(); i++)
+			unfinished.add(buffer.getGameData(i));
+
+		Dataset dataset;
+		dataset.setStreaming(1000);
+		for (int b = 0; b < 3; b++)
+		{
+			const GameDataBufferSummary summary = GameDataBuffer::loadSummary(get_path("streamed_buffer", b));
+			EXPECT_EQ(summary.samples_per_game, std::vector<int>( { 3, 5, 7 }));
+			EXPECT_EQ(summary.stats.samples, 15u);
+			EXPECT_EQ(summary.stats.draws, 3u);
+
+			dataset.load(b, get_path("streamed_buffer", b));
+			EXPECT_EQ(dataset.numberOfGames(b), 3);
+			for (int i = 0; i < 3; i++)
+				EXPECT_EQ(dataset.numberOfSamples(b, i), buffer.getGameData(i).numberOfSamples());
+		}
+		EXPECT_EQ(dataset.numberOfSamples(), 3 * 15);
+		EXPECT_EQ(dataset.getStreamingStats().loads, 0u);
+
+		dataset.clear();
+		unfinished.close();
+		for (int b = 0; b < 3; b++)
+			removeFile(get_path("streamed_buffer", b));
+	}
+	TEST(TestDataset, streamingModeChangeRequiresEmptyDataset)
+	{
+		create_buffer( { 1 }).save(get_path("streamed_buffer", 0));
+		Dataset dataset;
+		dataset.load(0, get_path("streamed_buffer", 0));
+		EXPECT_THROW(dataset.setStreaming(100), std::logic_error);
+		dataset.clear();
+		EXPECT_NO_THROW(dataset.setStreaming(100));
+		removeFile(get_path("streamed_buffer", 0));
+	}
+
+} /* namespace ag */
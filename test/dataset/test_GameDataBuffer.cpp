@@ -0,0 +1,166 @@
+/*
+ * test_GameDataBuffer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/dataset/DeduplicationIndex.hpp>
+#include <alphagomoku/dataset/data_packs.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_utils.hpp"
+
+namespace
+{
+	using namespace ag;
+
+	/*
+	 * \brief Game in which the first 'commonMoves' moves are the same for all values of 'variant'.
+	 */
+	GameDataStorage create_branching_game(int variant, int commonMoves, int length, GameOutcome outcome)
+	{
+		return create_game(length, outcome, [=](int m)
+		{	return (m < commonMoves) ? Move(7, m) : Move(10 + variant, m);}, [=](SearchDataPack &sample, int m)
+		{
+			sample.visit_count.at(0, 0) = 10;
+			sample.action_values.at(0, 0) = Value(0.1f * (variant + 1), 0.0f);
+			sample.policy_prior.at(0, 0) = 0.5f;
+		});
+	}
+}
+
+namespace ag
+{
+	TEST(TestGameDataBuffer, deduplicate)
+	{
+		GameDataBuffer buffer(GameConfig(GameRules::STANDARD, 15));
+		buffer.addGameData(create_branching_game(0, 3, 6, GameOutcome::DRAW));
+		buffer.addGameData(create_branching_game(1, 3, 6, GameOutcome::DRAW));
+		buffer.addGameData(create_branching_game(2, 3, 6, GameOutcome::CROSS_WIN)); // different outcome, so nothing is merged
+
+		EXPECT_EQ(buffer.deduplicate(), 4); // positions before each of the common moves and right after them
+		EXPECT_EQ(buffer.getGameData(0).numberOfSamples(), 6);
+		EXPECT_EQ(buffer.getGameData(1).numberOfSamples(), 2);
+		EXPECT_EQ(buffer.getGameData(2).numberOfSamples(), 6);
+
+		SearchDataPack sample(15, 15);
+		buffer.getGameData(0).getSample(sample, 1);
+		EXPECT_EQ(sample.visit_count.at(0, 0), 20);
+		EXPECT_NEAR(sample.action_values.at(0, 0).win_rate, 0.15f, 0.02f);
+		EXPECT_EQ(sample.played_move, Move(7, 1, Sign::CIRCLE));
+		buffer.getGameData(1).getSample(sample, 0); // first sample after the common part
+		EXPECT_EQ(sample.played_move, Move(11, 4, Sign::CROSS));
+		EXPECT_EQ(sample.visit_count.at(0, 0), 10);
+
+		const GameDataBufferStats stats = buffer.getStats();
+		EXPECT_EQ(stats.samples, 14u);
+		EXPECT_EQ(stats.duplicates, 4u);
+		EXPECT_EQ(buffer.deduplicate(), 0);
+	}
+	TEST(TestGameDataBuffer, onlineDeduplication)
+	{
+		GameDataBuffer buffer(GameConfig(GameRules::STANDARD, 15));
+		buffer.addGameData(create_branching_game(0, 4, 5, GameOutcome::CIRCLE_WIN));
+		buffer.setDeduplication(true); // games already in the buffer are indexed as well
+		buffer.addGameData(create_branching_game(1, 4, 5, GameOutcome::CIRCLE_WIN));
+		buffer.addGameData(create_branching_game(2, 2, 5, GameOutcome::CIRCLE_WIN));
+		EXPECT_EQ(buffer.numberOfSamples(), 5 + 0 + 2);
+
+		SearchDataPack sample(15, 15);
+		buffer.getGameData(0).getSample(sample, 0);
+		EXPECT_EQ(sample.visit_count.at(0, 0), 30);
+		buffer.getGameData(0).getSample(sample, 3);
+		EXPECT_EQ(sample.visit_count.at(0, 0), 20);
+
+		buffer.removeFromBuffer(0); // invalidates the index, which is rebuilt with the next game
+		buffer.addGameData(create_branching_game(2, 2, 5, GameOutcome::CIRCLE_WIN)); // only the last two samples are still in the buffer
+		EXPECT_EQ(buffer.numberOfSamples(), 0 + 2 + 3);
+		EXPECT_EQ(buffer.getStats().duplicates, 5u + 3u + 2u);
+	}
+	TEST(TestGameDataBuffer, deduplicateManyCopies)
+	{
+		const int copies = 300;
+		GameDataBuffer buffer = create_buffer(copies, [=](int g)
+		{	return create_game(1, GameOutcome::DRAW, [](int m)
+			{	return Move(7, 7);}, [=](SearchDataPack &sample, int m)
+			{
+				sample.visit_count.at(0, 0) = 1 + g % 5;
+				sample.visit_count.at(0, 1) = 1;
+				sample.policy_prior.at(0, 0) = 1.0f;
+				sample.policy_prior.at(0, 1) = (g < copies / 2) ? 0.3f : 0.4f;
+			});});
+
+		EXPECT_EQ(buffer.deduplicate(), copies - 1);
+		SearchDataPack sample(15, 15);
+		buffer.getGameData(0).getSample(sample, 0);
+		EXPECT_EQ(sample.visit_count.at(0, 0), 3 * copies);
+		EXPECT_NEAR(sample.policy_prior.at(0, 1), 0.35f, 0.01f); // merged at full precision, so the error of encoding does not accumulate
+	}
+	TEST(TestGameDataBuffer, onlineDeduplicationOfManyCopies)
+	{
+		const int copies = 300;
+		GameDataBuffer buffer(get_test_config());
+		buffer.setDeduplication(true);
+		for (int g = 0; g < copies; g++)
+		{
+			buffer.addGameData(create_game(1, GameOutcome::DRAW, [](int m)
+			{	return Move(7, 7);}, [=](SearchDataPack &sample, int m)
+			{
+				sample.visit_count.at(0, 0) = 1 + g % 5;
+				sample.visit_count.at(0, 1) = 1;
+				sample.policy_prior.at(0, 0) = 1.0f;
+				sample.policy_prior.at(0, 1) = (g < copies / 2) ? 0.3f : 0.4f;
+			}));
+			buffer.getGameData(0); // plain access does not invalidate the index
+		}
+
+		EXPECT_EQ(buffer.numberOfSamples(), 1);
+		SearchDataPack sample(15, 15);
+		buffer.getGameData(0).getSample(sample, 0);
+		EXPECT_EQ(sample.visit_count.at(0, 0), 3 * copies);
+		EXPECT_NEAR(sample.policy_prior.at(0, 1), 0.35f, 0.01f); // every merge starts from the full precision copy, so the rounding does not accumulate
+	}
+	TEST(TestGameDataBuffer, mergeWeightsSurviveRebuildOfIndex)
+	{
+		auto create = [](float prior)
+		{
+			return create_game(1, GameOutcome::DRAW, [](int m)
+			{	return Move(7, 7);}, [=](SearchDataPack &sample, int m)
+			{
+				sample.visit_count.at(0, 0) = 9;
+				sample.visit_count.at(0, 1) = 1;
+				sample.policy_prior.at(0, 1) = prior;
+			});
+		};
+		GameDataBuffer buffer(get_test_config());
+		buffer.setDeduplication(true);
+		buffer.addGameData(create(0.2f));
+		buffer.addGameData(create(0.5f));
+		buffer.addGameData(create_branching_game(0, 0, 1, GameOutcome::CROSS_WIN));
+		buffer.removeFromBuffer(2); // the index is rebuilt with the next game, without the number of samples that were merged
+		buffer.addGameData(create(0.8f));
+
+		EXPECT_EQ(buffer.numberOfSamples(), 1);
+		SearchDataPack sample(15, 15);
+		buffer.getGameData(0).getSample(sample, 0);
+		EXPECT_EQ(sample.visit_count.at(0, 0), 27);
+		EXPECT_NEAR(sample.policy_prior.at(0, 1), 0.5f, 0.01f); // weighted by visits stored in the merged sample
+	}
+	TEST(TestGameDataBuffer, mergedVisitsAreClampedInOldFormat)
+	{
+		GameDataStorage game(15, 15, 100);
+		SearchDataPack sample(15, 15);
+		sample.visit_count.at(0, 0) = 100000;
+		sample.played_move = Move(7, 7, Sign::CROSS);
+		game.addSample(sample);
+		game.addMove(sample.played_move);
+
+		game.getSample(sample, 0);
+		EXPECT_EQ(sample.visit_count.at(0, 0), 65535);
+	}
+
+} /* namespace ag */
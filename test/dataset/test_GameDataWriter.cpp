@@ -0,0 +1,185 @@
+/*
+ * test_GameDataWriter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/GameDataWriter.hpp>
+#include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/dataset/data_packs.hpp>
+#include <alphagomoku/utils/file_util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <fstream>
+#include <thread>
+
+#include "test_utils.hpp"
+
+namespace
+{
+	using namespace ag;
+
+	GameDataStorage create_numbered_game(int variant, int length)
+	{
+		return create_game(length, (variant % 2 == 0) ? GameOutcome::CROSS_WIN : GameOutcome::DRAW, [=](int m)
+		{	return Move(variant % 15, m);}, [=](SearchDataPack &sample, int m)
+		{	sample.visit_count.at(0, 0) = variant;});
+	}
+	std::vector<GameDataStorage> read_games(const std::string &path)
+	{
+		GameConfig cfg;
+		std::vector<GameDataStorage> result;
+		GameDataWriter::read(path, cfg, result);
+		return result;
+	}
+}
+
+namespace ag
+{
+	TEST(TestGameDataWriter, writeAndRead)
+	{
+		const GameConfig cfg(GameRules::STANDARD, 15);
+		{ /* artificial scope for closing the file */
+			GameDataWriter writer("test_games.bin", cfg, 4);
+			for (int i = 0; i < 10; i++)
+				writer.add(create_numbered_game(i, 3 + i));
+			EXPECT_EQ(writer.numberOfGames(), 10);
+			EXPECT_EQ(writer.getStats().games, 10u);
+			writer.close();
+			EXPECT_THROW(writer.add(create_numbered_game(0, 3)), std::logic_error);
+		}
+		EXPECT_TRUE(GameDataWriter::isGameDataStream("test_games.bin"));
+		EXPECT_TRUE(GameDataWriter::isComplete("test_games.bin"));
+
+		const std::vector<GameDataStorage> games = read_games("test_games.bin");
+		ASSERT_EQ(games.size(), 10u);
+		for (int i = 0; i < 10; i++)
+		{
+			EXPECT_EQ(games[i].numberOfSamples(), 3 + i);
+			EXPECT_EQ(games[i].getOutcome(), create_numbered_game(i, 1).getOutcome());
+		}
+
+		GameDataBufferSummary summary;
+		EXPECT_TRUE(GameDataWriter::readSummary("test_games.bin", summary));
+		EXPECT_EQ(summary.config.rows, 15);
+		EXPECT_EQ(summary.stats.games, 10u);
+		EXPECT_EQ(summary.stats.cross_win, 5u);
+		ASSERT_EQ(summary.samples_per_game.size(), 10u);
+		for (int i = 0; i < 10; i++)
+			EXPECT_EQ(summary.samples_per_game[i], 3 + i);
+
+		GameDataBuffer buffer("test_games.bin"); // buffer reads streams of games as well
+		EXPECT_EQ(buffer.numberOfGames(), 10);
+		removeFile("test_games.bin");
+	}
+	TEST(TestGameDataWriter, readUnfinished)
+	{
+		const GameConfig cfg(GameRules::STANDARD, 15);
+		GameDataWriter writer("test_games.bin", cfg, 4);
+		for (int i = 0; i < 6; i++)
+			writer.add(create_numbered_game(i, 5));
+
+		EXPECT_FALSE(GameDataWriter::isComplete("test_games.bin"));
+		GameDataBufferSummary summary;
+		EXPECT_FALSE(GameDataWriter::readSummary("test_games.bin", summary)); // summary is written only when the writer is closed
+		EXPECT_EQ(read_games("test_games.bin").size(), 4u); // only the first chunk is written so far
+		writer.flush();
+		EXPECT_EQ(read_games("test_games.bin").size(), 6u);
+
+		writer.close();
+		EXPECT_TRUE(GameDataWriter::isComplete("test_games.bin"));
+		EXPECT_EQ(read_games("test_games.bin").size(), 6u);
+		removeFile("test_games.bin");
+	}
+	TEST(TestGameDataWriter, continueAfterInterruption)
+	{
+		const GameConfig cfg(GameRules::STANDARD, 15);
+		{ /* writer that is destroyed without closing leaves the file incomplete */
+			GameDataWriter writer("test_games.bin", cfg, 2);
+			for (int i = 0; i < 5; i++)
+				writer.add(create_numbered_game(i, 4));
+		}
+		EXPECT_FALSE(GameDataWriter::isComplete("test_games.bin"));
+		{ /* simulate crash in the middle of writing a chunk */
+			std::ofstream stream("test_games.bin", std::ios::out | std::ios::binary | std::ios::app);
+			const char garbage[7] = { 'C', 'H', 'N', 'K', 1, 2, 3 };
+			stream.write(garbage, sizeof(garbage));
+		}
+		EXPECT_EQ(read_games("test_games.bin").size(), 5u);
+
+		GameDataWriter writer("test_games.bin", cfg, 2);
+		EXPECT_EQ(writer.numberOfGames(), 5);
+		EXPECT_EQ(writer.getStats().games, 5u);
+		writer.add(create_numbered_game(5, 4));
+		writer.close();
+
+		const std::vector<GameDataStorage> games = read_games("test_games.bin");
+		ASSERT_EQ(games.size(), 6u);
+		EXPECT_EQ(games[5].getOutcome(), GameOutcome::DRAW);
+		EXPECT_TRUE(GameDataWriter::isComplete("test_games.bin"));
+		GameDataBufferSummary summary;
+		EXPECT_TRUE(GameDataWriter::readSummary("test_games.bin", summary));
+		EXPECT_EQ(summary.samples_per_game, std::vector<int>(6, 4)); // including the games written before the interruption
+
+		EXPECT_THROW(GameDataWriter("test_games.bin", GameConfig(GameRules::STANDARD, 20)), std::runtime_error);
+		removeFile("test_games.bin");
+	}
+	TEST(TestGameDataWriter, closeWhileAdding)
+	{
+		const GameConfig cfg(GameRules::STANDARD, 15);
+		GameDataWriter writer("test_games.bin", cfg, 1); // every game is written as a separate chunk by the thread that added it
+		std::atomic<int> started(0);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; t++)
+			threads.push_back(std::thread([&, t]()
+			{
+				started++;
+				try
+				{
+					for (int i = 0;; i++)
+						writer.add(create_numbered_game(t + 4 * i, 10));
+				}
+				catch (std::logic_error &e)
+				{ // the writer was closed
+				}
+			}));
+		while (started < 4 or writer.numberOfGames() < 20)
+			std::this_thread::yield();
+		writer.close();
+		for (size_t t = 0; t < threads.size(); t++)
+			threads[t].join();
+
+		EXPECT_TRUE(GameDataWriter::isComplete("test_games.bin"));
+		EXPECT_EQ(static_cast<int>(read_games("test_games.bin").size()), writer.numberOfGames()); // all games added before closing are in the index
+		removeFile("test_games.bin");
+	}
+	TEST(TestGameDataWriter, summaryFollowsOrderOfGamesInFile)
+	{
+		const GameConfig cfg(GameRules::STANDARD, 15);
+		{ /* artificial scope for closing the file */
+			GameDataWriter writer("test_games.bin", cfg, 2); // chunks written by different threads may end up in the file in any order
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; t++)
+				threads.push_back(std::thread([&, t]()
+				{
+					for (int i = 0; i < 10; i++)
+						writer.add(create_numbered_game(t, 1 + t + 4 * (i % 3)));
+				}));
+			for (size_t t = 0; t < threads.size(); t++)
+				threads[t].join();
+			writer.close();
+		}
+
+		const std::vector<GameDataStorage> games = read_games("test_games.bin");
+		GameDataBufferSummary summary;
+		ASSERT_TRUE(GameDataWriter::readSummary("test_games.bin", summary));
+		ASSERT_EQ(summary.samples_per_game.size(), games.size());
+		for (size_t i = 0; i < games.size(); i++)
+			EXPECT_EQ(summary.samples_per_game[i], games[i].numberOfSamples());
+		removeFile("test_games.bin");
+	}
+}
@@ -0,0 +1,132 @@
+/*
+ * test_IndexedDataset.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/IndexedDataset.hpp>
+#include <alphagomoku/dataset/Dataset.hpp>
+#include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/utils/file_util.hpp>
+
+#include <minml/utils/serialization.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "test_utils.hpp"
+
+namespace ag
+{
+	TEST(TestIndexedDataset, SaveAndLoad)
+	{
+		const std::string path = "test_indexed_dataset.idx";
+		const GameDataBuffer buffer = create_random_buffer(20, 10, 29, 0.5f);
+		IndexedDataset::save(buffer, path);
+		EXPECT_TRUE(IndexedDataset::isIndexedDataset(path));
+
+		const IndexedDataset loaded(path);
+		EXPECT_EQ(loaded.getConfig().rows, buffer.getConfig().rows);
+		EXPECT_EQ(loaded.getConfig().cols, buffer.getConfig().cols);
+		EXPECT_EQ(loaded.numberOfGames(), buffer.numberOfGames());
+		EXPECT_EQ(loaded.numberOfSamples(), buffer.numberOfSamples());
+
+		SearchDataPack expected(15, 15), actual(15, 15);
+		for (int i = 0; i < buffer.numberOfGames(); i++)
+		{
+			SerializedObject so; // scaling factors are rounded during serialization, so the indexed dataset must match the game after saving and loading
+			buffer.getGameData(i).serialize(so);
+			size_t offset = 0;
+			const GameDataStorage game(so, offset, 201);
+
+			EXPECT_EQ(loaded.numberOfSamples(i), game.numberOfSamples());
+			EXPECT_EQ(loaded.numberOfMoves(i), game.numberOfMoves());
+			EXPECT_EQ(loaded.getOutcome(i), game.getOutcome());
+			for (int j = 0; j < game.numberOfSamples(); j++)
+			{
+				game.getSample(expected, j);
+				loaded.getSample(actual, i, j);
+				EXPECT_TRUE(are_equal(expected, actual));
+			}
+		}
+		removeFile(path);
+	}
+	TEST(TestIndexedDataset, CorruptedIndex)
+	{
+		const std::string path = "test_indexed_dataset.idx";
+		IndexedDataset::save(create_random_buffer(3, 10, 29), path);
+		std::vector<char> original;
+		{
+			std::ifstream stream(path, std::ios::in | std::ios::binary);
+			original.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		}
+		EXPECT_NO_THROW(IndexedDataset { path });
+
+		auto read_u64 = [&](size_t offset)
+		{
+			uint64_t result;
+			std::memcpy(&result, original.data() + offset, sizeof(uint64_t));
+			return result;
+		};
+		auto expect_corrupted = [&](size_t offset, uint64_t value, size_t bytes)
+		{
+			std::vector<char> tmp = original;
+			std::memcpy(tmp.data() + offset, &value, bytes); // little endian
+			std::ofstream stream(path, std::ios::out | std::ios::binary);
+			stream.write(tmp.data(), tmp.size());
+			stream.close();
+			EXPECT_THROW(IndexedDataset { path }, std::runtime_error);
+		};
+
+		// header: magic (8), version (4), config size (4), games (8), samples (8), data offset (8)
+		uint32_t config_size;
+		std::memcpy(&config_size, original.data() + 12, sizeof(uint32_t));
+		const uint64_t games = read_u64(16);
+		const uint64_t samples = read_u64(24);
+		const uint64_t data_offset = read_u64(32);
+		const size_t game_index = (40 + config_size + 7) / 8 * 8; // game entry: offset (8), first sample (4), samples (4)
+		const size_t sample_index = game_index + 16 * games;
+		ASSERT_EQ(games, 3u);
+
+		expect_corrupted(24, samples + 1, 8); // more samples than games contain
+		expect_corrupted(game_index + 16 + 8, 1, 4); // samples of the second game overlap with the first one
+		expect_corrupted(game_index + 16 + 12, 1000, 4); // samples of the second game exceed the sample index
+		expect_corrupted(game_index + 16, original.size(), 8); // game outside of the file
+		expect_corrupted(game_index, read_u64(game_index + 16), 8); // first game placed after the second one
+		expect_corrupted(sample_index + 8 * (samples - 1), original.size() - data_offset, 8); // last sample outside of the file
+		expect_corrupted(sample_index + 8, read_u64(sample_index), 8); // two samples at the same place
+		removeFile(path);
+	}
+	TEST(TestIndexedDataset, DatasetWithBothFormats)
+	{
+		const GameDataBuffer buffer = create_random_buffer(5, 10, 29, 0.5f);
+		buffer.save("test_buffer_0.bin");
+		IndexedDataset::convert("test_buffer_0.bin", "test_buffer_1.idx");
+		EXPECT_FALSE(IndexedDataset::isIndexedDataset("test_buffer_0.bin"));
+
+		Dataset dataset;
+		dataset.load(0, "test_buffer_0.bin");
+		dataset.load(1, "test_buffer_1.idx");
+		EXPECT_EQ(dataset.numberOfBuffers(), 2);
+		EXPECT_EQ(dataset.numberOfGames(), 2 * buffer.numberOfGames());
+		EXPECT_EQ(dataset.numberOfSamples(), 2 * buffer.numberOfSamples());
+
+		SearchDataPack expected(15, 15), actual(15, 15);
+		for (int i = 0; i < dataset.numberOfGames(1); i++)
+			for (int j = 0; j < dataset.numberOfSamples(1, i); j++)
+			{
+				dataset.getSample(expected, 0, i, j);
+				dataset.getSample(actual, 1, i, j);
+				EXPECT_TRUE(are_equal(expected, actual));
+			}
+		dataset.clear();
+		removeFile("test_buffer_0.bin");
+		removeFile("test_buffer_1.idx");
+	}
+
+} /* namespace ag */
@@ -0,0 +1,168 @@
+/*
+ * test_SampleCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/SampleCache.hpp>
+#include <alphagomoku/dataset/Dataset.hpp>
+#include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/dataset/Sampler.hpp>
+#include <alphagomoku/dataset/data_packs.hpp>
+#include <alphagomoku/networks/NNInputFeatures.hpp>
+#include <alphagomoku/patterns/PatternCalculator.hpp>
+#include <alphagomoku/utils/file_util.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_utils.hpp"
+
+#include <fstream>
+
+namespace
+{
+	using namespace ag;
+
+	GameDataBuffer create_buffer_of_random_games(const std::vector<int> &gameLengths)
+	{
+		return create_buffer(gameLengths.size(), [&](int g)
+		{	return create_random_game(gameLengths[g]);});
+	}
+}
+
+namespace ag
+{
+	TEST(TestSampleCache, matchesPreparedSamples)
+	{
+		create_random_buffer(4, 5, 14, 0.7f).save("test_buffer.bin"); // some moves have no sample, so features are both updated and encoded from scratch
+		Dataset dataset;
+		dataset.load(0, "test_buffer.bin");
+		SampleCache::save(dataset, 0, "values", "test_buffer.cache");
+
+		const GameConfig cfg(GameRules::STANDARD, 15);
+		EXPECT_TRUE(SampleCache::isUpToDate("test_buffer.cache", dataset, 0, "values"));
+		EXPECT_FALSE(SampleCache::isUpToDate("test_buffer.cache", dataset, 0, "visits"));
+		EXPECT_FALSE(SampleCache::isUpToDate("test_buffer.bin", dataset, 0, "values"));
+
+		const SampleCache cache("test_buffer.cache");
+		EXPECT_EQ(cache.numberOfGames(), dataset.numberOfGames(0));
+		EXPECT_EQ(cache.numberOfSamples(), dataset.numberOfSamples());
+
+		std::unique_ptr<Sampler> sampler = createSampler("values");
+		PatternCalculator calc(cfg);
+		NNInputFeatures expected_features(15, 15), actual_features;
+		SearchDataPack sample(15, 15);
+		TrainingDataPack expected(15, 15), actual;
+		for (int i = 0; i < cache.numberOfGames(); i++)
+			for (int j = 0; j < cache.numberOfSamples(i); j++)
+			{
+				dataset.getSample(sample, 0, i, j);
+				expected.clear();
+				sampler->prepare(expected, sample);
+				calc.setBoard(expected.board, expected.sign_to_move);
+				expected_features.encode(calc);
+
+				cache.getSample(actual_features, actual, i, j);
+				EXPECT_TRUE(actual_features == expected_features);
+				EXPECT_EQ(actual.visit_count, expected.visit_count);
+				EXPECT_EQ(actual.sign_to_move, expected.sign_to_move);
+				EXPECT_EQ(actual.moves_left, expected.moves_left);
+				EXPECT_EQ(actual.value_target, expected.value_target);
+				for (int k = 0; k < actual.policy_target.size(); k++)
+				{
+					EXPECT_NEAR(actual.policy_target[k], expected.policy_target[k], 1.0e-4f);
+					EXPECT_NEAR(actual.action_values_target[k].win_rate, expected.action_values_target[k].win_rate, 1.0e-4f);
+					EXPECT_NEAR(actual.action_values_target[k].draw_rate, expected.action_values_target[k].draw_rate, 1.0e-4f);
+				}
+			}
+		dataset.clear();
+		removeFile("test_buffer.bin");
+		removeFile("test_buffer.cache");
+	}
+	TEST(TestSampleCache, outdatedAfterBufferChanged)
+	{
+		GameDataBuffer buffer = create_buffer_of_random_games( { 5, 7, 6 });
+		buffer.save("test_buffer.bin");
+		Dataset dataset;
+		dataset.load(0, "test_buffer.bin");
+		SampleCache::save(dataset, 0, "values", "test_buffer.cache");
+		EXPECT_TRUE(SampleCache::isUpToDate("test_buffer.cache", dataset, 0, "values"));
+
+		create_buffer_of_random_games( { 5, 6, 7 }).save("test_buffer.bin"); // the same number of games and samples, but in different games
+		dataset.unload(0);
+		dataset.load(0, "test_buffer.bin");
+		EXPECT_FALSE(SampleCache::isUpToDate("test_buffer.cache", dataset, 0, "values"));
+
+		buffer.addGameData(create_random_game(5));
+		buffer.save("test_buffer.bin");
+		dataset.unload(0);
+		dataset.load(0, "test_buffer.bin");
+		EXPECT_FALSE(SampleCache::isUpToDate("test_buffer.cache", dataset, 0, "values"));
+
+		dataset.clear();
+		removeFile("test_buffer.bin");
+		removeFile("test_buffer.cache");
+	}
+	TEST(TestSampleCache, corruptedGameIndex)
+	{
+		create_buffer_of_random_games( { 5, 7, 6 }).save("test_buffer.bin");
+		Dataset dataset;
+		dataset.load(0, "test_buffer.bin");
+		SampleCache::save(dataset, 0, "values", "test_buffer.cache");
+		dataset.clear();
+		EXPECT_NO_THROW(SampleCache("test_buffer.cache"));
+
+		uint32_t json_size = 0;
+		{
+			std::ifstream stream("test_buffer.cache", std::ios::in | std::ios::binary);
+			stream.seekg(12); // after magic string and version
+			stream.read(reinterpret_cast<char*>(&json_size), sizeof(json_size));
+		}
+		const size_t game_index_offset = (56 + json_size + 7) / 8 * 8; // header has 56 bytes and is followed by aligned json
+		{
+			std::fstream stream("test_buffer.cache", std::ios::in | std::ios::out | std::ios::binary);
+			const uint32_t entry[2] = { 12, 7 }; // the third game would end past the 18 samples stored in the file
+			stream.seekp(game_index_offset + 2 * sizeof(entry));
+			stream.write(reinterpret_cast<const char*>(entry), sizeof(entry));
+		}
+		EXPECT_THROW(SampleCache("test_buffer.cache"), std::runtime_error);
+		EXPECT_FALSE(SampleCache::isSampleCache("test_buffer.bin"));
+		removeFile("test_buffer.bin");
+		removeFile("test_buffer.cache");
+	}
+	TEST(TestSampleCache, samplerUsesAttachedCache)
+	{
+		create_random_buffer(3, 5, 14).save("test_buffer_0.bin");
+		create_random_buffer(5, 5, 14).save("test_buffer_1.bin");
+		Dataset dataset;
+		dataset.load(0, "test_buffer_0.bin");
+		dataset.load(1, "test_buffer_1.bin");
+		SampleCache::save(dataset, 0, "visits", "test_buffer_0.cache");
+
+		EXPECT_THROW(dataset.loadCache(1, "test_buffer_0.cache"), std::runtime_error); // created from different buffer
+		EXPECT_THROW(dataset.loadCache(2, "test_buffer_0.cache"), std::logic_error);
+		dataset.loadCache(0, "test_buffer_0.cache");
+		EXPECT_TRUE(dataset.hasCache(0));
+		EXPECT_FALSE(dataset.hasCache(1));
+
+		std::unique_ptr<Sampler> sampler = createSampler("visits");
+		sampler->init(dataset, 16);
+		TrainingDataPack result(15, 15);
+		NNInputFeatures features(15, 15);
+		int cached = 0;
+		for (int i = 0; i < 100; i++)
+			cached += sampler->get(result, features);
+		EXPECT_GT(cached, 0);
+		EXPECT_LT(cached, 100);
+
+		dataset.unload(0);
+		EXPECT_FALSE(dataset.hasCache(0));
+		dataset.clear();
+		removeFile("test_buffer_0.bin");
+		removeFile("test_buffer_1.bin");
+		removeFile("test_buffer_0.cache");
+	}
+
+} /* namespace ag */
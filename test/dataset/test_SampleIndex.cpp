@@ -0,0 +1,99 @@
+/*
+ * test_SampleIndex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/SampleIndex.hpp>
+#include <alphagomoku/dataset/Dataset.hpp>
+#include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/dataset/data_packs.hpp>
+#include <alphagomoku/utils/AliasTable.hpp>
+#include <alphagomoku/utils/file_util.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_utils.hpp"
+
+namespace
+{
+	using namespace ag;
+
+	/*
+	 * \brief First sample of each game has minimax value far from the outcome of the game, all other ones are exact.
+	 */
+	GameDataBuffer create_surprising_buffer(const std::vector<int> &gameLengths)
+	{
+		return create_buffer(gameLengths, [](SearchDataPack &sample, int m)
+		{
+			sample.visit_count.at(14, 14) = 10; // minimax value is restored from the values of visited actions
+			sample.action_values.at(14, 14) = (m == 0) ? Value::win() : Value::draw();
+		});
+	}
+}
+
+namespace ag
+{
+	TEST(TestSampleIndex, aliasTable)
+	{
+		const std::vector<double> weights = { 1.0, 0.0, 3.0, 4.0, 2.0 };
+		const AliasTable table(weights);
+		EXPECT_EQ(table.size(), 5);
+		for (size_t i = 0; i < weights.size(); i++)
+			EXPECT_NEAR(table.getProbability(i), weights[i] / 10.0, 1.0e-6);
+
+		const int draws = 100000;
+		std::vector<int> histogram(weights.size(), 0);
+		for (int i = 0; i < draws; i++)
+			histogram.at(table.draw())++;
+		EXPECT_EQ(histogram[1], 0);
+		for (size_t i = 0; i < weights.size(); i++)
+			EXPECT_NEAR(static_cast<double>(histogram[i]) / draws, weights[i] / 10.0, 0.01);
+
+		EXPECT_THROW(AliasTable( { 1.0, -1.0 }), std::invalid_argument);
+		EXPECT_THROW(AliasTable( { 0.0, 0.0 }), std::invalid_argument);
+		EXPECT_TRUE(AliasTable(std::vector<double>()).isEmpty());
+	}
+	TEST(TestSampleIndex, weightings)
+	{
+		create_surprising_buffer( { 2, 6 }).save(get_path("sample_index", 0));
+		create_surprising_buffer( { 4, 0, 4 }).save(get_path("sample_index", 1));
+		Dataset dataset;
+		dataset.load(0, get_path("sample_index", 0));
+		dataset.load(1, get_path("sample_index", 1));
+
+		const SampleIndex uniform(dataset, SampleWeighting::UNIFORM);
+		EXPECT_EQ(uniform.numberOfSamples(), 16);
+		for (int i = 0; i < uniform.numberOfSamples(); i++)
+			EXPECT_NEAR(uniform.getProbability(i), 1.0 / 16.0, 1.0e-6);
+
+		const SampleIndex recency(dataset, SampleWeighting::RECENCY); // samples from the second buffer are twice as likely
+		EXPECT_NEAR(recency.getProbability(0), 1.0 / 24.0, 1.0e-6);
+		EXPECT_NEAR(recency.getProbability(15), 2.0 / 24.0, 1.0e-6);
+
+		const SampleIndex surprise(dataset, SampleWeighting::SURPRISE); // first samples of the games have weight 0.6, all others 0.1
+		EXPECT_NEAR(surprise.getProbability(0), 0.6 / 3.6, 1.0e-3);
+		EXPECT_NEAR(surprise.getProbability(1), 0.1 / 3.6, 1.0e-3);
+
+		for (int i = 0; i < 1000; i++)
+		{
+			const SampleLocation location = uniform.draw();
+			ASSERT_GE(location.sample_index, 0);
+			ASSERT_LT(location.sample_index, dataset.numberOfSamples(location.buffer_index, location.game_index));
+		}
+
+		dataset.clear();
+		removeFile(get_path("sample_index", 0));
+		removeFile(get_path("sample_index", 1));
+	}
+	TEST(TestSampleIndex, streamedDatasetIsNotSupported)
+	{
+		Dataset dataset;
+		dataset.setStreaming(100);
+		EXPECT_THROW(SampleIndex(dataset, SampleWeighting::UNIFORM), std::logic_error);
+		EXPECT_THROW(sampleWeightingFromString("unknown"), std::logic_error);
+	}
+
+} /* namespace ag */
@@ -0,0 +1,313 @@
+/*
+ * test_torch_api.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/dataset/torch_api.h>
+#include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/dataset/data_packs.hpp>
+#include <alphagomoku/networks/NNInputFeatures.hpp>
+#include <alphagomoku/patterns/PatternCalculator.hpp>
+#include <alphagomoku/search/Value.hpp>
+#include <alphagomoku/utils/augmentations.hpp>
+#include <alphagomoku/utils/file_util.hpp>
+#include <alphagomoku/utils/low_precision.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_utils.hpp"
+
+namespace
+{
+	using namespace ag;
+
+	const int game_length = 6;
+	GameOutcome get_outcome(int gameIndex)
+	{
+		return (gameIndex == 1) ? GameOutcome::CROSS_WIN : GameOutcome::DRAW;
+	}
+	Move get_move(int gameIndex, int moveNumber)
+	{
+		return Move(7 + gameIndex, moveNumber);
+	}
+	void fill_sample(SearchDataPack &sample, int gameIndex, int moveNumber)
+	{
+		sample.visit_count.at(0, moveNumber) = 10 + gameIndex;
+		sample.action_values.at(0, moveNumber) = Value(0.1f * moveNumber, 0.2f);
+		sample.visit_count.at(14, gameIndex) = 5;
+		sample.action_values.at(14, gameIndex) = Value(0.5f, 0.1f * gameIndex);
+	}
+	void save_buffer(const std::string &path)
+	{
+		create_buffer(3, [](int g)
+		{
+			return create_game(game_length, get_outcome(g), [g](int m)
+			{	return get_move(g, m);}, [g](SearchDataPack &sample, int m)
+			{	fill_sample(sample, g, m);});
+		}).save(path);
+	}
+
+	/*
+	 * \brief Tensors of a single sample, calculated from the definition of the games in 'save_buffer' rather than from the stored data.
+	 */
+	struct ExpectedSample
+	{
+			std::vector<float> input, policy, value, moves_left, action_values;
+			ExpectedSample(const Sample_t &sample)
+			{
+				const GameConfig cfg = get_test_config();
+				const Symmetry symmetry = int_to_symmetry(sample.augmentation);
+				SearchDataPack pack(cfg.rows, cfg.cols);
+				for (int m = 0; m < sample.sample_index; m++)
+				{
+					const Move move = get_move(sample.game_index, m);
+					pack.board.at(move.row, move.col) = (m % 2 == 0) ? Sign::CROSS : Sign::CIRCLE;
+				}
+				fill_sample(pack, sample.game_index, sample.sample_index);
+				const Sign sign_to_move = (sample.sample_index % 2 == 0) ? Sign::CROSS : Sign::CIRCLE;
+
+				apply_symmetry_in_place(pack.board, symmetry);
+				PatternCalculator calculator(cfg);
+				calculator.setBoard(pack.board, sign_to_move);
+				NNInputFeatures features(cfg.rows, cfg.cols);
+				features.encode(calculator);
+				for (int i = 0; i < features.size(); i++)
+					for (int j = 0; j < 32; j++)
+						input.push_back(((features[i] >> j) & 1u) ? 1.0f : 0.0f);
+
+				matrix<float> visits(cfg.rows, cfg.cols);
+				float sum = 0.0f;
+				for (int i = 0; i < visits.size(); i++)
+				{
+					visits[i] = pack.visit_count[i];
+					sum += visits[i];
+				}
+				apply_symmetry_in_place(visits, symmetry);
+				for (int i = 0; i < visits.size(); i++)
+					policy.push_back(visits[i] / sum);
+
+				const Value outcome = convertOutcome(get_outcome(sample.game_index), sign_to_move);
+				value = { outcome.win_rate, outcome.draw_rate, outcome.loss_rate() };
+				moves_left = { static_cast<float>(game_length - sample.sample_index) };
+
+				apply_symmetry_in_place(pack.action_values, symmetry);
+				for (int i = 0; i < pack.action_values.size(); i++)
+				{
+					action_values.push_back(pack.action_values[i].win_rate);
+					action_values.push_back(pack.action_values[i].draw_rate);
+					action_values.push_back(pack.action_values[i].loss_rate());
+				}
+			}
+	};
+
+	struct Batch
+	{
+			std::vector<char> input, policy, value, moves_left, action_values;
+			Batch(int batchSize, int inputElementSize, int targetElementSize) :
+					input(batchSize * 15 * 15 * 32 * inputElementSize),
+					policy(batchSize * 15 * 15 * targetElementSize),
+					value(batchSize * 3 * targetElementSize),
+					moves_left(batchSize * targetElementSize),
+					action_values(batchSize * 15 * 15 * 3 * targetElementSize)
+			{
+			}
+			void load(LoaderHandle_t handle, const std::vector<Sample_t> &samples, DataType_t inputType, DataType_t targetType)
+			{
+				load_batch_parallel(handle, samples.size(), samples.data(), inputType, targetType, input.data(), policy.data(), value.data(),
+						moves_left.data(), action_values.data());
+			}
+			void augment(LoaderHandle_t handle, const std::vector<Sample_t> &samples, DataType_t inputType, DataType_t targetType)
+			{
+				augment_batch(handle, samples.size(), samples.data(), inputType, targetType, input.data(), policy.data(), action_values.data());
+			}
+			template<typename T>
+			std::vector<float> get(const std::vector<char> &data) const
+			{
+				std::vector<float> result(data.size() / sizeof(T));
+				for (size_t i = 0; i < result.size(); i++)
+					result[i] = reinterpret_cast<const T*>(data.data())[i];
+				return result;
+			}
+	};
+	std::vector<float> from_fp16(const std::vector<char> &data)
+	{
+		std::vector<float> result(data.size() / sizeof(uint16_t));
+		for (size_t i = 0; i < result.size(); i++)
+			result[i] = LowFP<1, 5, 10, -15>::to_fp32(reinterpret_cast<const uint16_t*>(data.data())[i]);
+		return result;
+	}
+	void expect_near(const std::vector<float> &lhs, const std::vector<float> &rhs, float tolerance)
+	{
+		ASSERT_EQ(lhs.size(), rhs.size());
+		for (size_t i = 0; i < lhs.size(); i++)
+			EXPECT_NEAR(lhs[i], rhs[i], tolerance + tolerance * std::fabs(lhs[i]));
+	}
+	std::vector<float> get_sample(const std::vector<float> &batch, int batchSize, int index)
+	{
+		const size_t sample_size = batch.size() / batchSize;
+		return std::vector<float>(batch.begin() + index * sample_size, batch.begin() + (index + 1) * sample_size);
+	}
+	/*
+	 * \brief Compares each sample of the batch (already converted to float) with the one calculated independently by 'ExpectedSample'.
+	 */
+	void expect_matching_samples(const std::vector<Sample_t> &samples, const std::vector<float> &input, const std::vector<float> &policy,
+			const std::vector<float> &value, const std::vector<float> &movesLeft, const std::vector<float> &actionValues, float tolerance)
+	{
+		const int batch_size = samples.size();
+		for (int b = 0; b < batch_size; b++)
+		{
+			const ExpectedSample expected(samples[b]);
+			EXPECT_EQ(get_sample(input, batch_size, b), expected.input);
+			expect_near(get_sample(policy, batch_size, b), expected.policy, tolerance);
+			expect_near(get_sample(value, batch_size, b), expected.value, tolerance);
+			expect_near(get_sample(movesLeft, batch_size, b), expected.moves_left, tolerance);
+			expect_near(get_sample(actionValues, batch_size, b), expected.action_values, 1.0e-2f); // action values are stored with 8 bits of precision
+		}
+	}
+}
+
+namespace ag
+{
+	TEST(TestTorchApi, loadedSamplesMatchTheirGames)
+	{
+		save_buffer("test_torch_api.bin");
+		const std::vector<Sample_t> samples = { { 0, 0, 1, 0 }, { 0, 1, 3, 2 }, { 0, 2, 5, 5 }, { 0, 1, 0, 7 }, { 0, 0, 4, 1 } };
+
+		load_dataset_fragment(0, "test_torch_api.bin");
+		Batch sequential(samples.size(), sizeof(float), sizeof(float));
+		load_batch(samples.size(), samples.data(), reinterpret_cast<float*>(sequential.input.data()), reinterpret_cast<float*>(sequential.policy.data()),
+				reinterpret_cast<float*>(sequential.value.data()), reinterpret_cast<float*>(sequential.moves_left.data()),
+				reinterpret_cast<float*>(sequential.action_values.data()));
+		unload_dataset_fragment(0);
+		expect_matching_samples(samples, sequential.get<float>(sequential.input), sequential.get<float>(sequential.policy),
+				sequential.get<float>(sequential.value), sequential.get<float>(sequential.moves_left), sequential.get<float>(sequential.action_values),
+				1.0e-4f);
+
+		LoaderHandle_t handle = create_loader(3);
+		loader_load_dataset_fragment(handle, 0, "test_torch_api.bin");
+		TensorSize_t shape;
+		loader_get_dataset_size(handle, &shape, nullptr);
+		EXPECT_EQ(shape.dim[0], 3);
+
+		Batch parallel(samples.size(), sizeof(float), sizeof(float));
+		parallel.load(handle, samples, DTYPE_FLOAT32, DTYPE_FLOAT32);
+		expect_matching_samples(samples, parallel.get<float>(parallel.input), parallel.get<float>(parallel.policy), parallel.get<float>(parallel.value),
+				parallel.get<float>(parallel.moves_left), parallel.get<float>(parallel.action_values), 1.0e-4f);
+
+		Batch compact(samples.size(), sizeof(uint8_t), sizeof(uint16_t));
+		compact.load(handle, samples, DTYPE_UINT8, DTYPE_FLOAT16);
+		expect_matching_samples(samples, compact.get<uint8_t>(compact.input), from_fp16(compact.policy), from_fp16(compact.value),
+				from_fp16(compact.moves_left), from_fp16(compact.action_values), 1.0e-3f);
+
+		EXPECT_THROW(compact.load(handle, samples, DTYPE_UINT8, DTYPE_UINT8), std::invalid_argument);
+		destroy_loader(handle);
+		removeFile("test_torch_api.bin");
+	}
+	TEST(TestTorchApi, tensorShapesOfLoader)
+	{
+		save_buffer("test_torch_api.bin");
+		LoaderHandle_t handle = create_loader(2);
+		loader_load_dataset_fragment(handle, 0, "test_torch_api.bin");
+
+		const std::vector<Sample_t> samples = { { 0, 0, 1, 0 }, { 0, 2, 3, 0 } };
+		TensorSize_t input, policy, value, moves_left, action_values;
+		loader_get_tensor_shapes(handle, samples.size(), samples.data(), &input, &policy, &value, &moves_left, &action_values);
+		EXPECT_EQ(input.rank, 4);
+		EXPECT_EQ(std::vector<int>(input.dim, input.dim + 4), std::vector<int>( { 2, 15, 15, 32 }));
+		EXPECT_EQ(policy.rank, 4);
+		EXPECT_EQ(std::vector<int>(policy.dim, policy.dim + 4), std::vector<int>( { 2, 15, 15, 1 }));
+		EXPECT_EQ(value.rank, 2);
+		EXPECT_EQ(std::vector<int>(value.dim, value.dim + 2), std::vector<int>( { 2, 3 }));
+		EXPECT_EQ(moves_left.rank, 2);
+		EXPECT_EQ(std::vector<int>(moves_left.dim, moves_left.dim + 2), std::vector<int>( { 2, 1 }));
+		EXPECT_EQ(action_values.rank, 4);
+		EXPECT_EQ(std::vector<int>(action_values.dim, action_values.dim + 4), std::vector<int>( { 2, 15, 15, 3 }));
+		loader_print_dataset_info(handle);
+
+		EXPECT_THROW(get_tensor_shapes(samples.size(), samples.data(), &input, &policy, &value, &moves_left, &action_values), std::runtime_error); // nothing is loaded into the default loader
+
+		destroy_loader(handle);
+		removeFile("test_torch_api.bin");
+	}
+	TEST(TestTorchApi, eachSampleHasItsOwnActionValues)
+	{
+		save_buffer("test_torch_api.bin");
+		LoaderHandle_t handle = create_loader(2);
+		loader_load_dataset_fragment(handle, 0, "test_torch_api.bin");
+
+		const std::vector<Sample_t> samples = { { 0, 0, 0, 0 }, { 0, 2, 3, 0 } };
+		Batch pair(2, sizeof(float), sizeof(float));
+		pair.load(handle, samples, DTYPE_FLOAT32, DTYPE_FLOAT32);
+		Batch single(1, sizeof(float), sizeof(float));
+		single.load(handle, { samples[1] }, DTYPE_FLOAT32, DTYPE_FLOAT32);
+
+		const std::vector<float> both_samples = pair.get<float>(pair.action_values);
+		const std::vector<float> second_sample(both_samples.begin() + 15 * 15 * 3, both_samples.end());
+		EXPECT_EQ(second_sample, single.get<float>(single.action_values));
+
+		destroy_loader(handle);
+		removeFile("test_torch_api.bin");
+	}
+	TEST(TestTorchApi, augmentationMatchesTransformedPosition)
+	{
+		save_buffer("test_torch_api.bin");
+		LoaderHandle_t handle = create_loader(2);
+		loader_load_dataset_fragment(handle, 0, "test_torch_api.bin");
+
+		const int game_index = 1;
+		const int sample_index = 5; // board has 5 stones in row 8, starting from column 0
+		std::vector<Sample_t> samples;
+		for (int s = 0; s < 8; s++)
+			samples.push_back(Sample_t { 0, game_index, sample_index, s });
+		Batch augmented(samples.size(), sizeof(float), sizeof(float));
+		augmented.load(handle, samples, DTYPE_FLOAT32, DTYPE_FLOAT32);
+
+		const GameConfig cfg(GameRules::STANDARD, 15);
+		PatternCalculator calculator(cfg);
+		NNInputFeatures features(cfg.rows, cfg.cols);
+		const std::vector<float> input = augmented.get<float>(augmented.input);
+		const std::vector<float> action_values = augmented.get<float>(augmented.action_values);
+		for (int s = 0; s < 8; s++)
+		{ // features are calculated from scratch for the transformed board and compared to the gathered ones
+			matrix<Sign> board(cfg.rows, cfg.cols);
+			for (int i = 0; i < sample_index; i++)
+				board.at(7 + game_index, i) = (i % 2 == 0) ? Sign::CROSS : Sign::CIRCLE;
+			apply_symmetry_in_place(board, int_to_symmetry(s));
+			calculator.setBoard(board, Sign::CIRCLE);
+			features.encode(calculator);
+			for (int i = 0; i < features.size(); i++)
+				for (int j = 0; j < 32; j++)
+					EXPECT_EQ(input[(s * features.size() + i) * 32 + j], ((features[i] >> j) & 1u) ? 1.0f : 0.0f);
+
+			matrix<float> win_rates(cfg.rows, cfg.cols);
+			win_rates.at(14, game_index) = 0.5f;
+			apply_symmetry_in_place(win_rates, int_to_symmetry(s));
+			for (int i = 0; i < win_rates.size(); i++)
+			{
+				if (win_rates[i] != 0.0f)
+				{
+					EXPECT_NEAR(action_values[(s * features.size() + i) * 3], win_rates[i], 1.0e-3f);
+				}
+			}
+		}
+
+		Batch identity(samples.size(), sizeof(uint8_t), sizeof(uint16_t));
+		std::vector<Sample_t> not_augmented = samples;
+		for (size_t i = 0; i < not_augmented.size(); i++)
+			not_augmented[i].augmentation = 0;
+		identity.load(handle, not_augmented, DTYPE_UINT8, DTYPE_FLOAT16);
+		identity.augment(handle, samples, DTYPE_UINT8, DTYPE_FLOAT16);
+		Batch compact(samples.size(), sizeof(uint8_t), sizeof(uint16_t));
+		compact.load(handle, samples, DTYPE_UINT8, DTYPE_FLOAT16);
+		EXPECT_EQ(identity.input, compact.input);
+		EXPECT_EQ(identity.policy, compact.policy);
+		EXPECT_EQ(identity.action_values, compact.action_values);
+
+		destroy_loader(handle);
+		removeFile("test_torch_api.bin");
+	}
+
+} /* namespace ag */
@@ -0,0 +1,150 @@
+/*
+ * test_utils.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef ALPHAGOMOKU_TEST_DATASET_TEST_UTILS_HPP_
+#define ALPHAGOMOKU_TEST_DATASET_TEST_UTILS_HPP_
+
+#include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/dataset/data_packs.hpp>
+#include <alphagomoku/game/Move.hpp>
+#include <alphagomoku/utils/configs.hpp>
+#include <alphagomoku/utils/random.hpp>
+
+#include <string>
+#include <vector>
+
+namespace ag
+{
+	/*
+	 * \brief All games created by the functions below are played on this board.
+	 */
+	inline GameConfig get_test_config()
+	{
+		return GameConfig(GameRules::STANDARD, 15);
+	}
+
+	/*
+	 * \brief Creates game with a sample for every move, starting with cross.
+	 * 'getMove(m)' returns the location of m-th move and 'fillSample(sample, m)' can set the search results stored in m-th sample.
+	 */
+	template<class MoveFunction, class SampleFunction>
+	GameDataStorage create_game(int length, GameOutcome outcome, MoveFunction getMove, SampleFunction fillSample)
+	{
+		const GameConfig cfg = get_test_config();
+		GameDataStorage result(cfg.rows, cfg.cols, 201);
+		matrix<Sign> board(cfg.rows, cfg.cols);
+		for (int m = 0; m < length; m++)
+		{
+			const Move location = getMove(m);
+			const Move move(location.row, location.col, (m % 2 == 0) ? Sign::CROSS : Sign::CIRCLE);
+			SearchDataPack sample(cfg.rows, cfg.cols);
+			sample.board = board;
+			sample.played_move = move;
+			fillSample(sample, m);
+			result.addSample(sample);
+			result.addMove(move);
+			board.at(move.row, move.col) = move.sign;
+		}
+		result.setOutcome(outcome);
+		return result;
+	}
+	template<class MoveFunction>
+	GameDataStorage create_game(int length, GameOutcome outcome, MoveFunction getMove)
+	{
+		return create_game(length, outcome, getMove, [](SearchDataPack &sample, int m)
+		{});
+	}
+
+	/*
+	 * \brief Creates game of random moves with random search results. Every move has a sample with given probability.
+	 */
+	inline GameDataStorage create_random_game(int length, float sampleProbability = 1.0f)
+	{
+		const GameConfig cfg = get_test_config();
+		GameDataStorage result(cfg.rows, cfg.cols, 201);
+		matrix<Sign> board(cfg.rows, cfg.cols);
+		Sign sign_to_move = Sign::CROSS;
+		for (int m = 0; m < length; m++)
+		{
+			Move move;
+			do
+			{
+				move = Move(randInt(cfg.rows), randInt(cfg.cols), sign_to_move);
+			} while (board.at(move.row, move.col) != Sign::NONE);
+
+			if (randFloat() < sampleProbability)
+			{
+				SearchDataPack sample(cfg.rows, cfg.cols);
+				sample.board = board;
+				for (int i = 0; i < board.size(); i++)
+					if (board[i] == Sign::NONE and randInt(4) == 0)
+					{
+						sample.visit_count[i] = 1 + randInt(100);
+						sample.policy_prior[i] = randFloat();
+						sample.action_values[i] = Value(0.5f * randFloat(), 0.5f * randFloat());
+					}
+				sample.action_scores.at(move.row, move.col) = Score::win_in(1 + randInt(9));
+				sample.minimax_score = Score::win_in(2);
+				sample.played_move = move;
+				result.addSample(sample);
+			}
+			result.addMove(move);
+			board.at(move.row, move.col) = move.sign;
+			sign_to_move = invertSign(sign_to_move);
+		}
+		result.setOutcome(static_cast<GameOutcome>(1 + randInt(3)));
+		return result;
+	}
+
+	/*
+	 * \brief 'createGame(g)' returns g-th game of the buffer.
+	 */
+	template<class GameFunction>
+	GameDataBuffer create_buffer(int numberOfGames, GameFunction createGame)
+	{
+		GameDataBuffer result(get_test_config());
+		for (int g = 0; g < numberOfGames; g++)
+			result.addGameData(createGame(g));
+		return result;
+	}
+	/*
+	 * \brief Buffer of drawn games with given lengths, g-th game is played in column g.
+	 */
+	template<class SampleFunction>
+	GameDataBuffer create_buffer(const std::vector<int> &gameLengths, SampleFunction fillSample)
+	{
+		return create_buffer(static_cast<int>(gameLengths.size()), [&](int g)
+		{	return create_game(gameLengths[g], GameOutcome::DRAW, [g](int m)
+				{	return Move(m, g % 15);}, fillSample);});
+	}
+	inline GameDataBuffer create_buffer(const std::vector<int> &gameLengths)
+	{
+		return create_buffer(gameLengths, [](SearchDataPack &sample, int m)
+		{});
+	}
+	inline GameDataBuffer create_random_buffer(int numberOfGames, int minLength, int maxLength, float sampleProbability = 1.0f)
+	{
+		return create_buffer(numberOfGames, [=](int g)
+		{	return create_random_game(minLength + randInt(maxLength - minLength + 1), sampleProbability);});
+	}
+
+	inline std::string get_path(const std::string &name, int index)
+	{
+		return "test_" + name + "_" + std::to_string(index) + ".bin";
+	}
+	inline bool are_equal(const SearchDataPack &lhs, const SearchDataPack &rhs)
+	{
+		return lhs.board == rhs.board and lhs.policy_prior == rhs.policy_prior and lhs.visit_count == rhs.visit_count
+				and lhs.action_values == rhs.action_values and lhs.action_scores == rhs.action_scores and lhs.minimax_value == rhs.minimax_value
+				and lhs.minimax_score == rhs.minimax_score and lhs.moves_left == rhs.moves_left and lhs.game_outcome == rhs.game_outcome
+				and lhs.played_move == rhs.played_move and lhs.flags.raw() == rhs.flags.raw();
+	}
+
+} /* namespace ag */
+
+#endif /* ALPHAGOMOKU_TEST_DATASET_TEST_UTILS_HPP_ */
@@ -0,0 +1,264 @@
+/*
+ * test_BitBoard.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/game/BitBoard.hpp>
+#include <alphagomoku/game/Board.hpp>
+#include <alphagomoku/game/Move.hpp>
+#include <alphagomoku/game/rules.hpp>
+#include <alphagomoku/utils/random.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace ag;
+
+	GameOutcome get_outcome(GameRules rules, const matrix<Sign> &board, Move move)
+	{
+		return getOutcome(rules, BitBoard(board), move);
+	}
+	matrix<Sign> get_random_board(int rows, int cols, int moves)
+	{
+		matrix<Sign> result(rows, cols);
+		Sign sign = Sign::CROSS;
+		for (int i = 0; i < moves; i++)
+		{
+			const int row = randInt(rows);
+			const int col = randInt(cols);
+			if (result.at(row, col) == Sign::NONE)
+			{
+				result.at(row, col) = sign;
+				sign = invertSign(sign);
+			}
+		}
+		return result;
+	}
+}
+
+namespace ag
+{
+	TEST(TestBitBoard, PutAndUndo)
+	{
+		BitBoard board(15, 15);
+		EXPECT_EQ(board.numberOfMoves(), 0);
+		board.putMove(Move("Xa0"));
+		board.putMove(Move("Oo14"));
+		EXPECT_EQ(board.at(0, 0), Sign::CROSS);
+		EXPECT_EQ(board.at(14, 14), Sign::CIRCLE);
+		EXPECT_EQ(board.numberOfMoves(), 2);
+		board.undoMove(Move("Xa0"));
+		EXPECT_EQ(board.at(0, 0), Sign::NONE);
+		EXPECT_EQ(board.numberOfMoves(), 1);
+	}
+	TEST(TestBitBoard, ConversionFromMatrix)
+	{
+		const matrix<Sign> board = get_random_board(20, 20, 200);
+		const BitBoard bit_board(board);
+		EXPECT_EQ(bit_board.numberOfMoves(), Board::numberOfMoves(board));
+		EXPECT_EQ(bit_board.toMatrix(), board);
+	}
+	TEST(TestBitBoard, LinesAtEdges)
+	{
+		const GameRules rules = GameRules::FREESTYLE;
+		BitBoard board(20, 20);
+		for (Move move : { Move("Xq0"), Move("Xr0"), Move("Xs0"), Move("Xt0"), Move("Xa1") }) // stones at the ends of two consecutive rows
+			board.putMove(move);
+		EXPECT_TRUE(board.getWinningLines(rules, Sign::CROSS).isEmpty());
+		EXPECT_EQ(getOutcome(rules, board, Move("Xb1")), GameOutcome::UNKNOWN);
+		EXPECT_EQ(getOutcome(rules, board, Move("Xp0")), GameOutcome::CROSS_WIN);
+
+		board.clear();
+		for (Move move : { Move("Xt0"), Move("Xs1"), Move("Xr2"), Move("Xq3") }) // antidiagonal starting at the corner
+			board.putMove(move);
+		EXPECT_EQ(getOutcome(rules, board, Move("Xa1")), GameOutcome::UNKNOWN);
+		EXPECT_EQ(getOutcome(rules, board, Move("Xp4")), GameOutcome::CROSS_WIN);
+
+		board.clear();
+		for (Move move : { Move("Xt15"), Move("Xt16"), Move("Xt17"), Move("Xt18") }) // vertical line at the bottom right corner
+			board.putMove(move);
+		EXPECT_EQ(getOutcome(rules, board, Move("Xt19")), GameOutcome::CROSS_WIN);
+		EXPECT_EQ(board.getWinningLines(rules, Sign::CROSS).count(), 0);
+	}
+	TEST(TestBitBoard, Freestyle)
+	{
+// @formatter:off
+		const matrix<Sign> board = Board::fromString(
+					/*        a b c d e f g h i j k l m n o          */
+					/*  0 */" ! _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  0 */
+					/*  1 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  1 */
+					/*  2 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  2 */
+					/*  3 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  3 */
+					/*  4 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  4 */
+					/*  5 */" ! _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  5 */
+					/*  6 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  6 */
+					/*  7 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  7 */
+					/*  8 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  8 */
+					/*  9 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  9 */
+					/* 10 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 10 */
+					/* 11 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 11 */
+					/* 12 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 12 */
+					/* 13 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 13 */
+					/* 14 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 14 */
+					/*        a b c d e f g h i j k l m n o          */);
+// @formatter:on
+
+		EXPECT_EQ(get_outcome(GameRules::FREESTYLE, board, Move("Xa0")), GameOutcome::CROSS_WIN);
+		EXPECT_EQ(get_outcome(GameRules::FREESTYLE, board, Move("Xa5")), GameOutcome::CROSS_WIN);
+		EXPECT_EQ(get_outcome(GameRules::STANDARD, board, Move("Xa0")), GameOutcome::CROSS_WIN);
+		EXPECT_EQ(get_outcome(GameRules::STANDARD, board, Move("Xa5")), GameOutcome::UNKNOWN);
+	}
+	TEST(TestBitBoard, RenjuOverline)
+	{
+// @formatter:off
+		const matrix<Sign> board = Board::fromString(
+					/*        a b c d e f g h i j k l m n o          */
+					/*  0 */" ! _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  0 */
+					/*  1 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  1 */
+					/*  2 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  2 */
+					/*  3 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  3 */
+					/*  4 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  4 */
+					/*  5 */" ! X X X X _ _ _ _ _ _ _ _ _ _\n" /*  5 */
+					/*  6 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  6 */
+					/*  7 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  7 */
+					/*  8 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  8 */
+					/*  9 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  9 */
+					/* 10 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 10 */
+					/* 11 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 11 */
+					/* 12 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 12 */
+					/* 13 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 13 */
+					/* 14 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 14 */
+					/*        a b c d e f g h i j k l m n o          */);
+// @formatter:on
+
+		EXPECT_EQ(get_outcome(GameRules::RENJU, board, Move("Xa0")), GameOutcome::CROSS_WIN);
+		EXPECT_EQ(get_outcome(GameRules::RENJU, board, Move("Xa5")), GameOutcome::CROSS_WIN); // five inside overline
+		EXPECT_EQ(get_outcome(GameRules::RENJU, board, Move("Xa7")), GameOutcome::UNKNOWN);
+
+		matrix<Sign> tmp = board;
+		tmp.at(5, 1) = Sign::NONE;
+		EXPECT_EQ(get_outcome(GameRules::RENJU, tmp, Move("Xa5")), GameOutcome::CIRCLE_WIN); // only overline
+		EXPECT_EQ(get_outcome(GameRules::RENJU, tmp, Move("Oa5")), GameOutcome::UNKNOWN);
+	}
+	TEST(TestBitBoard, RenjuForks)
+	{
+// @formatter:off
+		const matrix<Sign> board = Board::fromString(
+					/*        a b c d e f g h i j k l m n o          */
+					/*  0 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  0 */
+					/*  1 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  1 */
+					/*  2 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  2 */
+					/*  3 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  3 */
+					/*  4 */" _ _ _ _ _ _ _ X _ _ _ _ _ _ _\n" /*  4 */
+					/*  5 */" _ _ _ _ _ _ _ X _ _ _ _ _ _ _\n" /*  5 */
+					/*  6 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  6 */
+					/*  7 */" _ _ _ _ _ X X ! _ _ _ _ _ _ _\n" /*  7 */
+					/*  8 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  8 */
+					/*  9 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  9 */
+					/* 10 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 10 */
+					/* 11 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 11 */
+					/* 12 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 12 */
+					/* 13 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 13 */
+					/* 14 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 14 */
+					/*        a b c d e f g h i j k l m n o          */);
+// @formatter:on
+
+		EXPECT_EQ(get_outcome(GameRules::RENJU, board, Move("Xh7")), GameOutcome::CIRCLE_WIN);
+		EXPECT_EQ(get_outcome(GameRules::RENJU, board, Move("Xh7")), getOutcome(GameRules::RENJU, board, Move("Xh7")));
+		EXPECT_EQ(get_outcome(GameRules::FREESTYLE, board, Move("Xh7")), GameOutcome::UNKNOWN);
+	}
+	TEST(TestBitBoard, CaroBlockedFive)
+	{
+// @formatter:off
+		const matrix<Sign> board = Board::fromString(
+					/*        a b c d e f g h i j k l m n o          */
+					/*  0 */" O _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  0 */
+					/*  1 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  1 */
+					/*  2 */" X _ _ _ _ _ _ _ _ _ O _ _ _ _\n" /*  2 */
+					/*  3 */" X _ _ _ _ _ _ _ _ X _ _ _ _ _\n" /*  3 */
+					/*  4 */" ! _ _ _ _ _ _ _ X _ _ _ _ _ _\n" /*  4 */
+					/*  5 */" X _ _ _ _ _ _ ! _ _ _ _ _ _ _\n" /*  5 */
+					/*  6 */" O _ _ _ _ _ X _ _ _ _ _ _ _ X\n" /*  6 */
+					/*  7 */" _ _ _ _ _ X _ _ _ _ _ _ _ _ X\n" /*  7 */
+					/*  8 */" _ _ _ _ X _ _ _ _ _ _ _ _ _ !\n" /*  8 */
+					/*  9 */" _ _ _ O _ _ _ _ _ _ _ _ _ _ X\n" /*  9 */
+					/* 10 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ X\n" /* 10 */
+					/* 11 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ X\n" /* 11 */
+					/* 12 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ O\n" /* 12 */
+					/* 13 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 13 */
+					/* 14 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 14 */
+					/*        a b c d e f g h i j k l m n o          */);
+// @formatter:on
+
+		EXPECT_EQ(get_outcome(GameRules::CARO5, board, Move("Xa4")), GameOutcome::UNKNOWN);
+		EXPECT_EQ(get_outcome(GameRules::CARO5, board, Move("Xh5")), GameOutcome::UNKNOWN);
+		EXPECT_EQ(get_outcome(GameRules::CARO5, board, Move("Xo8")), GameOutcome::UNKNOWN);
+
+		EXPECT_EQ(get_outcome(GameRules::CARO6, board, Move("Xa4")), GameOutcome::UNKNOWN);
+		EXPECT_EQ(get_outcome(GameRules::CARO6, board, Move("Xh5")), GameOutcome::CROSS_WIN);
+		EXPECT_EQ(get_outcome(GameRules::CARO6, board, Move("Xo8")), GameOutcome::CROSS_WIN);
+	}
+	TEST(TestBitBoard, CaroFiveAtBorder)
+	{
+// @formatter:off
+		const matrix<Sign> board = Board::fromString(
+					/*        a b c d e f g h i j k l m n o          */
+					/*  0 */" ! _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  0 */
+					/*  1 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  1 */
+					/*  2 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  2 */
+					/*  3 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  3 */
+					/*  4 */" X _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  4 */
+					/*  5 */" O _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  5 */
+					/*  6 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  6 */
+					/*  7 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  7 */
+					/*  8 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  8 */
+					/*  9 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  9 */
+					/* 10 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 10 */
+					/* 11 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 11 */
+					/* 12 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 12 */
+					/* 13 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 13 */
+					/* 14 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 14 */
+					/*        a b c d e f g h i j k l m n o          */);
+// @formatter:on
+
+		EXPECT_EQ(get_outcome(GameRules::CARO5, board, Move("Xa0")), GameOutcome::CROSS_WIN);
+		EXPECT_EQ(get_outcome(GameRules::CARO6, board, Move("Xa0")), GameOutcome::CROSS_WIN);
+	}
+	TEST(TestBitBoard, SameAsPatterns)
+	{
+		for (GameRules rules : { GameRules::FREESTYLE, GameRules::STANDARD, GameRules::RENJU, GameRules::CARO5, GameRules::CARO6 })
+			for (int i = 0; i < 100; i++)
+			{
+				const matrix<Sign> board = get_random_board(15, 15, 150);
+				BitBoard bit_board(board);
+				for (int row = 0; row < board.rows(); row++)
+					for (int col = 0; col < board.cols(); col++)
+						if (board.at(row, col) == Sign::NONE)
+							for (Sign sign : { Sign::CROSS, Sign::CIRCLE })
+							{
+								const Move move(row, col, sign);
+								const GameOutcome outcome = getOutcome(rules, bit_board, move);
+								EXPECT_EQ(outcome, getOutcome(rules, board, move));
+
+								bit_board.putMove(move);
+								const bool is_win = (outcome == GameOutcome::CROSS_WIN and sign == Sign::CROSS)
+										or (outcome == GameOutcome::CIRCLE_WIN and sign == Sign::CIRCLE);
+								EXPECT_EQ(bit_board.getWinningLines(rules, sign).get(BitBoard::index(row, col)), is_win);
+								bit_board.undoMove(move);
+							}
+			}
+	}
+	TEST(TestBitBoard, Draw)
+	{
+		matrix<Sign> board(15, 15);
+		board.at(0, 0) = Sign::CROSS;
+		board.at(0, 1) = Sign::CIRCLE;
+		EXPECT_EQ(get_outcome(GameRules::FREESTYLE, board, Move("Xa0")), GameOutcome::UNKNOWN);
+		EXPECT_EQ(getOutcome(GameRules::FREESTYLE, BitBoard(board), Move("Xa0"), 2), GameOutcome::DRAW);
+		EXPECT_EQ(getOutcome(GameRules::FREESTYLE, BitBoard(board), Move("Xa0"), 3), GameOutcome::UNKNOWN);
+	}
+
+} /* namespace ag */
@@ -10,6 +10,7 @@
 #include <alphagomoku/game/Move.hpp>
 #include <alphagomoku/game/rules.hpp>
 #include <alphagomoku/patterns/PatternCalculator.hpp>
+#include <alphagomoku/utils/random.hpp>
 
 #include <gtest/gtest.h>
 
@@ -615,6 +616,36 @@ namespace ag
 
 		EXPECT_TRUE(is_forbidden(Move("Xf8")));
 	}
+	TEST_F(TestRenju, ForbiddenMovesAfterIncrementalUpdates)
+	{
+		for (int game = 0; game < 10; game++)
+		{
+			board = matrix<Sign>(15, 15);
+			calc.setBoard(board, Sign::CROSS);
+
+			std::vector<Move> moves;
+			for (int i = 0; i < 200; i++)
+			{
+				if (moves.size() > 0 and randInt(4) == 0)
+				{
+					undo_move(moves.back());
+					moves.pop_back();
+				}
+				else
+				{ // moves are played in the center of the board to create many forks
+					const Move move(calc.getSignToMove(), 3 + randInt(9), 3 + randInt(9));
+					if (board.at(move.row, move.col) != Sign::NONE)
+						continue;
+					add_move(move);
+					moves.push_back(move);
+				}
+				for (int row = 0; row < board.rows(); row++)
+					for (int col = 0; col < board.cols(); col++)
+						if (board.at(row, col) == Sign::NONE)
+							is_forbidden(Move(row, col, Sign::CROSS));
+			}
+		}
+	}
 
 //	TEST_F(TestRenju, Placeholder)
 //	{
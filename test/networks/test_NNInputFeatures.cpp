@@ -10,6 +10,7 @@
 #include <alphagomoku/patterns/PatternCalculator.hpp>
 #include <alphagomoku/utils/augmentations.hpp>
 #include <alphagomoku/utils/configs.hpp>
+#include <alphagomoku/utils/random.hpp>
 
 #include <gtest/gtest.h>
 
@@ -277,6 +278,63 @@ namespace ag
 		EXPECT_TRUE(is_set_bit<23>(features.at(7, 10)));
 		EXPECT_TRUE(is_set_bit<23>(features.at(10, 7)));
 	}
+	TEST(TestNNInputFeatures, batch_encoder)
+	{
+		const GameConfig cfg(GameRules::RENJU, 15, 15);
+		std::vector<matrix<Sign>> boards(10, matrix<Sign>(cfg.rows, cfg.cols));
+		std::vector<Sign> signs_to_move(boards.size());
+		for (size_t i = 0; i < boards.size(); i++)
+		{
+			for (int j = 0; j < 40; j++)
+				boards[i].at(randInt(cfg.rows), randInt(cfg.cols)) = (j % 2 == 0) ? Sign::CROSS : Sign::CIRCLE;
+			signs_to_move[i] = (i % 2 == 0) ? Sign::CROSS : Sign::CIRCLE;
+		}
+
+		NNInputFeaturesEncoder encoder(cfg);
+		std::vector<uint32_t> encoded(boards.size() * cfg.rows * cfg.cols);
+		encoder.encode(boards, signs_to_move, encoded.data(), 3);
+
+		PatternCalculator calc(cfg);
+		NNInputFeatures correct(cfg.rows, cfg.cols);
+		for (size_t i = 0; i < boards.size(); i++)
+		{
+			calc.setBoard(boards[i], signs_to_move[i]);
+			correct.encode(calc);
+			EXPECT_TRUE(std::equal(correct.begin(), correct.end(), encoded.begin() + i * correct.size()));
+		}
+	}
+	TEST(TestNNInputFeatures, incremental_update)
+	{
+		const GameConfig cfg(GameRules::RENJU, 15, 15);
+		matrix<Sign> board(cfg.rows, cfg.cols);
+
+		PatternCalculator calc(cfg);
+		calc.setBoard(board, Sign::CROSS);
+		NNInputFeatures features(cfg.rows, cfg.cols);
+		NNInputFeatures correct(cfg.rows, cfg.cols);
+		features.encode(calc);
+
+		std::vector<Move> moves;
+		for (int i = 0; i < 100; i++)
+		{
+			if (moves.size() > 0 and randInt(4) == 0)
+			{
+				calc.undoMove(moves.back());
+				moves.pop_back();
+			}
+			else
+			{
+				Move move(calc.getSignToMove(), randInt(cfg.rows), randInt(cfg.cols));
+				if (calc.signAt(move.row, move.col) != Sign::NONE)
+					continue;
+				calc.addMove(move);
+				moves.push_back(move);
+			}
+			features.update(calc);
+			correct.encode(calc);
+			EXPECT_EQ(correct, features);
+		}
+	}
 
 } /* namespace ag */
 
@@ -0,0 +1,173 @@
+/*
+ * test_NetworkDataPack.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/networks/NetworkDataPack.hpp>
+#include <alphagomoku/networks/NNInputFeatures.hpp>
+#include <alphagomoku/patterns/PatternCalculator.hpp>
+#include <alphagomoku/search/Value.hpp>
+#include <alphagomoku/utils/augmentations.hpp>
+#include <alphagomoku/utils/configs.hpp>
+#include <alphagomoku/utils/random.hpp>
+
+#include <minml/core/Tensor.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace
+{
+	using namespace ag;
+
+	/*
+	 * \brief Inputs and targets of one sample, packed into the data pack before augmentation.
+	 */
+	struct PackedSample
+	{
+			matrix<Sign> board;
+			Sign sign_to_move = Sign::NONE;
+			matrix<float> policy;
+			matrix<Value> action_values;
+			matrix<float> mask;
+
+			PackedSample(const GameConfig &cfg) :
+					board(cfg.rows, cfg.cols),
+					policy(cfg.rows, cfg.cols),
+					action_values(cfg.rows, cfg.cols),
+					mask(cfg.rows, cfg.cols)
+			{
+				for (int j = 0; j < 40; j++)
+					board.at(randInt(cfg.rows), randInt(cfg.cols)) = (j % 2 == 0) ? Sign::CROSS : Sign::CIRCLE;
+				sign_to_move = (randInt(2) == 0) ? Sign::CROSS : Sign::CIRCLE;
+				for (int i = 0; i < policy.size(); i++)
+				{
+					policy[i] = randFloat();
+					action_values[i] = Value(0.5f * randFloat(), 0.5f * randFloat());
+					mask[i] = randFloat();
+				}
+			}
+			void pack(NetworkDataPack &pack, int index) const
+			{
+				pack.packInputData(index, board, sign_to_move);
+				pack.packPolicyTarget(index, policy);
+				pack.packActionValuesTarget(index, action_values, mask);
+				pack.packMovesLeftTarget(index, index);
+			}
+	};
+
+	matrix<float> unpack_policy_target(const NetworkDataPack &pack, int index)
+	{
+		const GameConfig cfg = pack.getGameConfig();
+		matrix<float> result(cfg.rows, cfg.cols);
+		for (int i = 0; i < result.size(); i++)
+			result[i] = pack.getTarget('p').get( { index, i });
+		return result;
+	}
+	matrix<float> unpack_channel(const ml::Tensor &tensor, int index, int channel)
+	{
+		matrix<float> result(tensor.dim(1), tensor.dim(2));
+		for (int row = 0; row < result.rows(); row++)
+			for (int col = 0; col < result.cols(); col++)
+				result.at(row, col) = tensor.get( { index, row, col, channel });
+		return result;
+	}
+	matrix<float> get_win_rates(const matrix<Value> &values)
+	{
+		matrix<float> result(values.rows(), values.cols());
+		for (int i = 0; i < values.size(); i++)
+			result[i] = values[i].win_rate;
+		return result;
+	}
+}
+
+namespace ag
+{
+	TEST(TestNetworkDataPack, augmentMatchesSymmetryOfEachSample)
+	{
+		const GameConfig cfg(GameRules::STANDARD, 15);
+		NetworkDataPack pack(cfg, 9, ml::DataType::FLOAT32);
+
+		std::vector<PackedSample> samples;
+		for (int b = 0; b < pack.getBatchSize(); b++)
+		{
+			samples.push_back(PackedSample(cfg));
+			samples.back().pack(pack, b);
+		}
+		std::vector<Symmetry> symmetries;
+		for (int b = 0; b < 8; b++)
+			symmetries.push_back(int_to_symmetry(b)); // the last sample is left unchanged
+		pack.augment(symmetries);
+
+		PatternCalculator calc(cfg);
+		NNInputFeatures features(cfg.rows, cfg.cols);
+		for (int b = 0; b < pack.getBatchSize(); b++)
+		{
+			const int mode = (b < 8) ? b : 0;
+			calc.setBoard(samples[b].board, samples[b].sign_to_move);
+			features.encode(calc);
+			features.augment(mode);
+			const uint32_t *input = reinterpret_cast<const uint32_t*>(pack.getInput().data()) + b * features.size();
+			EXPECT_TRUE(std::equal(features.begin(), features.end(), input));
+
+			matrix<float> policy = samples[b].policy;
+			apply_symmetry_in_place(policy, int_to_symmetry(mode));
+			EXPECT_EQ(unpack_policy_target(pack, b), policy);
+
+			matrix<float> win_rates = get_win_rates(samples[b].action_values);
+			apply_symmetry_in_place(win_rates, int_to_symmetry(mode));
+			EXPECT_EQ(unpack_channel(pack.getTarget('q'), b, 0), win_rates);
+
+			matrix<float> mask = samples[b].mask;
+			apply_symmetry_in_place(mask, int_to_symmetry(mode));
+			EXPECT_EQ(unpack_channel(pack.getMask('q'), b, 2), mask);
+
+			EXPECT_EQ(pack.getTarget('m').get( { b, b }), 1.0f); // moves left is not spatial
+		}
+	}
+	TEST(TestNetworkDataPack, packInputOfManyPositions)
+	{
+		const GameConfig cfg(GameRules::RENJU, 15);
+		NetworkDataPack single(cfg, 8, ml::DataType::FLOAT32);
+		NetworkDataPack many(cfg, 8, ml::DataType::FLOAT32);
+
+		std::vector<matrix<Sign>> boards;
+		std::vector<Sign> signs_to_move;
+		for (int b = 0; b < 6; b++) // the remaining samples of the batch are not packed
+		{
+			const PackedSample sample(cfg);
+			boards.push_back(sample.board);
+			signs_to_move.push_back(sample.sign_to_move);
+			single.packInputData(b, sample.board, sample.sign_to_move);
+		}
+		many.packInputData(boards, signs_to_move, 3);
+
+		const uint32_t *lhs = reinterpret_cast<const uint32_t*>(single.getInput().data());
+		const uint32_t *rhs = reinterpret_cast<const uint32_t*>(many.getInput().data());
+		EXPECT_TRUE(std::equal(lhs, lhs + 6 * cfg.rows * cfg.cols, rhs));
+	}
+	TEST(TestNetworkDataPack, augmentOnlyListedTensors)
+	{
+		const GameConfig cfg(GameRules::STANDARD, 15);
+		NetworkDataPack pack(cfg, 2, ml::DataType::FLOAT32);
+		const PackedSample sample(cfg);
+		sample.pack(pack, 0);
+		sample.pack(pack, 1);
+
+		pack.augment( { Symmetry::IDENTITY, int_to_symmetry(3) }, "", "q"); // like in distillation, where targets come from the teacher network
+		EXPECT_EQ(unpack_policy_target(pack, 0), sample.policy);
+		EXPECT_EQ(unpack_policy_target(pack, 1), sample.policy);
+		EXPECT_EQ(unpack_channel(pack.getTarget('q'), 1, 0), get_win_rates(sample.action_values));
+
+		matrix<float> mask = sample.mask;
+		EXPECT_EQ(unpack_channel(pack.getMask('q'), 0, 0), mask);
+		apply_symmetry_in_place(mask, int_to_symmetry(3));
+		EXPECT_EQ(unpack_channel(pack.getMask('q'), 1, 0), mask);
+
+		EXPECT_THROW(pack.augment( { int_to_symmetry(1) }, "m", ""), std::logic_error);
+	}
+
+} /* namespace ag */
@@ -0,0 +1,89 @@
+/*
+ * test_PatternTable.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/patterns/PatternTable.hpp>
+#include <alphagomoku/patterns/Pattern.hpp>
+#include <alphagomoku/utils/file_util.hpp>
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace ag;
+
+	uint32_t expand(uint32_t x) noexcept
+	{
+		return (x & 1023u) | ((x & 1047552u) << 2u);
+	}
+	bool are_equal(const PatternTable &lhs, const PatternTable &rhs)
+	{
+		for (uint32_t i = 0; i < (1u << 20u); i++)
+		{
+			const NormalPattern pattern(expand(i));
+			if (lhs.getPatternType(pattern).forCross() != rhs.getPatternType(pattern).forCross()
+					or lhs.getPatternType(pattern).forCircle() != rhs.getPatternType(pattern).forCircle())
+				return false;
+			for (Sign s : { Sign::CROSS, Sign::CIRCLE })
+			{
+				if (lhs.isHalfOpenThree(pattern, s) != rhs.isHalfOpenThree(pattern, s))
+					return false;
+				for (int j = 0; j < Pattern::length; j++)
+					if (lhs.getUpdateMask(pattern, s).get(j) != rhs.getUpdateMask(pattern, s).get(j))
+						return false;
+			}
+		}
+		return true;
+	}
+}
+
+namespace ag
+{
+	TEST(TestPatternTable, LoadFromFile)
+	{
+		const std::string path = "test_pattern_tables.bin";
+		PatternTable::generateTableFile(path);
+
+		PatternTable::setTableFile(path);
+		const PatternTable loaded(GameRules::RENJU);
+		PatternTable::setTableFile("");
+		const PatternTable generated(GameRules::RENJU);
+
+		EXPECT_TRUE(loaded.isMemoryMapped());
+		EXPECT_FALSE(generated.isMemoryMapped());
+		EXPECT_TRUE(are_equal(loaded, generated));
+		removeFile(path);
+	}
+	TEST(TestPatternTable, CorruptedFile)
+	{
+		const std::string path = "test_pattern_tables.bin";
+		PatternTable::generateTableFile(path);
+		{ /* artificial scope for closing the file */
+			std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+			file.seekg(-1, std::ios::end);
+			const char last_byte = file.get();
+			file.seekp(-1, std::ios::end);
+			file.put(~last_byte);
+		}
+
+		PatternTable::setTableFile(path);
+		const PatternTable table(GameRules::CARO6); // the last table in the file is corrupted, so it must be generated instead
+		PatternTable::setTableFile("");
+		EXPECT_FALSE(table.isMemoryMapped());
+		EXPECT_TRUE(are_equal(table, PatternTable::get(GameRules::CARO6)));
+		removeFile(path);
+	}
+	TEST(TestPatternTable, MissingFile)
+	{
+		PatternTable::setTableFile("this_file_does_not_exist.bin");
+		const PatternTable table(GameRules::FREESTYLE);
+		PatternTable::setTableFile("");
+		EXPECT_FALSE(table.isMemoryMapped());
+	}
+
+} /* namespace ag */
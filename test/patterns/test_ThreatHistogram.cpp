@@ -0,0 +1,142 @@
+/*
+ * test_ThreatHistogram.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/patterns/ThreatHistogram.hpp>
+#include <alphagomoku/patterns/PatternCalculator.hpp>
+#include <alphagomoku/utils/configs.hpp>
+#include <alphagomoku/utils/random.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace
+{
+	using namespace ag;
+
+	/*
+	 * \brief Order of locations in the lists is not specified, so they are compared as sorted indices.
+	 */
+	std::vector<int> to_sorted_indices(const LocationList &list)
+	{
+		std::vector<int> result;
+		for (size_t i = 0; i < list.size(); i++)
+			result.push_back(list[i].row * 32 + list[i].col);
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+	std::vector<int> to_sorted_indices(const std::vector<Location> &list)
+	{
+		LocationList tmp;
+		tmp.insert(tmp.end(), list.begin(), list.end());
+		return to_sorted_indices(tmp);
+	}
+
+	void expect_matching_threats(const PatternCalculator &calc, Sign sign)
+	{
+		const ThreatHistogram &histogram = calc.getThreatHistogram(sign);
+		for (int t = 1; t < 10; t++)
+		{
+			const ThreatType threat = static_cast<ThreatType>(t);
+			std::vector<Location> expected;
+			for (int row = 0; row < calc.getConfig().rows; row++)
+				for (int col = 0; col < calc.getConfig().cols; col++)
+					if (calc.signAt(row, col) == Sign::NONE and calc.getThreatAt(sign, row, col) == threat)
+						expected.push_back(Location(row, col));
+			EXPECT_EQ(to_sorted_indices(histogram.get(threat)), to_sorted_indices(expected));
+		}
+	}
+}
+
+namespace ag
+{
+	TEST(TestThreatHistogram, addAndRemove)
+	{
+		ThreatHistogram histogram;
+		std::vector<Location> added;
+		for (int i = 0; i < 40; i++) // more than fits into a single vector register
+		{
+			added.push_back(Location(i / 15, i % 15));
+			histogram.add(ThreatType::OPEN_3, added.back());
+		}
+		histogram.add(ThreatType::FIVE, Location(14, 14));
+		EXPECT_EQ(histogram.numberOf(ThreatType::OPEN_3), 40);
+		EXPECT_EQ(histogram.numberOf(ThreatType::FIVE), 1);
+		EXPECT_EQ(to_sorted_indices(histogram.get(ThreatType::OPEN_3)), to_sorted_indices(added));
+
+		for (int i : { 39, 0, 33, 17 }) // last, first, past the first register and in the middle
+		{
+			histogram.remove(ThreatType::OPEN_3, added[i]);
+			added.erase(added.begin() + i);
+			EXPECT_EQ(to_sorted_indices(histogram.get(ThreatType::OPEN_3)), to_sorted_indices(added));
+		}
+		EXPECT_EQ(histogram.numberOf(ThreatType::FIVE), 1);
+
+		histogram.remove(ThreatType::FIVE, Location(14, 14));
+		EXPECT_EQ(histogram.numberOf(ThreatType::FIVE), 0);
+		EXPECT_FALSE(histogram.hasAnyFour());
+	}
+	TEST(TestThreatHistogram, noneIsNotStored)
+	{
+		ThreatHistogram histogram;
+		histogram.add(ThreatType::NONE, Location(1, 1));
+		EXPECT_EQ(histogram.numberOf(ThreatType::NONE), 0);
+		histogram.remove(ThreatType::NONE, Location(1, 1));
+		EXPECT_EQ(histogram.numberOf(ThreatType::NONE), 0);
+		EXPECT_FALSE(histogram.canMakeAnyThreat());
+	}
+	TEST(TestThreatHistogram, clear)
+	{
+		ThreatHistogram histogram;
+		histogram.add(ThreatType::HALF_OPEN_4, Location(2, 3));
+		histogram.add(ThreatType::OPEN_3, Location(4, 5));
+		EXPECT_TRUE(histogram.hasAnyFour());
+		EXPECT_TRUE(histogram.canMakeAnyThreat());
+
+		histogram.clear();
+		for (int t = 0; t < 10; t++)
+			EXPECT_EQ(histogram.numberOf(static_cast<ThreatType>(t)), 0);
+		EXPECT_FALSE(histogram.hasAnyFour());
+		EXPECT_FALSE(histogram.canMakeAnyThreat());
+
+		histogram.add(ThreatType::HALF_OPEN_4, Location(2, 3)); // the same location can be added again
+		EXPECT_EQ(histogram.numberOf(ThreatType::HALF_OPEN_4), 1);
+	}
+	TEST(TestThreatHistogram, matchesThreatsOfCalculator)
+	{
+		for (GameRules rules : { GameRules::FREESTYLE, GameRules::STANDARD, GameRules::RENJU, GameRules::CARO5 })
+		{
+			const GameConfig cfg(rules, 15);
+			PatternCalculator calc(cfg);
+			calc.setBoard(matrix<Sign>(cfg.rows, cfg.cols), Sign::CROSS);
+
+			std::vector<Move> moves;
+			Sign sign_to_move = Sign::CROSS;
+			for (int i = 0; i < 60; i++)
+			{
+				Move move;
+				do
+				{
+					move = Move(randInt(cfg.rows), randInt(cfg.cols), sign_to_move);
+				} while (calc.signAt(move.row, move.col) != Sign::NONE);
+				calc.addMove(move);
+				moves.push_back(move);
+				sign_to_move = invertSign(sign_to_move);
+				expect_matching_threats(calc, Sign::CROSS);
+				expect_matching_threats(calc, Sign::CIRCLE);
+			}
+			for (int i = 0; i < 20; i++)
+			{
+				calc.undoMove(moves.back());
+				moves.pop_back();
+				expect_matching_threats(calc, Sign::CROSS);
+				expect_matching_threats(calc, Sign::CIRCLE);
+			}
+		}
+	}
+
+} /* namespace ag */
@@ -0,0 +1,102 @@
+/*
+ * test_dfpn_search.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/game/Board.hpp>
+#include <alphagomoku/game/Move.hpp>
+#include <alphagomoku/search/alpha_beta/DFPNSearch.hpp>
+#include <alphagomoku/search/monte_carlo/SearchTask.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace ag;
+
+	matrix<Sign> get_vct_position()
+	{
+// @formatter:off
+		return Board::fromString(
+				/*        a b c d e f g h i j k l          */
+				/*  0 */" _ _ _ _ _ _ _ _ _ _ _ _\n" /*  0 */
+				/*  1 */" _ _ _ _ _ _ _ _ _ _ _ _\n" /*  1 */
+				/*  2 */" _ _ _ _ _ _ _ _ _ _ _ _\n" /*  2 */
+				/*  3 */" _ _ _ _ O _ _ _ _ _ _ _\n" /*  3 */
+				/*  4 */" _ _ _ O _ _ _ X _ _ _ _\n" /*  4 */
+				/*  5 */" _ _ _ _ _ _ _ _ _ _ _ _\n" /*  5 */
+				/*  6 */" _ _ _ _ _ O _ _ X _ _ _\n" /*  6 */
+				/*  7 */" _ _ _ _ _ O _ X _ _ _ _\n" /*  7 */
+				/*  8 */" _ _ _ _ _ _ _ _ X _ _ _\n" /*  8 */
+				/*  9 */" _ _ _ _ _ _ _ _ _ _ _ _\n" /*  9 */
+				/* 10 */" _ _ _ _ _ _ _ _ _ _ _ _\n" /* 10 */
+				/* 11 */" _ _ _ _ _ _ _ _ _ _ _ _\n" /* 11 */
+				/*        a b c d e f g h i j k l          */);
+// @formatter:on
+	}
+}
+
+namespace ag
+{
+	TEST(TestDFPNSearch, NoThreats)
+	{
+		const GameConfig game_config(GameRules::FREESTYLE, 12, 12);
+		matrix<Sign> board(game_config.rows, game_config.cols);
+		board.at(5, 5) = Sign::CROSS;
+		board.at(6, 6) = Sign::CIRCLE;
+
+		DFPNSearch search(game_config, 1024);
+		search.setNodeLimit(1000);
+		SearchTask task(game_config);
+		task.set(board, Sign::CROSS);
+
+		EXPECT_EQ(search.solve(task), 1);
+		EXPECT_TRUE(task.getScore().isUnproven());
+	}
+	TEST(TestDFPNSearch, VictoryByContinuousThreats)
+	{
+		const GameConfig game_config(GameRules::FREESTYLE, 12, 12);
+
+		DFPNSearch search(game_config, 65536);
+		search.setNodeLimit(10000);
+		SearchTask task(game_config);
+		task.set(get_vct_position(), Sign::CROSS);
+
+		search.solve(task);
+		EXPECT_TRUE(task.getScore().isWin());
+		EXPECT_TRUE(task.getActionScores().at(5, 8).isWin());
+	}
+	TEST(TestDFPNSearch, OnlyFours)
+	{
+		const GameConfig game_config(GameRules::FREESTYLE, 12, 12);
+
+		DFPNSearch search(game_config, 65536);
+		search.setNodeLimit(10000);
+		search.useOpenThrees(false);
+		SearchTask task(game_config);
+		task.set(get_vct_position(), Sign::CROSS);
+
+		search.solve(task);
+		EXPECT_TRUE(task.getScore().isUnproven());
+	}
+	TEST(TestDFPNSearch, TableIsSeparatedByAttacker)
+	{
+		const GameConfig game_config(GameRules::FREESTYLE, 12, 12);
+
+		DFPNSearch search(game_config, 65536);
+		search.setNodeLimit(10000);
+		SearchTask task(game_config);
+		task.set(get_vct_position(), Sign::CROSS);
+		search.solve(task);
+		EXPECT_TRUE(task.getScore().isWin());
+
+		// the same positions are now searched with the other side attacking, which also has a winning sequence of threats
+		task.set(get_vct_position(), Sign::CIRCLE);
+		search.solve(task);
+		EXPECT_TRUE(task.getScore().isWin());
+		EXPECT_TRUE(task.getActionScores().at(5, 2).isWin());
+	}
+
+} /* namespace ag */
@@ -0,0 +1,107 @@
+/*
+ * test_Search.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/game/Board.hpp>
+#include <alphagomoku/search/alpha_beta/ParallelAlphaBetaSearch.hpp>
+#include <alphagomoku/search/monte_carlo/Search.hpp>
+#include <alphagomoku/search/monte_carlo/Tree.hpp>
+#include <alphagomoku/search/monte_carlo/EdgeSelector.hpp>
+#include <alphagomoku/search/monte_carlo/EdgeGenerator.hpp>
+#include <alphagomoku/utils/misc.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace ag;
+
+	matrix<Sign> get_sharp_position()
+	{ // circle has initiative, but cannot prove a win with fours only
+// @formatter:off
+		return Board::fromString(
+				/*        a b c d e f g h i j k l m n o          */
+				/*  0 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  0 */
+				/*  1 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  1 */
+				/*  2 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  2 */
+				/*  3 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /*  3 */
+				/*  4 */" _ _ _ _ O _ X _ _ X X _ _ _ _\n" /*  4 */
+				/*  5 */" _ _ _ _ O X X O _ _ _ _ _ _ _\n" /*  5 */
+				/*  6 */" _ _ _ _ _ O _ _ _ _ _ _ _ _ _\n" /*  6 */
+				/*  7 */" _ _ _ _ _ _ _ X _ _ X _ _ _ _\n" /*  7 */
+				/*  8 */" _ _ _ _ X _ _ _ _ _ _ _ _ _ _\n" /*  8 */
+				/*  9 */" _ _ _ _ _ O _ X O O O _ _ _ _\n" /*  9 */
+				/* 10 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 10 */
+				/* 11 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 11 */
+				/* 12 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 12 */
+				/* 13 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 13 */
+				/* 14 */" _ _ _ _ _ _ _ _ _ _ _ _ _ _ _\n" /* 14 */
+				/*        a b c d e f g h i j k l m n o          */);
+// @formatter:on
+	}
+
+	class SearchFixture
+	{
+		public:
+			const GameConfig game_config;
+			const SearchConfig search_config;
+			Tree tree;
+			ParallelAlphaBetaSearch root_solver;
+			Search search;
+
+			SearchFixture(int numberOfHelpers) :
+					game_config(GameRules::STANDARD, 15),
+					tree(search_config.tree_config),
+					root_solver(game_config, numberOfHelpers, 65536),
+					search(game_config, search_config)
+			{
+				tree.setBoard(get_sharp_position(), Sign::CIRCLE);
+				tree.setEdgeSelector(*EdgeSelector::create(search_config.mcts_config.edge_selector_config));
+				tree.setEdgeGenerator(
+						UnifiedGenerator(search_config.mcts_config.max_children, search_config.mcts_config.policy_expansion_threshold,
+								search_config.mcts_config.policy_temperature));
+				search.setRootSolver(&root_solver);
+				search.setBatchSize(1);
+				search.select(tree); // the tree is empty, so only the root is selected
+			}
+	};
+}
+
+namespace ag
+{
+	TEST(TestSearch, parallelSolveOfSharpRoot)
+	{
+		SearchFixture fixture(2);
+		ASSERT_EQ(fixture.search.getBatchSize(), 1);
+
+		fixture.search.solve(getTime() + 1.0);
+		EXPECT_EQ(fixture.search.getStats().nb_parallel_root_solves, 1u);
+	}
+	TEST(TestSearch, noParallelSolveWithoutHelpers)
+	{
+		SearchFixture fixture(0);
+
+		fixture.search.solve(getTime() + 1.0);
+		EXPECT_EQ(fixture.search.getStats().nb_parallel_root_solves, 0u);
+	}
+	TEST(TestSearch, parallelSolveRespectsTimeLimit)
+	{
+		SearchFixture fixture(2);
+
+		const double time_limit = 0.05;
+		const double start = getTime();
+		fixture.search.solve(start + time_limit);
+		EXPECT_LT(getTime() - start, 1.5 * time_limit); // regular and parallel solve share the same slice of time
+	}
+	TEST(TestSearch, noParallelSolveWhenOutOfTime)
+	{
+		SearchFixture fixture(2);
+
+		fixture.search.solve(getTime()); // the regular solve uses up whole (empty) slice, nothing is left for the parallel one
+		EXPECT_EQ(fixture.search.getStats().nb_parallel_root_solves, 0u);
+	}
+
+} /* namespace ag */
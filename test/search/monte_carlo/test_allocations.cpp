@@ -0,0 +1,166 @@
+/*
+ * test_allocations.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/search/monte_carlo/Search.hpp>
+#include <alphagomoku/search/monte_carlo/Tree.hpp>
+#include <alphagomoku/search/monte_carlo/SearchTask.hpp>
+#include <alphagomoku/search/monte_carlo/EdgeSelector.hpp>
+#include <alphagomoku/search/monte_carlo/EdgeGenerator.hpp>
+#include <alphagomoku/utils/configs.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	/*
+	 * Replacing global operator new affects the whole test binary, so the allocations are counted only when explicitly enabled.
+	 */
+	std::atomic<bool> count_allocations(false);
+	std::atomic<int> allocation_counter(0);
+
+	class AllocationCounter
+	{
+		public:
+			AllocationCounter() noexcept
+			{
+				allocation_counter = 0;
+				count_allocations = true;
+			}
+			~AllocationCounter() noexcept
+			{
+				count_allocations = false;
+			}
+			int get() const noexcept
+			{
+				return allocation_counter.load();
+			}
+	};
+
+	void fake_evaluation(ag::SearchTask &task)
+	{ // fake but deterministic network evaluation
+		using namespace ag;
+		for (int k = 0; k < task.getPolicy().size(); k++)
+			task.getPolicy()[k] = (task.getBoard()[k] == Sign::NONE) ? 1.0f + (k * 7919 % 13) : 0.0f;
+		task.setValue(Value(0.4f, 0.2f));
+		task.markAsProcessedByNetwork();
+	}
+	void run_simulations(ag::Tree &tree, std::vector<ag::SearchTask> &tasks, int cycles)
+	{
+		using namespace ag;
+		for (int i = 0; i < cycles; i++)
+			for (size_t j = 0; j < tasks.size(); j++)
+			{
+				SearchTask &task = tasks[j];
+				tree.select(task);
+				fake_evaluation(task);
+				tree.generateEdges(task);
+				tree.expand(task);
+				tree.backup(task);
+			}
+	}
+	/*
+	 * \brief Same steps as in the serial loop of SearchThread, except that tasks are evaluated by 'fake_evaluation()' instead of the network.
+	 */
+	void run_search(ag::Search &search, ag::Tree &tree, int cycles)
+	{
+		using namespace ag;
+		for (int i = 0; i < cycles; i++)
+		{
+			search.setBatchSize(8);
+			search.select(tree);
+			search.solve();
+			for (int j = 0; j < search.getBatchSize(); j++)
+			{
+				SearchTask &task = search.getTask(j);
+				if (task.visitedPathLength() == 0 or not task.getScore().isProven()) // the same tasks as scheduled to the network
+					fake_evaluation(task);
+			}
+			search.generateEdges(tree);
+			search.expand(tree);
+			search.backup(tree);
+		}
+	}
+}
+
+void* operator new(std::size_t count)
+{
+	if (count_allocations.load(std::memory_order_relaxed))
+		allocation_counter++;
+	void *result = std::malloc((count == 0) ? 1 : count);
+	if (result == nullptr)
+		throw std::bad_alloc();
+	return result;
+}
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+void operator delete(void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+namespace ag
+{
+	TEST(TestAllocations, counterHook)
+	{
+		AllocationCounter counter;
+		std::vector<int> tmp(10);
+		EXPECT_EQ(counter.get(), 1);
+	}
+	TEST(TestAllocations, selectEvaluateExpandCycle)
+	{
+		const GameConfig game_config(GameRules::STANDARD, 15);
+		const matrix<Sign> board(game_config.rows, game_config.cols);
+		const MCTSConfig mcts_config;
+
+		Tree tree(TreeConfig { });
+		tree.setBoard(board, Sign::CROSS);
+		tree.setEdgeSelector(*EdgeSelector::create(mcts_config.edge_selector_config));
+		tree.setEdgeGenerator(UnifiedGenerator(mcts_config.max_children, mcts_config.policy_expansion_threshold, mcts_config.policy_temperature));
+		std::vector<SearchTask> tasks;
+		for (int i = 0; i < 8; i++)
+			tasks.push_back(SearchTask(game_config));
+
+		run_simulations(tree, tasks, 100); // warm-up
+		tree.clear(); // nodes and edges are not deallocated but moved to a buffer so the second search can reuse them
+		tree.setBoard(board, Sign::CROSS);
+
+		AllocationCounter counter;
+		run_simulations(tree, tasks, 100);
+		EXPECT_EQ(counter.get(), 0);
+	}
+	TEST(TestAllocations, searchCycleWithSolver)
+	{
+		const GameConfig game_config(GameRules::STANDARD, 15);
+		const matrix<Sign> board(game_config.rows, game_config.cols);
+		const SearchConfig search_config;
+
+		Tree tree(search_config.tree_config);
+		tree.setBoard(board, Sign::CROSS);
+		tree.setEdgeSelector(*EdgeSelector::create(search_config.mcts_config.edge_selector_config));
+		tree.setEdgeGenerator(
+				UnifiedGenerator(search_config.mcts_config.max_children, search_config.mcts_config.policy_expansion_threshold,
+						search_config.mcts_config.policy_temperature));
+		Search search(game_config, search_config);
+		search.setBoard(board, Sign::CROSS);
+		run_search(search, tree, 50); // warm-up
+		tree.clear();
+		search.clear(); // otherwise the solver would reuse its hashtable and proven positions, and the second search would be different
+		tree.setBoard(board, Sign::CROSS);
+		search.setBoard(board, Sign::CROSS);
+
+		AllocationCounter counter;
+		run_search(search, tree, 50);
+		EXPECT_EQ(counter.get(), 0);
+	}
+
+} /* namespace ag */
@@ -0,0 +1,67 @@
+/*
+ * test_ProvenPositionTable.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/search/ProvenPositionTable.hpp>
+#include <alphagomoku/utils/matrix.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace ag
+{
+	TEST(TestProvenPositionTable, seek_and_insert)
+	{
+		ProvenPositionTable table(12, 12, 64);
+		matrix<Sign> board(12, 12);
+		board.at(5, 5) = Sign::CROSS;
+		const HashKey128 hash = table.getHashFunction().getHash(board);
+
+		Score score;
+		Move move;
+		EXPECT_FALSE(table.seek(hash, Sign::CIRCLE, score, move));
+
+		table.insert(hash, Sign::CIRCLE, Score::win_in(7), Move(6, 6, Sign::CIRCLE));
+		EXPECT_TRUE(table.seek(hash, Sign::CIRCLE, score, move));
+		EXPECT_EQ(score, Score::win_in(7));
+		EXPECT_EQ(move, Move(6, 6, Sign::CIRCLE));
+		EXPECT_FALSE(table.seek(hash, Sign::CROSS, score, move)); // the same board with the other side to move is a different position
+
+		table.clear();
+		EXPECT_FALSE(table.seek(hash, Sign::CIRCLE, score, move));
+	}
+	TEST(TestProvenPositionTable, unproven_scores_are_not_stored)
+	{
+		ProvenPositionTable table(12, 12, 64);
+		const HashKey128 hash = table.getHashFunction().getHash(matrix<Sign>(12, 12));
+
+		Score score;
+		Move move;
+		table.insert(hash, Sign::CROSS, Score(100), Move(6, 6, Sign::CROSS));
+		EXPECT_FALSE(table.seek(hash, Sign::CROSS, score, move));
+		EXPECT_EQ(table.loadFactor(), 0.0);
+	}
+	TEST(TestProvenPositionTable, longest_proofs_are_kept)
+	{
+		ProvenPositionTable table(12, 12, 4); // single bucket
+		std::vector<HashKey128> hashes;
+		for (int i = 0; i < 5; i++)
+		{
+			matrix<Sign> board(12, 12);
+			board.at(0, i) = Sign::CROSS;
+			hashes.push_back(table.getHashFunction().getHash(board));
+			table.insert(hashes.back(), Sign::CIRCLE, Score::loss_in(10 - i), Move(6, 6, Sign::CIRCLE));
+		}
+		EXPECT_EQ(table.loadFactor(), 1.0);
+
+		Score score;
+		Move move;
+		EXPECT_FALSE(table.seek(hashes[3], Sign::CIRCLE, score, move)); // the shortest proof in the bucket was replaced by the new one
+		for (int i : { 0, 1, 2, 4 })
+			EXPECT_TRUE(table.seek(hashes[i], Sign::CIRCLE, score, move));
+	}
+} /* namespace ag */
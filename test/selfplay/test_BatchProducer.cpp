@@ -0,0 +1,133 @@
+/*
+ * test_BatchProducer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <alphagomoku/selfplay/BatchProducer.hpp>
+#include <alphagomoku/dataset/Dataset.hpp>
+#include <alphagomoku/dataset/GameDataBuffer.hpp>
+#include <alphagomoku/dataset/GameDataStorage.hpp>
+#include <alphagomoku/dataset/Sampler.hpp>
+#include <alphagomoku/utils/configs.hpp>
+#include <alphagomoku/utils/random.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+	using namespace ag;
+
+	const GameConfig cfg(GameRules::STANDARD, 15);
+
+	void sleep_for_milliseconds(int ms)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+	}
+	/*
+	 * \brief Waits up to a second for the condition to become true.
+	 */
+	template<class Condition>
+	bool wait_for(Condition condition)
+	{
+		for (int i = 0; i < 1000; i++)
+		{
+			if (condition())
+				return true;
+			sleep_for_milliseconds(1);
+		}
+		return condition();
+	}
+}
+
+namespace ag
+{
+	TEST(TestBatchProducer, batchesAreReturnedInOrder)
+	{
+		Dataset dataset; // the sampler is not used by the fill function below, so the dataset can be empty
+		std::mutex filled_mutex;
+		std::map<const NetworkDataPack*, int> filled; // number of times each pack was filled
+		auto fill = [&](NetworkDataPack &pack, Sampler &sampler)
+		{
+			sleep_for_milliseconds(randInt(3)); // later batches are often finished before the earlier ones
+			std::lock_guard<std::mutex> lock(filled_mutex);
+			filled[&pack]++;
+		};
+
+		BatchProducer producer(dataset, "values", nullptr, cfg, 4, ml::DataType::FLOAT32, 3, fill);
+		EXPECT_EQ(producer.numberOfWorkers(), 3);
+		const int ring_size = 2 * producer.numberOfWorkers();
+		std::vector<const NetworkDataPack*> ring;
+		for (int i = 0; i < 50; i++)
+		{
+			const NetworkDataPack &pack = producer.get();
+			if (i < ring_size)
+			{
+				EXPECT_EQ(std::count(ring.begin(), ring.end(), &pack), 0);
+				ring.push_back(&pack);
+			}
+			else
+				EXPECT_EQ(ring.at(i % ring_size), &pack); // packs are consumed in the order in which the workers claimed them
+			{
+				std::lock_guard<std::mutex> lock(filled_mutex);
+				EXPECT_EQ(filled.at(&pack), 1 + i / ring_size); // and each of them was filled again after it had been released
+			}
+			producer.release();
+		}
+		EXPECT_GT(producer.getLoadingTime(), 0.0);
+		EXPECT_GE(producer.getWaitingTime(), 0.0);
+	}
+	TEST(TestBatchProducer, workersStopWhenDestroyed)
+	{
+		Dataset dataset;
+		std::atomic<int> filled_batches { 0 };
+		auto fill = [&](NetworkDataPack &pack, Sampler &sampler)
+		{
+			filled_batches++;
+		};
+		{
+			BatchProducer producer(dataset, "values", nullptr, cfg, 4, ml::DataType::FLOAT32, 0, fill);
+			EXPECT_EQ(producer.numberOfWorkers(), 1);
+			EXPECT_TRUE(wait_for([&]()
+			{	return filled_batches == 2;})); // two packs per worker
+			sleep_for_milliseconds(10);
+			EXPECT_EQ(filled_batches, 2); // the worker waits for a free pack
+
+			producer.get();
+			producer.release();
+			EXPECT_TRUE(wait_for([&]()
+			{	return filled_batches == 3;}));
+			producer.get(); // the pack is still held by the consumer when the producer is destroyed
+		}
+		EXPECT_EQ(filled_batches, 3);
+
+		{ // destroyed while the workers are still filling the first batches
+			BatchProducer producer(dataset, "values", nullptr, cfg, 4, ml::DataType::FLOAT32, 2, [](NetworkDataPack &pack, Sampler &sampler)
+			{	sleep_for_milliseconds(20);});
+		}
+	}
+	TEST(TestBatchProducer, exceptionOfWorkerIsRethrown)
+	{
+		Dataset dataset;
+		{
+			BatchProducer producer(dataset, "values", nullptr, cfg, 4, ml::DataType::FLOAT32, 2, [](NetworkDataPack &pack, Sampler &sampler)
+			{	throw std::runtime_error("fill failed");});
+			EXPECT_THROW(producer.get(), std::runtime_error);
+			EXPECT_THROW(producer.get(), std::runtime_error); // the exception is kept
+		}
+		{ // sampler is created by the workers
+			BatchProducer producer(dataset, "unknown", nullptr, cfg, 4, ml::DataType::FLOAT32, 2, [](NetworkDataPack &pack, Sampler &sampler)
+			{});
+			EXPECT_THROW(producer.get(), std::logic_error);
+		}
+	}
+
+} /* namespace ag */
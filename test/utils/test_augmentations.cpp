@@ -224,5 +224,55 @@ namespace ag
 		apply_symmetry_in_place(in_place, get_inverse_symmetry(mode));
 		EXPECT_EQ(in_place, src);
 	}
-} /* namespace ag */
+	TEST(TestAugmentations, batch_gather)
+	{
+		const int channels = 2;
+		const matrix<int> src = get_matrix(8, 8);
+		std::vector<int16_t> batch;
+		for (int b = 0; b < 8; b++)
+			for (int i = 0; i < src.size(); i++)
+				for (int c = 0; c < channels; c++)
+					batch.push_back(src[i] + 100 * c);
 
+		const SymmetryIndexTable table(src.shape(), channels);
+		EXPECT_EQ(table.length(), src.size() * channels);
+		std::vector<Symmetry> symmetries;
+		for (int b = 0; b < 8; b++)
+			symmetries.push_back(int_to_symmetry(b));
+		std::vector<char> workspace;
+		apply_symmetry_to_batch(batch.data(), sizeof(int16_t), table, symmetries, workspace);
+
+		matrix<int> expected(src.rows(), src.cols());
+		for (int b = 0; b < 8; b++)
+		{
+			apply_symmetry(expected, src, symmetries[b]);
+			for (int i = 0; i < expected.size(); i++)
+				for (int c = 0; c < channels; c++)
+					EXPECT_EQ(batch[(b * src.size() + i) * channels + c], expected[i] + 100 * c);
+		}
+	}
+	TEST(TestAugmentations, batch_gather_with_permuted_channels)
+	{
+		const matrix<int> src = get_matrix(8, 9);
+		std::vector<int> batch;
+		for (int i = 0; i < src.size(); i++)
+			for (int c = 0; c < 3; c++)
+				batch.push_back(10 * src[i] + c);
+
+		SymmetryIndexTable table(src.shape(), 3);
+		EXPECT_THROW(table.permuteChannels(Symmetry::FLIP_VERTICALLY, { 0, 1 }), std::invalid_argument);
+		table.permuteChannels(Symmetry::FLIP_VERTICALLY, { 2, 0, 1 });
+		std::vector<char> workspace;
+		apply_symmetry_to_batch(batch.data(), sizeof(int), table, { Symmetry::FLIP_VERTICALLY }, workspace);
+
+		matrix<int> expected(src.rows(), src.cols());
+		apply_symmetry(expected, src, Symmetry::FLIP_VERTICALLY);
+		for (int i = 0; i < expected.size(); i++)
+		{
+			EXPECT_EQ(batch[3 * i + 0], 10 * expected[i] + 1);
+			EXPECT_EQ(batch[3 * i + 1], 10 * expected[i] + 2);
+			EXPECT_EQ(batch[3 * i + 2], 10 * expected[i] + 0);
+		}
+		EXPECT_EQ(&SymmetryIndexTable::getShared(src.shape(), 3), &SymmetryIndexTable::getShared(src.shape(), 3));
+	}
+} /* namespace ag */
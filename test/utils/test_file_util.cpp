@@ -7,8 +7,23 @@
 
 #include <alphagomoku/utils/file_util.hpp>
 
+#include <minml/utils/ZipWrapper.hpp>
+
 #include <gtest/gtest.h>
 
+#include <cstring>
+
+namespace
+{
+	std::vector<char> create_data(size_t size)
+	{
+		std::vector<char> result(size);
+		for (size_t i = 0; i < size; i++)
+			result[i] = static_cast<char>((i * 7919) % 251 + (i / 1000)); // compressible but not trivial
+		return result;
+	}
+}
+
 namespace ag
 {
 	TEST(TestFileUtil, save_load)
@@ -32,5 +47,124 @@ namespace ag
 		for (int i = 0; i < 100; i++)
 			EXPECT_EQ(data[i], loaded_data[i]);
 	}
-}
+	TEST(TestFileUtil, chunked_compression)
+	{
+		const std::vector<char> data = create_data(100000);
+		const std::vector<char> compressed = compressChunked(data, 4096, 4);
+		EXPECT_TRUE(isChunkedFormat(compressed));
+		EXPECT_FALSE(isChunkedFormat(data));
+		EXPECT_LT(compressed.size(), data.size());
+		EXPECT_EQ(uncompressChunked(compressed, 1), data);
+		EXPECT_EQ(uncompressChunked(compressed, 3), data);
+
+		EXPECT_TRUE(uncompressChunked(compressChunked(std::vector<char>())).empty());
+	}
+	TEST(TestFileUtil, chunked_corrupted_index)
+	{
+		const std::vector<char> compressed = compressChunked(create_data(10000), 1000);
+		const size_t number_of_chunks_offset = 12, total_size_offset = 24, first_entry_offset = 32; // layout of the header
 
+		std::vector<char> corrupted = compressed;
+		corrupted[number_of_chunks_offset]++;
+		EXPECT_THROW(uncompressChunked(corrupted), std::runtime_error);
+
+		corrupted = compressed;
+		corrupted[total_size_offset + 7] = 1; // huge size of the data
+		EXPECT_THROW(uncompressChunked(corrupted), std::runtime_error);
+
+		corrupted = compressed;
+		const uint64_t offset = compressed.size() - 10;
+		std::memcpy(corrupted.data() + first_entry_offset, &offset, sizeof(offset)); // first chunk extends beyond the end of the data
+		EXPECT_THROW(uncompressChunked(corrupted), std::runtime_error);
+
+		corrupted = compressed;
+		const uint64_t size = static_cast<uint64_t>(-1);
+		std::memcpy(corrupted.data() + first_entry_offset + sizeof(uint64_t), &size, sizeof(size));
+		EXPECT_THROW(uncompressChunked(corrupted), std::runtime_error);
+
+		corrupted.resize(first_entry_offset + 5); // truncated index
+		EXPECT_THROW(uncompressChunked(corrupted), std::runtime_error);
+	}
+	TEST(TestFileUtil, chunked_partial_read)
+	{
+		const std::vector<char> data = create_data(50000);
+		const std::vector<char> compressed = compressChunked(data, 1000);
+		{ /* artificial scope for closing the file */
+			std::ofstream stream("test_file.bin", std::ios::out | std::ios::binary);
+			stream.write(compressed.data(), compressed.size());
+		}
+
+		const ChunkedFileReader reader("test_file.bin");
+		EXPECT_EQ(reader.size(), data.size());
+		const size_t ranges[4][2] = { { 0, 10 }, { 999, 2 }, { 12345, 7000 }, { 49000, 1000 } };
+		for (int i = 0; i < 4; i++)
+		{
+			const std::vector<char> expected(data.begin() + ranges[i][0], data.begin() + ranges[i][0] + ranges[i][1]);
+			EXPECT_EQ(reader.read(ranges[i][0], ranges[i][1], 2), expected);
+		}
+		EXPECT_THROW(reader.read(49000, 1001), std::out_of_range);
+		removeFile("test_file.bin");
+	}
+	TEST(TestFileUtil, chunked_read_json)
+	{
+		const std::vector<char> data = create_data(10 * 1024 * 1024); // more than a single chunk
+		SerializedObject so;
+		so.save(data.data(), data.size());
+		Json json = { { "key0", 1.0 } };
+		json["key1"] = Json(JsonType::Array);
+		for (int i = 0; i < 3; i++)
+			json["key1"][i] = i;
+		{ /* artificial scope for closing the file */
+			FileSaver fs("test_file.bin");
+			fs.save(json, so, -1, true);
+		}
+		{ /* artificial scope for closing the file */
+			std::fstream stream("test_file.bin", std::ios::in | std::ios::out | std::ios::binary);
+			stream.seekp(-100, std::ios::end);
+			const std::vector<char> garbage(50, 'x');
+			stream.write(garbage.data(), garbage.size()); // only the last chunk is corrupted
+		}
+
+		EXPECT_EQ(ChunkedFileReader("test_file.bin").readJson().dump(), json.dump());
+		EXPECT_THROW(FileLoader("test_file.bin", true), std::exception);
+		removeFile("test_file.bin");
+	}
+	TEST(TestFileUtil, load_single_stream_compression)
+	{
+		const Json json = { { "key0", 1.0 } };
+		const std::string json_string = json.dump();
+		std::vector<char> content(json_string.begin(), json_string.end());
+		content.push_back('\n');
+		const std::vector<char> data = create_data(1000);
+		content.insert(content.end(), data.begin(), data.end());
+
+		const std::vector<char> compressed = ZipWrapper::compress(content); // format used before chunked compression was introduced
+		{ /* artificial scope for closing the file */
+			std::ofstream stream("test_file.bin", std::ios::out | std::ios::binary);
+			stream.write(compressed.data(), compressed.size());
+		}
+
+		FileLoader fl("test_file.bin", true);
+		EXPECT_EQ(fl.getJson().dump(), json_string);
+		EXPECT_EQ(fl.getBinaryData().size(), data.size());
+		removeFile("test_file.bin");
+	}
+	TEST(TestFileUtil, save_load_compressed)
+	{
+		const std::vector<char> data = create_data(10000);
+		SerializedObject so;
+		so.save(data.data(), data.size());
+		const Json json = { { "key0", 0.0 }, { "key1", "string" } };
+		{ /* artificial scope for closing the file */
+			FileSaver fs("test_file.bin");
+			fs.save(json, so, -1, true);
+		}
+
+		FileLoader fl("test_file.bin", true);
+		EXPECT_EQ(fl.getJson().dump(), json.dump());
+		std::vector<char> loaded_data(data.size());
+		fl.getBinaryData().load(loaded_data.data(), 0, loaded_data.size());
+		EXPECT_EQ(loaded_data, data);
+		removeFile("test_file.bin");
+	}
+}
@@ -6,6 +6,7 @@
  */
 
 #include <alphagomoku/selfplay/TrainingManager.hpp>
+#include <alphagomoku/patterns/PatternTable.hpp>
 #include <alphagomoku/utils/ArgumentParser.hpp>
 #include <alphagomoku/utils/configs.hpp>
 #include <alphagomoku/utils/file_util.hpp>
@@ -24,6 +25,7 @@ int main(int argc, char *argv[])
 {
 	std::cout << ml::Device::hardwareInfo() << '\n';
 	setupSignalHandler(SignalType::INT, SignalHandlerMode::CUSTOM_HANDLER);
+	PatternTable::setTableFile(parseLaunchPath(getExecutablePath()).first + "pattern_tables.bin");
 
 	std::string mode;
 	int number_of_iterations = 0;
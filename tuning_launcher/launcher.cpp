@@ -8,6 +8,8 @@
 #include <alphagomoku/utils/configs.hpp>
 #include <alphagomoku/utils/ArgumentParser.hpp>
 #include <alphagomoku/utils/file_util.hpp>
+#include <alphagomoku/utils/os_utils.hpp>
+#include <alphagomoku/patterns/PatternTable.hpp>
 #include <alphagomoku/evaluation/EvaluationManager.hpp>
 #include <alphagomoku/selfplay/NetworkLoader.hpp>
 
@@ -26,6 +28,7 @@ int main(int argc, char *argv[])
 	ap.addArgument("output_path", [&](const std::string &arg)
 	{	output_path = arg;});
 	ap.parseArguments(argc, argv);
+	PatternTable::setTableFile(parseLaunchPath(getExecutablePath()).first + "pattern_tables.bin");
 
 	const Json config = FileLoader(config_path).getJson();
 